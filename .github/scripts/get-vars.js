@@ -201,9 +201,9 @@ if (versionChangeLog !== '') {
 // Parse platformio.ini and extract the different boards
 const platformioIni = ini.parse(platformioIniStr);
 
-// Get every key that starts with "env:", and that isnt "env:fs" (which is the filesystem) or "env:ci-build" (which is for CI CodeQL and cppcheck)
+// Get every key that starts with "env:", and that isnt "env:fs" (which is the filesystem), "env:ci-build" (which is for CI CodeQL and cppcheck) or "env:native" (which is for host tests)
 const boards = Object.keys(platformioIni)
-  .filter((key) => key.startsWith('env:') && key !== 'env:fs' && key !== 'env:ci-build')
+  .filter((key) => key.startsWith('env:') && key !== 'env:fs' && key !== 'env:ci-build' && key !== 'env:native')
   .reduce((arr, key) => {
     arr.push(key.substring(4));
     return arr;
@@ -10,6 +10,9 @@ export { OtaUpdateChannel } from './configuration/ota-update-channel';
 export { OtaUpdateConfig } from './configuration/ota-update-config';
 export { OtaUpdateStep } from './configuration/ota-update-step';
 export { RFConfig } from './configuration/rfconfig';
+export { RFRepeatInterval } from './configuration/rfrepeat-interval';
+export { RFRoute } from './configuration/rfroute';
+export { RegisteredShocker } from './configuration/registered-shocker';
 export { SerialInputConfig } from './configuration/serial-input-config';
 export { WiFiConfig } from './configuration/wi-fi-config';
 export { WiFiCredentials } from './configuration/wi-fi-credentials';
@@ -52,8 +52,18 @@ lcgOverride(optionalEncoding?:any):string|Uint8Array|null {
   return offset ? this.bb!.__string(this.bb_pos + offset, optionalEncoding) : null;
 }
 
+/**
+ * Live-Control-Gateway (LCG) the backend assigned last, reused on reconnect until it fails
+ */
+lcgCache():string|null
+lcgCache(optionalEncoding:flatbuffers.Encoding):string|Uint8Array|null
+lcgCache(optionalEncoding?:any):string|Uint8Array|null {
+  const offset = this.bb!.__offset(this.bb_pos, 10);
+  return offset ? this.bb!.__string(this.bb_pos + offset, optionalEncoding) : null;
+}
+
 static startBackendConfig(builder:flatbuffers.Builder) {
-  builder.startObject(3);
+  builder.startObject(4);
 }
 
 static addDomain(builder:flatbuffers.Builder, domainOffset:flatbuffers.Offset) {
@@ -68,16 +78,21 @@ static addLcgOverride(builder:flatbuffers.Builder, lcgOverrideOffset:flatbuffers
   builder.addFieldOffset(2, lcgOverrideOffset, 0);
 }
 
+static addLcgCache(builder:flatbuffers.Builder, lcgCacheOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(3, lcgCacheOffset, 0);
+}
+
 static endBackendConfig(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
 }
 
-static createBackendConfig(builder:flatbuffers.Builder, domainOffset:flatbuffers.Offset, authTokenOffset:flatbuffers.Offset, lcgOverrideOffset:flatbuffers.Offset):flatbuffers.Offset {
+static createBackendConfig(builder:flatbuffers.Builder, domainOffset:flatbuffers.Offset, authTokenOffset:flatbuffers.Offset, lcgOverrideOffset:flatbuffers.Offset, lcgCacheOffset:flatbuffers.Offset):flatbuffers.Offset {
   BackendConfig.startBackendConfig(builder);
   BackendConfig.addDomain(builder, domainOffset);
   BackendConfig.addAuthToken(builder, authTokenOffset);
   BackendConfig.addLcgOverride(builder, lcgOverrideOffset);
+  BackendConfig.addLcgCache(builder, lcgCacheOffset);
   return BackendConfig.endBackendConfig(builder);
 }
 }
@@ -0,0 +1,45 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { ShockerModelType } from '../../../open-shock/serialization/types/shocker-model-type';
+
+
+export class RegisteredShocker {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):RegisteredShocker {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+/**
+ * The shocker model
+ */
+model():ShockerModelType {
+  return this.bb!.readUint8(this.bb_pos);
+}
+
+/**
+ * The id the shocker is paired to
+ */
+rfId():number {
+  return this.bb!.readUint16(this.bb_pos + 2);
+}
+
+static sizeOf():number {
+  return 4;
+}
+
+static createRegisteredShocker(builder:flatbuffers.Builder, model: ShockerModelType, rf_id: number):flatbuffers.Offset {
+  builder.prep(2, 4);
+  builder.writeInt16(rf_id);
+  builder.pad(1);
+  builder.writeInt8(model);
+  return builder.offset();
+}
+
+}
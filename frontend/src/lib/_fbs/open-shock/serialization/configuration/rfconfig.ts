@@ -4,6 +4,10 @@
 
 import * as flatbuffers from 'flatbuffers';
 
+import { RFRepeatInterval } from '../../../open-shock/serialization/configuration/rfrepeat-interval';
+import { RFRoute } from '../../../open-shock/serialization/configuration/rfroute';
+import { RegisteredShocker } from '../../../open-shock/serialization/configuration/registered-shocker';
+
 export class RFConfig {
   bb: flatbuffers.ByteBuffer|null = null;
   bb_pos = 0;
@@ -38,8 +42,73 @@ keepaliveEnabled():boolean {
   return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
 }
 
+/**
+ * GPIO pins of additional RF modulators, each one gets its own transmitter
+ */
+extraTxPins(index: number):number|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.readInt8(this.bb!.__vector(this.bb_pos + offset) + index) : 0;
+}
+
+extraTxPinsLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+extraTxPinsArray():Int8Array|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? new Int8Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
+}
+
+/**
+ * Which transmitter to use for a shocker or shocker model, shockers without a route use the first transmitter
+ */
+routes(index: number, obj?:RFRoute):RFRoute|null {
+  const offset = this.bb!.__offset(this.bb_pos, 10);
+  return offset ? (obj || new RFRoute()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 6, this.bb!) : null;
+}
+
+routesLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 10);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+/**
+ * What a transmitter does when its command queue is full, 0 drops the oldest queued commands, 1 rejects new ones
+ */
+queuePolicy():number {
+  const offset = this.bb!.__offset(this.bb_pos, 12);
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
+}
+
+/**
+ * Shockers registered to this hub on the backend, kept so they can be served before the gateway connects
+ */
+shockers(index: number, obj?:RegisteredShocker):RegisteredShocker|null {
+  const offset = this.bb!.__offset(this.bb_pos, 14);
+  return offset ? (obj || new RegisteredShocker()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 4, this.bb!) : null;
+}
+
+shockersLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 14);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+/**
+ * Minimum repeat interval for a shocker or shocker model, shockers without one are repeated as often as the channel allows
+ */
+repeatIntervals(index: number, obj?:RFRepeatInterval):RFRepeatInterval|null {
+  const offset = this.bb!.__offset(this.bb_pos, 16);
+  return offset ? (obj || new RFRepeatInterval()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 6, this.bb!) : null;
+}
+
+repeatIntervalsLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 16);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
 static startRFConfig(builder:flatbuffers.Builder) {
-  builder.startObject(2);
+  builder.startObject(7);
 }
 
 static addTxPin(builder:flatbuffers.Builder, txPin:number) {
@@ -50,15 +119,69 @@ static addKeepaliveEnabled(builder:flatbuffers.Builder, keepaliveEnabled:boolean
   builder.addFieldInt8(1, +keepaliveEnabled, +false);
 }
 
+static addExtraTxPins(builder:flatbuffers.Builder, extraTxPinsOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(2, extraTxPinsOffset, 0);
+}
+
+static createExtraTxPinsVector(builder:flatbuffers.Builder, data:number[]|Int8Array):flatbuffers.Offset;
+/**
+ * @deprecated This Uint8Array overload will be removed in the future.
+ */
+static createExtraTxPinsVector(builder:flatbuffers.Builder, data:number[]|Uint8Array):flatbuffers.Offset;
+static createExtraTxPinsVector(builder:flatbuffers.Builder, data:number[]|Int8Array|Uint8Array):flatbuffers.Offset {
+  builder.startVector(1, data.length, 1);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addInt8(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startExtraTxPinsVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(1, numElems, 1);
+}
+
+static addRoutes(builder:flatbuffers.Builder, routesOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(3, routesOffset, 0);
+}
+
+static startRoutesVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(6, numElems, 2);
+}
+
+static addQueuePolicy(builder:flatbuffers.Builder, queuePolicy:number) {
+  builder.addFieldInt8(4, queuePolicy, 0);
+}
+
+static addShockers(builder:flatbuffers.Builder, shockersOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(5, shockersOffset, 0);
+}
+
+static startShockersVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(4, numElems, 2);
+}
+
+static addRepeatIntervals(builder:flatbuffers.Builder, repeatIntervalsOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(6, repeatIntervalsOffset, 0);
+}
+
+static startRepeatIntervalsVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(6, numElems, 2);
+}
+
 static endRFConfig(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
 }
 
-static createRFConfig(builder:flatbuffers.Builder, txPin:number, keepaliveEnabled:boolean):flatbuffers.Offset {
+static createRFConfig(builder:flatbuffers.Builder, txPin:number, keepaliveEnabled:boolean, extraTxPinsOffset:flatbuffers.Offset, routesOffset:flatbuffers.Offset, queuePolicy:number, shockersOffset:flatbuffers.Offset, repeatIntervalsOffset:flatbuffers.Offset):flatbuffers.Offset {
   RFConfig.startRFConfig(builder);
   RFConfig.addTxPin(builder, txPin);
   RFConfig.addKeepaliveEnabled(builder, keepaliveEnabled);
+  RFConfig.addExtraTxPins(builder, extraTxPinsOffset);
+  RFConfig.addRoutes(builder, routesOffset);
+  RFConfig.addQueuePolicy(builder, queuePolicy);
+  RFConfig.addShockers(builder, shockersOffset);
+  RFConfig.addRepeatIntervals(builder, repeatIntervalsOffset);
   return RFConfig.endRFConfig(builder);
 }
 }
@@ -0,0 +1,60 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { ShockerModelType } from '../../../open-shock/serialization/types/shocker-model-type';
+
+
+export class RFRepeatInterval {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):RFRepeatInterval {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+/**
+ * The shocker model this interval applies to
+ */
+model():ShockerModelType {
+  return this.bb!.readUint8(this.bb_pos);
+}
+
+/**
+ * Whether this interval only applies to a single shocker, otherwise it applies to every shocker of the model
+ */
+byShockerId():boolean {
+  return !!this.bb!.readInt8(this.bb_pos + 1);
+}
+
+/**
+ * The shocker this interval applies to, only used if by_shocker_id is set
+ */
+shockerId():number {
+  return this.bb!.readUint16(this.bb_pos + 2);
+}
+
+/**
+ * Minimum time between the start of two frames for the shocker, in milliseconds
+ */
+intervalMs():number {
+  return this.bb!.readUint16(this.bb_pos + 4);
+}
+
+static sizeOf():number {
+  return 6;
+}
+
+static createRFRepeatInterval(builder:flatbuffers.Builder, model: ShockerModelType, by_shocker_id: boolean, shocker_id: number, interval_ms: number):flatbuffers.Offset {
+  builder.prep(2, 6);
+  builder.writeInt16(interval_ms);
+  builder.writeInt16(shocker_id);
+  builder.writeInt8(Number(Boolean(by_shocker_id)));
+  builder.writeInt8(model);
+  return builder.offset();
+}
+
+}
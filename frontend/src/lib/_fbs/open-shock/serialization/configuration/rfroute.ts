@@ -0,0 +1,61 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { ShockerModelType } from '../../../open-shock/serialization/types/shocker-model-type';
+
+
+export class RFRoute {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):RFRoute {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+/**
+ * The shocker model this route applies to
+ */
+model():ShockerModelType {
+  return this.bb!.readUint8(this.bb_pos);
+}
+
+/**
+ * Index of the transmitter to use, 0 is tx_pin, 1 and up are extra_tx_pins
+ */
+transmitter():number {
+  return this.bb!.readUint8(this.bb_pos + 1);
+}
+
+/**
+ * The shocker this route applies to, only used if by_shocker_id is set
+ */
+shockerId():number {
+  return this.bb!.readUint16(this.bb_pos + 2);
+}
+
+/**
+ * Whether this route only applies to a single shocker, otherwise it applies to every shocker of the model
+ */
+byShockerId():boolean {
+  return !!this.bb!.readInt8(this.bb_pos + 4);
+}
+
+static sizeOf():number {
+  return 6;
+}
+
+static createRFRoute(builder:flatbuffers.Builder, model: ShockerModelType, transmitter: number, shocker_id: number, by_shocker_id: boolean):flatbuffers.Offset {
+  builder.prep(2, 6);
+  builder.pad(1);
+  builder.writeInt8(Number(Boolean(by_shocker_id)));
+  builder.writeInt16(shocker_id);
+  builder.writeInt8(transmitter);
+  builder.writeInt8(model);
+  return builder.offset();
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "util/SocketWaiter.h"
 #include "WebSocketDeFragger.h"
 
 #include <DNSServer.h>
@@ -9,6 +10,7 @@
 
 #include <freertos/task.h>
 
+#include <atomic>
 #include <cstdint>
 #include <string_view>
 
@@ -24,6 +26,15 @@ namespace OpenShock {
     bool broadcastMessageBIN(const uint8_t* data, std::size_t len) { return m_socketServer.broadcastBIN(data, len); }
 
   private:
+    /// @brief The library keeps its client sockets to itself, this exposes them so the task can sleep until one is readable
+    class SocketServer : public WebSocketsServer {
+    public:
+      using WebSocketsServer::WebSocketsServer;
+
+      std::size_t clientFds(int* fds, std::size_t maxFds);
+      bool hasBufferedData();
+    };
+
     void task();
     void handleWebSocketClientConnected(uint8_t socketId);
     void handleWebSocketClientDisconnected(uint8_t socketId);
@@ -31,10 +42,13 @@ namespace OpenShock {
     void handleWebSocketEvent(uint8_t socketId, WebSocketMessageType type, const uint8_t* payload, std::size_t length);
 
     AsyncWebServer m_webServer;
-    WebSocketsServer m_socketServer;
+    SocketServer m_socketServer;
     WebSocketDeFragger m_socketDeFragger;
     fs::LittleFSFS m_fileSystem;
     DNSServer m_dnsServer;
+    Util::SocketWaiter m_waiter;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<bool> m_taskStopped;
     TaskHandle_t m_taskHandle;
   };
 }  // namespace OpenShock
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 
 namespace OpenShock::Checksum {
   constexpr uint8_t Sum8(const uint8_t* data, std::size_t size) {
@@ -12,6 +13,13 @@ namespace OpenShock::Checksum {
   }
   template<typename T>
   constexpr uint8_t Sum8(T data) {
-    return Sum8(reinterpret_cast<uint8_t*>(&data), sizeof(T));
+    static_assert(std::is_unsigned<T>::value, "T must be an unsigned integer");
+
+    // Sum the bytes by shifting instead of reinterpreting memory, so this can be evaluated at compile time
+    uint8_t checksum = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      checksum += static_cast<uint8_t>(data >> (i * 8));
+    }
+    return checksum;
   }
 }  // namespace OpenShock::Checksum
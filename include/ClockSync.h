@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+// Estimates the offset between the gateway clock and our uptime from keep-alive round trips.
+//
+// A keep-alive carries our uptime, the gateway answers with it and its own time. Half the round trip is assumed to be spent each way, so the sample with
+// the shortest round trip of the recent ones bounds the error best and is the one used, like the NTP clock filter.
+
+namespace OpenShock::ClockSync {
+  constexpr std::size_t kSampleCount = 8;           // 2 minutes of keep-alives
+  constexpr int64_t kMaxSampleAgeMs  = 5 * 60'000;  // Past this the crystal drift adds up to more than a frame
+
+  struct Estimate {
+    int64_t offsetMs;   // Gateway time minus uptime
+    int64_t rttMs;      // Round trip of the sample the offset is taken from, the offset is accurate to half of it
+    int64_t sampledAt;  // Uptime the sample was taken at
+    uint8_t sampleCount;
+  };
+
+  /// @brief Adds a round trip, sentAt and receivedAt are uptimes in ms, gatewayTime is the gateway's time when it answered
+  /// @return false if the sample is not plausible and was ignored
+  bool AddSample(int64_t sentAt, int64_t gatewayTime, int64_t receivedAt);
+
+  /// @brief Current estimate, returns false if there is no sample recent enough
+  bool GetEstimate(int64_t now, Estimate& out);
+
+  /// @brief Converts a gateway timestamp to uptime, returns false if the clock is not synced
+  bool ToLocalTime(int64_t gatewayTime, int64_t now, int64_t& out);
+
+  /// @brief Forgets all samples, the next gateway might run on another clock
+  void Reset();
+}  // namespace OpenShock::ClockSync
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "config/RFConfig.h"
+#include "radio/RFQueuePolicy.h"
+#include "radio/RFStats.h"
+#include "radio/TransmitScheduler.h"
+#include "radio/Waveform.h"
+#include "serialization/_fbs/GatewayToHubMessage_generated.h"
 #include "SetGPIOResultCode.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
@@ -7,6 +13,7 @@
 #include <hal/gpio_types.h>
 
 #include <cstdint>
+#include <vector>
 
 // TODO: This is horrible architecture. Fix it.
 
@@ -17,11 +24,56 @@ namespace OpenShock::CommandHandler {
   gpio_num_t GetRfTxPin();
   SetGPIOResultCode SetRfTxPin(gpio_num_t txPin);
 
+  /// @brief TX pins of all transmitters, indexed by transmitter, OPENSHOCK_GPIO_INVALID for transmitters that failed to initialize
+  std::vector<gpio_num_t> GetRfTxPins();
+  SetGPIOResultCode AddRfTxPin(gpio_num_t txPin);
+  bool RemoveRfTxPin(uint8_t transmitter);
+
+  std::vector<Config::RFRoute> GetRfRoutes();
+  bool SetRfRoute(const Config::RFRoute& route);
+  bool RemoveRfRoute(ShockerModelType model, bool byShockerId, uint16_t shockerId);
+
+  std::vector<Config::RFRepeatInterval> GetRfRepeatIntervals();
+  /// @brief Saves the minimum repeat interval of a shocker model, or a single shocker, an interval of 0 removes it
+  /// @note Applies to commands sent from now on, running commands keep their interval
+  bool SetRfRepeatInterval(const Config::RFRepeatInterval& repeatInterval);
+
   SetGPIOResultCode SetEStopPin(gpio_num_t estopPin);
   gpio_num_t GetEstopPin();
 
   bool SetKeepAliveEnabled(bool enabled);
   bool SetKeepAlivePaused(bool paused);
 
-  bool HandleCommand(ShockerModelType shockerModel, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs);
+  /// @brief Saves the admission policy for full transmitter queues and applies it to every transmitter
+  bool SetRfQueuePolicy(RFQueuePolicy policy);
+
+  /// @brief Saves the shockers registered to this hub and warms them up: zero sequences are pinned and keep-alives start right away
+  /// @note Called with the backend's list on every gateway connect, the config is only written when it changed
+  bool SetShockerRegistry(const std::vector<Config::RegisteredShocker>& shockers);
+
+  std::size_t GetFrameRates(TransmitScheduler::FrameRate* out, std::size_t maxCount);
+
+  /// @brief Fills one snapshot per initialized transmitter
+  /// @return Number of snapshots written
+  std::size_t GetRfStats(RFStats::Snapshot* out, std::size_t maxCount);
+  void ResetRfStats();
+
+  /// @brief Fills one queue status per initialized transmitter
+  /// @return Number of statuses written
+  std::size_t GetRfQueueStatus(RFQueueStatus* out, std::size_t maxCount);
+
+  /// @param executeAtGatewayMs Gateway time the command should start at, converted through ClockSync and held back until then, 0 to start right away
+  bool HandleCommand(ShockerModelType shockerModel, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t executeAtGatewayMs = 0);
+
+  /// @brief Plays a waveform on a shocker, the transmitter interpolates it locally so a whole pattern takes a single message
+  bool HandleWaveform(ShockerModelType shockerModel, uint16_t shockerId, const Waveform& waveform);
+
+  /// @brief Handles a whole command list under a single lock, the commands reach each transmitter as one batch so they start on the same cycle
+  /// @param executeAtGatewayMs Gateway time the whole list should start at, 0 to start right away, stops never wait
+  /// @return Number of commands that were accepted
+  std::size_t HandleCommandList(const flatbuffers::Vector<const Serialization::Gateway::ShockerCommand*>& commands, int64_t executeAtGatewayMs = 0);
+
+  /// @brief Sends the same command to every member of a group defined through ShockerGroups, expanded into one batch per transmitter like a command list
+  /// @return false if the group is not defined or not every member accepted the command
+  bool HandleGroupCommand(uint16_t groupId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t executeAtGatewayMs = 0);
 }  // namespace OpenShock::CommandHandler
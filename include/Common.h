@@ -29,6 +29,11 @@
 #define OPENSHOCK_RF_TX_GPIO OPENSHOCK_GPIO_INVALID
 #endif
 
+// Upper bound on RF transmitters, each one claims its own RMT channel
+#ifndef OPENSHOCK_RF_TX_MAX_TRANSMITTERS
+#define OPENSHOCK_RF_TX_MAX_TRANSMITTERS 4
+#endif
+
 #ifndef OPENSHOCK_ESTOP_PIN
 #define OPENSHOCK_ESTOP_PIN OPENSHOCK_GPIO_INVALID
 #endif
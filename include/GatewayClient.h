@@ -2,15 +2,24 @@
 
 #include <WebSocketsClient.h>
 
+#include "Common.h"
+#include "OutboundQueue.h"
+#include "radio/RFQueuePolicy.h"
+#include "WebSocketDeFragger.h"
+
+#include <array>
 #include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 
 namespace OpenShock {
+  /// @brief Messages other tasks hand to the gateway connection, drained by GatewayClient::loop, 16 cells of 256 bytes fit every OTA message
+  typedef OutboundQueue<16, 256> GatewayOutboundQueue;
+
   class GatewayClient {
   public:
-    GatewayClient(const std::string& authToken);
+    GatewayClient(const std::string& authToken, GatewayOutboundQueue& outbox);
     ~GatewayClient();
 
     enum class State : uint8_t {
@@ -25,19 +34,39 @@ namespace OpenShock {
     void connect(const char* lcgFqdn);
     void disconnect();
 
-    bool sendMessageTXT(std::string_view data);
-    bool sendMessageBIN(const uint8_t* data, std::size_t length);
-
     bool loop();
 
+    /// @brief Socket of the connection for SocketWaiter, -1 while there is none
+    int socketFd() { return m_webSocket.fd(); }
+    /// @brief Whether received data is buffered past the socket (TLS records), select doesn't see it and loop should run again right away
+    bool hasBufferedData() { return m_webSocket.hasBufferedData(); }
+    /// @brief How long loop can wait for the socket before periodic work is due
+    uint32_t msUntilPeriodicWork() const;
+
   private:
+    /// @brief The library keeps its socket to itself, this exposes it so the main task can sleep until it is readable
+    class Socket : public WebSocketsClient {
+    public:
+      int fd();
+      bool hasBufferedData();
+    };
+
     void _setState(State state);
     void _sendKeepAlive();
     void _sendBootStatus();
-    void _handleEvent(WStype_t type, uint8_t* payload, std::size_t length);
+    void _sendRfQueueStatus(bool force);
+    void _sendLatencyReport(bool force);
+    void _drainOutbox();
+    void _handleEvent(uint8_t socketId, WebSocketMessageType type, const uint8_t* payload, uint32_t length);
 
-    WebSocketsClient m_webSocket;
+    Socket m_webSocket;
+    WebSocketDeFragger m_deFragger;  // Keeps its buffer across messages, so fragmented command lists don't churn the heap
+    GatewayOutboundQueue& m_outbox;  // Outlives the client, other tasks keep pushing while it is replaced
     int64_t m_lastKeepAlive;
+    int64_t m_lastRfQueueCheck;
+    std::array<RFQueueStatus, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> m_reportedRfQueues;  // Last status sent per transmitter index
+    int64_t m_lastLatencyReport;
+    uint32_t m_reportedLatencyCount;  // Traced commands in the last report, nothing new to report while it holds
     State m_state;
   };
 }  // namespace OpenShock
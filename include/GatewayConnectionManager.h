@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AccountLinkResultCode.h"
+#include "OutboundQueue.h"
 
 #include <cstdint>
 #include <functional>
@@ -15,8 +16,14 @@ namespace OpenShock::GatewayConnectionManager {
   AccountLinkResultCode Link(std::string_view linkCode);
   void UnLink();
 
+  /// @brief Queues a message for the gateway, returns false without waiting if there is no connection or the queue is full
   bool SendMessageTXT(std::string_view data);
-  bool SendMessageBIN(const uint8_t* data, std::size_t length);
+  bool SendMessageBIN(const uint8_t* data, std::size_t length, OutboundCoalesceKey key = OutboundCoalesceKey::None);
+
+  OutboundQueueStats GetOutboxStats();
 
   void Update();
+
+  /// @brief Sleeps until the gateway socket has data, another task queues a message or changes the connection, or periodic work is due, call it between updates
+  void WaitForActivity();
 }  // namespace OpenShock::GatewayConnectionManager
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Traces gateway commands from the WebSocket frame to the first RF frame on air, aggregated into per stage latency histograms.
+//
+// A trace lives on the task that received the frame, commands encoded while it is active carry its start time to the transmit task.
+
+namespace OpenShock::LatencyTrace {
+  enum class Stage : uint8_t {
+    Verify,    // WebSocket frame received -> message verified
+    Dispatch,  // Message verified -> command handler entered
+    Enqueue,   // Command handler entered -> commands handed to the transmit queue
+    Dequeue,   // Handed to the transmit queue -> picked up by the transmit task
+    Emit,      // Picked up by the transmit task -> first frame on air
+    Total,     // WebSocket frame received -> first frame on air
+  };
+
+  constexpr std::size_t kStageCount  = static_cast<std::size_t>(Stage::Total) + 1;
+  constexpr std::size_t kBucketCount = 12;
+
+  /// @brief Upper bound of a histogram bucket, buckets double in size starting at 128 us, the last one holds everything above
+  constexpr uint32_t BucketUpperBoundUs(std::size_t bucket)
+  {
+    return bucket + 1 < kBucketCount ? 128u << bucket : UINT32_MAX;
+  }
+
+  struct StageStats {
+    uint32_t count;
+    uint32_t sumUs;  // Wraps around, divide by count for the average between resets
+    uint32_t maxUs;
+    std::array<uint32_t, kBucketCount> buckets;
+  };
+
+  /// @brief Starts a trace on the calling task, at the moment a gateway frame was received
+  void Begin();
+  /// @brief Ends the trace of the calling task
+  void End();
+
+  /// @brief Records the time since the previous stage of the calling task's trace, does nothing if the task has no trace
+  void Mark(Stage stage);
+
+  /// @brief Start of the calling task's trace in microseconds, 0 if the task has no trace
+  int64_t Origin();
+
+  /// @brief Records a latency measured outside of the tracing task
+  void Record(Stage stage, uint32_t latencyUs);
+
+  const char* StageName(Stage stage);
+  void GetStats(Stage stage, StageStats& out);
+  void Reset();
+}  // namespace OpenShock::LatencyTrace
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "Common.h"
+#include "WebSocketMessageType.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace OpenShock {
+  /// @brief Messages where only the newest one matters, a queued one is skipped if a newer one with the same key is queued behind it
+  enum class OutboundCoalesceKey : uint8_t {
+    None,
+    OtaInstallProgress,
+  };
+
+  constexpr std::size_t kOutboundCoalesceKeyCount = static_cast<std::size_t>(OutboundCoalesceKey::OtaInstallProgress) + 1;
+
+  /// @brief Counters of an outbound queue, they wrap, consumers should diff consecutive snapshots
+  struct OutboundQueueStats {
+    uint32_t pushed;
+    uint32_t sent;
+    uint32_t coalesced;  // Skipped because a newer message with the same key was queued
+    uint32_t rejected;   // Refused by Push because the queue was full or the message too big
+    uint32_t failed;     // Drained but the send failed, or discarded while disconnected
+  };
+
+  /// @brief Bounded queue of outgoing WebSocket messages, any task may push, a single task drains it and owns the socket
+  /// @note Push and Drain are lock-free (sequence numbered cells), Push copies the message and never blocks, a full queue rejects it
+  /// @note A message pushed after a slow producer claimed its cell waits for that producer, the queue keeps the order cells were claimed in
+  template<std::size_t N, std::size_t MaxMessageSize>
+  class OutboundQueue {
+    DISABLE_COPY(OutboundQueue);
+    DISABLE_MOVE(OutboundQueue);
+
+    static_assert(N > 1 && (N & (N - 1)) == 0, "N must be a power of two");
+    static_assert(MaxMessageSize <= 0xFFFF, "MaxMessageSize must fit in 16 bits");
+
+  public:
+    OutboundQueue()
+      : m_cells()
+      , m_pending()
+      , m_pushPos(0)
+      , m_drainPos(0)
+      , m_pushed(0)
+      , m_sent(0)
+      , m_coalesced(0)
+      , m_rejected(0)
+      , m_failed(0)
+    {
+      for (std::size_t i = 0; i < N; ++i) {
+        m_cells[i].sequence.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+      }
+    }
+
+    constexpr std::size_t capacity() const { return N; }
+    constexpr std::size_t maxMessageSize() const { return MaxMessageSize; }
+
+    /// @brief Copies a message into the queue, returns false without waiting if it is full or the message too big
+    bool Push(WebSocketMessageType type, const uint8_t* data, std::size_t length, OutboundCoalesceKey key = OutboundCoalesceKey::None)
+    {
+      if (length > MaxMessageSize) {
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      Cell* cell;
+      uint32_t pos = m_pushPos.load(std::memory_order_relaxed);
+      while (true) {
+        cell = &m_cells[pos & (N - 1)];
+
+        int32_t diff = static_cast<int32_t>(cell->sequence.load(std::memory_order_acquire) - pos);
+        if (diff == 0) {
+          if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (diff < 0) {
+          // The drainer has not freed this cell yet
+          m_rejected.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        } else {
+          pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+      }
+
+      cell->type   = type;
+      cell->key    = key;
+      cell->length = static_cast<uint16_t>(length);
+      memcpy(cell->data, data, length);
+
+      // Counted before publishing, so when the drainer reaches an older message of this key it already knows about this one
+      if (key != OutboundCoalesceKey::None) {
+        m_pending[static_cast<std::size_t>(key)].fetch_add(1, std::memory_order_relaxed);
+      }
+
+      m_pushed.fetch_add(1, std::memory_order_relaxed);
+      cell->sequence.store(pos + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /// @brief Hands up to maxMessages queued messages to send in order, only call this from the task that owns the socket
+    /// @return Number of messages taken from the queue, coalesced ones included
+    template<typename SendFn>
+    std::size_t Drain(SendFn send, std::size_t maxMessages = N)
+    {
+      std::size_t count = 0;
+      while (count < maxMessages) {
+        Cell& cell = m_cells[m_drainPos & (N - 1)];
+        if (static_cast<int32_t>(cell.sequence.load(std::memory_order_acquire) - (m_drainPos + 1)) < 0) {
+          break;  // Empty, or the next producer is still copying its message
+        }
+
+        bool superseded = false;
+        if (cell.key != OutboundCoalesceKey::None) {
+          superseded = m_pending[static_cast<std::size_t>(cell.key)].fetch_sub(1, std::memory_order_relaxed) > 1;
+        }
+
+        if (superseded) {
+          m_coalesced.fetch_add(1, std::memory_order_relaxed);
+        } else if (send(cell.type, static_cast<const uint8_t*>(cell.data), static_cast<std::size_t>(cell.length))) {
+          m_sent.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          m_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        cell.sequence.store(m_drainPos + N, std::memory_order_release);
+        ++m_drainPos;
+        ++count;
+      }
+
+      return count;
+    }
+
+    /// @brief Drops every queued message, only call this from the draining task
+    std::size_t Discard()
+    {
+      return Drain([](WebSocketMessageType, const uint8_t*, std::size_t) { return false; });
+    }
+
+    OutboundQueueStats stats() const
+    {
+      return OutboundQueueStats {
+        .pushed    = m_pushed.load(std::memory_order_relaxed),
+        .sent      = m_sent.load(std::memory_order_relaxed),
+        .coalesced = m_coalesced.load(std::memory_order_relaxed),
+        .rejected  = m_rejected.load(std::memory_order_relaxed),
+        .failed    = m_failed.load(std::memory_order_relaxed),
+      };
+    }
+
+  private:
+    struct Cell {
+      std::atomic<uint32_t> sequence;  // Equals the push position when free, the position + 1 once its message is published
+      WebSocketMessageType type;
+      OutboundCoalesceKey key;
+      uint16_t length;
+      uint8_t data[MaxMessageSize];
+    };
+
+    std::array<Cell, N> m_cells;
+    std::array<std::atomic<uint32_t>, kOutboundCoalesceKeyCount> m_pending;  // Queued messages per key
+    std::atomic<uint32_t> m_pushPos;
+    uint32_t m_drainPos;  // Only touched by the draining task
+    std::atomic<uint32_t> m_pushed;
+    std::atomic<uint32_t> m_sent;
+    std::atomic<uint32_t> m_coalesced;
+    std::atomic<uint32_t> m_rejected;
+    std::atomic<uint32_t> m_failed;
+  };
+}  // namespace OpenShock
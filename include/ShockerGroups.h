@@ -0,0 +1,33 @@
+#pragma once
+
+#include "ShockerModelType.h"
+
+#include <cstdint>
+
+// Shocker groups defined by the gateway, so a command for many shockers takes a single group command instead of one entry per shocker.
+//
+// Groups live in RAM only, the gateway pushes its definitions when it connects and whenever they change.
+
+namespace OpenShock::ShockerGroups {
+  constexpr std::size_t kMaxGroups  = 16;
+  constexpr std::size_t kMaxMembers = 32;
+
+  struct Member {
+    ShockerModelType model;
+    uint16_t shockerId;
+  };
+
+  /// @brief Defines or replaces a group, an empty member list removes it, duplicate members are only kept once
+  /// @return false if the group has too many members or every group slot is taken, the previous definition is kept then
+  bool Define(uint16_t groupId, const Member* members, std::size_t count);
+
+  /// @brief Copies the members of a group to out
+  /// @return Number of members written, 0 if the group is not defined
+  std::size_t GetMembers(uint16_t groupId, Member* out, std::size_t maxCount);
+
+  /// @brief Number of defined groups
+  std::size_t Count();
+
+  /// @brief Removes every group
+  void Clear();
+}  // namespace OpenShock::ShockerGroups
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Fixed capacity object pool, all slots are allocated up front so Acquire and Release never touch the heap
+  /// @note Acquire and Release are lock-free (tagged index free-list) and may be called from any task
+  /// @note Acquired slots are not reinitialized, the caller is responsible for overwriting every field it uses
+  template<typename T, std::size_t N>
+  class SlabPool {
+    DISABLE_COPY(SlabPool);
+    DISABLE_MOVE(SlabPool);
+
+    static_assert(N > 0, "N must be greater than 0");
+    static_assert(N < 0xFFFF, "N must fit in a 16 bit index");
+
+  public:
+    SlabPool()
+      : m_slots()
+      , m_next()
+      , m_head(pack(0, 0))
+      , m_available(N)
+    {
+      for (std::size_t i = 0; i < N; ++i) {
+        m_next[i].store(i + 1 < N ? static_cast<uint16_t>(i + 1) : kNil, std::memory_order_relaxed);
+      }
+    }
+
+    constexpr std::size_t capacity() const { return N; }
+    inline std::size_t available() const { return m_available.load(std::memory_order_relaxed); }
+    inline bool Owns(const T* item) const { return item >= m_slots.data() && item < m_slots.data() + N; }
+
+    /// @brief Takes a slot from the pool, returns nullptr if the pool is exhausted
+    T* Acquire()
+    {
+      uint32_t head = m_head.load(std::memory_order_acquire);
+      while (true) {
+        uint16_t index = indexOf(head);
+        if (index == kNil) {
+          return nullptr;
+        }
+
+        uint32_t next = pack(m_next[index].load(std::memory_order_relaxed), tagOf(head) + 1);
+        if (m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+          m_available.fetch_sub(1, std::memory_order_relaxed);
+          return &m_slots[index];
+        }
+      }
+    }
+
+    /// @brief Returns a slot previously obtained from Acquire to the pool
+    void Release(T* item)
+    {
+      if (item == nullptr) {
+        return;
+      }
+
+      uint16_t index = static_cast<uint16_t>(item - m_slots.data());
+
+      uint32_t head = m_head.load(std::memory_order_relaxed);
+      do {
+        m_next[index].store(indexOf(head), std::memory_order_relaxed);
+      } while (!m_head.compare_exchange_weak(head, pack(index, tagOf(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+
+      m_available.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr uint16_t kNil = 0xFFFF;
+
+    // The tag is bumped on every head change so a stale head can never be swapped back in (ABA)
+    static constexpr uint32_t pack(uint16_t index, uint16_t tag) { return (static_cast<uint32_t>(tag) << 16) | index; }
+    static constexpr uint16_t indexOf(uint32_t head) { return static_cast<uint16_t>(head & 0xFFFF); }
+    static constexpr uint16_t tagOf(uint32_t head) { return static_cast<uint16_t>(head >> 16); }
+
+    std::array<T, N> m_slots;
+    std::array<std::atomic<uint16_t>, N> m_next;
+    std::atomic<uint32_t> m_head;
+    std::atomic<std::size_t> m_available;
+  };
+}  // namespace OpenShock
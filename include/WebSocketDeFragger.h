@@ -5,37 +5,59 @@
 
 #include <WebSockets.h>
 
-#include <map>
+#include <array>
 #include <cstdint>
 #include <functional>
 
 namespace OpenShock {
+  /// @brief Reassembles fragmented WebSocket messages, every other event is passed through as is
+  ///
+  /// Each socket gets a buffer that is kept for its next message, so a stream of fragmented messages doesn't allocate once the buffer has grown.
+  /// Buffers grow in powers of two up to maxMessageSize, a message growing past it is dropped and reported as an error.
+  /// A buffer bigger than retainCapacity is freed once its message was handled, so one big message doesn't pin the memory for good.
   class WebSocketDeFragger {
     DISABLE_COPY(WebSocketDeFragger);
+    DISABLE_MOVE(WebSocketDeFragger);
+
   public:
+    static constexpr std::size_t kMaxSockets         = 8;
+    static constexpr uint32_t kDefaultMaxMessageSize = 16 * 1024;
+    static constexpr uint32_t kDefaultRetainCapacity = 4 * 1024;
 
     typedef std::function<void(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length)> EventCallback;
 
-    WebSocketDeFragger(EventCallback callback);
+    WebSocketDeFragger(EventCallback callback, uint32_t maxMessageSize = kDefaultMaxMessageSize, uint32_t retainCapacity = kDefaultRetainCapacity);
     ~WebSocketDeFragger();
 
     void handler(uint8_t socketId, WStype_t type, const uint8_t* payload, std::size_t length);
     void onEvent(const EventCallback& callback);
+    /// @brief Drops the message in progress on a socket and frees its buffer
     void clear(uint8_t socketId);
     void clear();
-  private:
-    void start(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length);
-    void append(uint8_t socketId, const uint8_t* data, uint32_t length);
-    void finish(uint8_t socketId, const uint8_t* data, uint32_t length);
 
-    struct Message {
+  private:
+    struct Buffer {
       uint8_t* data;
       uint32_t size;
       uint32_t capacity;
+      uint8_t socketId;
       WebSocketMessageType type;
+      bool assigned;   // Belongs to socketId
+      bool receiving;  // A fragmented message is in progress
     };
 
-    std::map<uint8_t, Message> m_messages;
+    Buffer* find(uint8_t socketId);
+    Buffer* acquire(uint8_t socketId);
+    bool reserve(Buffer& buffer, uint32_t size);
+    void release(Buffer& buffer);
+    void fail(uint8_t socketId, const char* message);
+
+    void start(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length);
+    void append(uint8_t socketId, const uint8_t* data, uint32_t length, bool fin);
+
+    std::array<Buffer, kMaxSockets> m_buffers;
+    uint32_t m_maxMessageSize;
+    uint32_t m_retainCapacity;
     EventCallback m_callback;
   };
-}
+}  // namespace OpenShock
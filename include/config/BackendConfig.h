@@ -8,11 +8,12 @@
 namespace OpenShock::Config {
   struct BackendConfig : public ConfigBase<Serialization::Configuration::BackendConfig> {
     BackendConfig();
-    BackendConfig(std::string_view domain, std::string_view authToken, std::string_view lcgOverride);
+    BackendConfig(std::string_view domain, std::string_view authToken, std::string_view lcgOverride, std::string_view lcgCache);
 
     std::string domain;
     std::string authToken;
     std::string lcgOverride;
+    std::string lcgCache;  // LCG the backend assigned last, tied to domain and authToken
 
     void ToDefault() override;
 
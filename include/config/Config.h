@@ -59,8 +59,18 @@ namespace OpenShock::Config {
 
   bool GetRFConfigTxPin(gpio_num_t& out);
   bool SetRFConfigTxPin(gpio_num_t txPin);
+  bool GetRFConfigExtraTxPins(std::vector<gpio_num_t>& out);
+  bool SetRFConfigExtraTxPins(const std::vector<gpio_num_t>& extraTxPins);
+  bool GetRFConfigRoutes(std::vector<RFRoute>& out);
+  bool SetRFConfigRoutes(const std::vector<RFRoute>& routes);
   bool GetRFConfigKeepAliveEnabled(bool& out);
   bool SetRFConfigKeepAliveEnabled(bool enabled);
+  bool GetRFConfigQueuePolicy(RFQueuePolicy& out);
+  bool SetRFConfigQueuePolicy(RFQueuePolicy policy);
+  bool GetRFConfigShockers(std::vector<RegisteredShocker>& out);
+  bool SetRFConfigShockers(const std::vector<RegisteredShocker>& shockers);
+  bool GetRFConfigRepeatIntervals(std::vector<RFRepeatInterval>& out);
+  bool SetRFConfigRepeatIntervals(const std::vector<RFRepeatInterval>& repeatIntervals);
 
   bool AnyWiFiCredentials(std::function<bool(const Config::WiFiCredentials&)> predicate);
   uint8_t AddWiFiCredentials(std::string_view ssid, std::string_view password);
@@ -82,6 +92,10 @@ namespace OpenShock::Config {
   bool GetBackendLCGOverride(std::string& out);
   bool SetBackendLCGOverride(std::string_view lcgOverride);
   bool ClearBackendLCGOverride();
+  /// @brief LCG assignment kept across reboots, changing the domain or auth token clears it
+  bool GetBackendLCGCache(std::string& out);
+  bool SetBackendLCGCache(std::string_view fqdn);
+  bool ClearBackendLCGCache();
 
   bool GetSerialInputConfigEchoEnabled(bool& out);
   bool SetSerialInputConfigEchoEnabled(bool enabled);
@@ -3,14 +3,48 @@
 #include <hal/gpio_types.h>
 
 #include "config/ConfigBase.h"
+#include "radio/RFQueuePolicy.h"
+#include "ShockerModelType.h"
+
+#include <vector>
 
 namespace OpenShock::Config {
+  struct RFRoute {
+    ShockerModelType model;
+    uint8_t transmitter;
+    uint16_t shockerId;
+    bool byShockerId;
+  };
+
+  /// @brief Minimum time between two frames for a shocker model, or a single shocker, a shocker that doesn't need every frame leaves air time to the others
+  struct RFRepeatInterval {
+    ShockerModelType model;
+    uint16_t shockerId;
+    bool byShockerId;
+    uint16_t intervalMs;
+  };
+
+  /// @brief A shocker registered to this hub on the backend, only what the radio needs, the backend id stays on the backend
+  struct RegisteredShocker {
+    ShockerModelType model;
+    uint16_t shockerId;
+
+    inline bool operator==(const RegisteredShocker& other) const { return model == other.model && shockerId == other.shockerId; }
+    inline bool operator!=(const RegisteredShocker& other) const { return !(*this == other); }
+  };
+
   struct RFConfig : public ConfigBase<Serialization::Configuration::RFConfig> {
     RFConfig();
     RFConfig(gpio_num_t txPin, bool keepAliveEnabled);
+    RFConfig(gpio_num_t txPin, const std::vector<gpio_num_t>& extraTxPins, const std::vector<RFRoute>& routes, bool keepAliveEnabled);
 
     gpio_num_t txPin;
+    std::vector<gpio_num_t> extraTxPins;
+    std::vector<RFRoute> routes;
     bool keepAliveEnabled;
+    RFQueuePolicy queuePolicy;
+    std::vector<RegisteredShocker> shockers;
+    std::vector<RFRepeatInterval> repeatIntervals;
 
     void ToDefault() override;
 
@@ -3,6 +3,9 @@
 #include <cstdint>
 
 namespace OpenShock::EventHandlers::WebSocket {
+  /// @brief Largest gateway message that is reassembled and verified, big command lists and configs arrive fragmented
+  constexpr uint32_t kMaxGatewayMessageSize = 16 * 1024;
+
   void HandleGatewayBinary(const uint8_t* data, std::size_t len);
   void HandleLocalBinary(uint8_t socketId, const uint8_t* data, std::size_t len);
 }
@@ -12,4 +12,8 @@ namespace OpenShock::MessageHandlers::Server::_Private {
   WS_EVENT_HANDLER_SIGNATURE(HandleShockerCommandList);
   WS_EVENT_HANDLER_SIGNATURE(HandleCaptivePortalConfig);
   WS_EVENT_HANDLER_SIGNATURE(HandleOtaInstall);
+  WS_EVENT_HANDLER_SIGNATURE(HandleShockerGroupDefine);
+  WS_EVENT_HANDLER_SIGNATURE(HandleShockerGroupCommand);
+  WS_EVENT_HANDLER_SIGNATURE(HandleShockerWaveform);
+  WS_EVENT_HANDLER_SIGNATURE(HandleKeepAliveEcho);
 }  // namespace OpenShock::MessageHandlers::Server::_Private
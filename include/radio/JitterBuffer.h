@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Common.h"
+#include "radio/RFCommand.h"
+
+#include <array>
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Holds commands with a future execution time until that time comes, so commands sent to several hubs take over in sync
+  ///
+  /// Commands are kept ordered by execution time, commands with the same time are released in the order they were added so a batch stays together.
+  ///
+  /// @note Not thread-safe, only the transmit task may use it.
+  class JitterBuffer {
+    DISABLE_COPY(JitterBuffer);
+    DISABLE_MOVE(JitterBuffer);
+
+  public:
+    static constexpr std::size_t kCapacity = 16;
+
+    JitterBuffer();
+
+    inline bool empty() const { return m_count == 0; }
+    inline std::size_t size() const { return m_count; }
+
+    /// @brief Holds a command until its executeAt, returns false if the buffer is full
+    bool Push(RFCommand* command);
+
+    /// @brief Execution time of the next held command, INT64_MAX if empty
+    int64_t NextRelease() const;
+
+    /// @brief Removes the next command whose execution time is at or before now, or returns nullptr
+    RFCommand* PopDue(int64_t now);
+
+    /// @brief Removes one held command of a shocker, or returns nullptr
+    RFCommand* PopShocker(uint16_t shockerId);
+
+  private:
+    RFCommand* removeAt(std::size_t index);
+
+    std::array<RFCommand*, kCapacity> m_commands;
+    std::size_t m_count;
+  };
+}  // namespace OpenShock
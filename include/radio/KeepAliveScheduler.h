@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Common.h"
+#include "ShockerModelType.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenShock {
+  /// @brief Tracks when every known shocker is due for its next keep-alive
+  ///
+  /// Deadlines are kept in an indexed min-heap, so finding the next deadline is O(1) and updating a shocker is O(log n).
+  /// Each shocker's deadline is pulled forward by a fixed per-shocker offset, so shockers that were active at the same time don't all come due at once.
+  ///
+  /// @note Not thread-safe, only the keep-alive task may use it.
+  class KeepAliveScheduler {
+    DISABLE_COPY(KeepAliveScheduler);
+    DISABLE_MOVE(KeepAliveScheduler);
+
+  public:
+    struct Shocker {
+      ShockerModelType model;
+      uint16_t shockerId;
+    };
+
+    /// @param interval Time after the last activity a shocker is due for a keep-alive
+    /// @param stagger Deadlines are spread over [interval - stagger, interval] depending on the shocker
+    KeepAliveScheduler(int64_t interval, int64_t stagger);
+
+    inline bool empty() const { return m_heap.empty(); }
+    inline std::size_t size() const { return m_heap.size(); }
+
+    /// @brief Records activity for a shocker, adding it if it isn't known yet
+    void Touch(ShockerModelType model, uint16_t shockerId, int64_t activity);
+
+    /// @brief Earliest deadline of all shockers, INT64_MAX if there are none
+    int64_t NextDeadline() const;
+
+    /// @brief Takes up to maxCount shockers that are due at now, and reschedules them as if they were active at now
+    /// @return Number of shockers written to out
+    std::size_t TakeDue(int64_t now, Shocker* out, std::size_t maxCount);
+
+  private:
+    struct Entry {
+      int64_t deadline;
+      Shocker shocker;
+    };
+
+    int64_t deadlineFor(uint16_t shockerId, int64_t activity) const;
+    void update(std::size_t index, int64_t deadline);
+    void place(std::size_t index, const Entry& entry);
+    void siftUp(std::size_t index);
+    void siftDown(std::size_t index);
+
+    int64_t m_interval;
+    int64_t m_stagger;
+    std::vector<Entry> m_heap;
+    std::unordered_map<uint16_t, std::size_t> m_positions;  // shockerId -> index in m_heap
+  };
+}  // namespace OpenShock
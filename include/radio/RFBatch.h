@@ -0,0 +1,21 @@
+#pragma once
+
+#include "radio/RFCommand.h"
+
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Commands handed to a transmit task as one queue item, linked through RFCommand::next in the order they were added
+  struct RFBatch {
+    RFCommand* head;
+    RFCommand* tail;
+    std::size_t size;
+
+    /// @brief Appends a command to the end of the batch
+    void Append(RFCommand* command);
+
+    /// @brief Unlinks every command for a shocker, so a stop later in the same list isn't overtaken by the commands before it
+    /// @return The unlinked commands in their original order, they must be released by the caller
+    RFBatch RemoveShocker(uint16_t shockerId);
+  };
+}  // namespace OpenShock
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "radio/rmt/Sequence.h"
+#include "radio/Waveform.h"
+#include "ShockerModelType.h"
+
+#include <cstdint>
+
+namespace OpenShock {
+  struct RFCommand {
+    int64_t until;
+    int64_t executeAt;     // When the command takes over, in ms, commands for later are held in the jitter buffer until then
+    int64_t queuedAtUs;    // When the command was handed to the transmit task, for queue wait accounting
+    int64_t receivedAtUs;  // When the gateway frame carrying the command was received, 0 if the command is not traced
+    int64_t dequeuedAtUs;  // When the transmit task picked the command up, only set for traced commands
+    Rmt::Sequence sequence;
+    Rmt::Sequence zeroSequence;
+    Waveform* waveform;     // Pattern the sequence is resampled from before every frame, nullptr for fixed commands
+    int64_t waveformStart;  // When waveform playback started, in ms
+    ShockerModelType model;
+    uint16_t shockerId;
+    uint16_t minRepeatIntervalMs;  // Minimum time between the start of two frames for this shocker
+    bool overwrite;  // Whether this command may replace an active command for the same shocker
+    RFCommand* next;  // Next command of the same batch, a batch is handed to the transmit task as one queue item
+  };
+}  // namespace OpenShock
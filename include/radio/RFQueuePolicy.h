@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace OpenShock {
+  /// @brief What a transmitter does with a new batch when its command queue is still full after coalescing
+  enum class RFQueuePolicy : uint8_t {
+    DropOldest = 0,  // Drop the oldest queued batch to make room, the newest state is the one that matters for a live session
+    RejectNew  = 1,  // Keep the queue as is and reject the new batch, the sender sees the failure and can back off
+  };
+
+  /// @brief Admission counters and queue fill of one transmitter, the counters wrap, consumers should diff consecutive snapshots
+  struct RFQueueStatus {
+    uint8_t transmitter;
+    uint8_t depth;  // Batches waiting for the transmit task
+    uint8_t capacity;
+    RFQueuePolicy policy;
+    uint32_t rejected;   // Commands and stops refused because their queue was full
+    uint32_t dropped;    // Queued commands dropped to make room for newer ones
+    uint32_t coalesced;  // Queued commands replaced by a newer one for the same shocker before reaching the transmit task
+  };
+
+  inline const char* RFQueuePolicyToString(RFQueuePolicy policy)
+  {
+    switch (policy) {
+      case RFQueuePolicy::DropOldest:
+        return "drop-oldest";
+      case RFQueuePolicy::RejectNew:
+        return "reject-new";
+      default:
+        return "unknown";
+    }
+  }
+
+  inline bool RFQueuePolicyFromString(const char* str, RFQueuePolicy& out)
+  {
+    if (strcasecmp(str, "drop-oldest") == 0) {
+      out = RFQueuePolicy::DropOldest;
+      return true;
+    }
+
+    if (strcasecmp(str, "reject-new") == 0) {
+      out = RFQueuePolicy::RejectNew;
+      return true;
+    }
+
+    return false;
+  }
+}  // namespace OpenShock
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Common.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock {
+  /// @brief Air-time and queueing counters for one transmitter, in total and per shocker
+  ///
+  /// Counters are relaxed atomics so they can be bumped from the transmit task and from any task sending commands without locking.
+  /// Time counters are 32 bit microseconds and wrap around after ~71 minutes of accumulated time, diff consecutive snapshots to get rates.
+  class RFStats {
+    DISABLE_COPY(RFStats);
+    DISABLE_MOVE(RFStats);
+
+  public:
+    static constexpr std::size_t kMaxShockers = 16;
+    static constexpr uint8_t kSnapshotVersion = 2;
+
+    /// @brief Upper bounds of the stop latency histogram buckets, the last bucket holds everything above
+    static constexpr std::array<uint32_t, 7> kStopLatencyBoundsUs = {1000, 2000, 5000, 10'000, 20'000, 50'000, 100'000};
+    static constexpr std::size_t kStopLatencyBuckets           = kStopLatencyBoundsUs.size() + 1;
+
+    struct Totals {
+      uint32_t elapsedMs;  // Time since the counters were last reset, wraps around after ~49 days
+      uint32_t frames;
+      uint32_t airTimeUs;
+      uint32_t commands;
+      uint32_t queueWaitUs;  // Summed over all commands, divide by commands for the average
+      uint32_t queueWaitMaxUs;
+      uint32_t overwrites;
+      uint32_t drops;
+      uint32_t stops;
+      uint32_t stopLatencyMaxUs;
+      std::array<uint32_t, kStopLatencyBuckets> stopLatency;  // Stops per latency bucket, from the stop request to its first zero frame going on air
+    };
+
+    struct Shocker {
+      uint16_t shockerId;
+      uint32_t frames;
+      uint32_t airTimeUs;
+      uint32_t overwrites;
+      uint32_t drops;
+    };
+
+    struct Snapshot {
+      uint8_t transmitter;
+      int8_t txPin;
+      Totals totals;
+      uint8_t shockerCount;
+      std::array<Shocker, kMaxShockers> shockers;
+    };
+
+    RFStats();
+
+    /// @brief Counts frames that went on air, airTimeUs is per frame, frames > 1 for the passes of a burst
+    void CountFrame(uint16_t shockerId, uint32_t airTimeUs, uint32_t frames = 1);
+    void CountCommand(uint32_t queueWaitUs);
+    void CountOverwrite(uint16_t shockerId);
+    void CountDrop(uint16_t shockerId);
+    void CountStop(uint32_t latencyUs);
+
+    Totals GetTotals() const;
+    std::size_t GetShockers(Shocker* out, std::size_t maxCount) const;
+    void GetSnapshot(Snapshot& out) const;
+    void Reset();
+
+    /// @brief Encodes snapshots into the compact little endian binary format:
+    ///   [version:u8][count:u8] then per transmitter:
+    ///   [transmitter:u8][txPin:i8][elapsedMs:u32][frames:u32][airTimeUs:u32][commands:u32][queueWaitUs:u32][queueWaitMaxUs:u32][overwrites:u32][drops:u32]
+    ///   [stops:u32][stopLatencyMaxUs:u32][stopLatency:u32 * kStopLatencyBuckets][shockerCount:u8]
+    ///   followed by shockerCount times [shockerId:u16][frames:u32][airTimeUs:u32][overwrites:u32][drops:u32]
+    static void Serialize(const Snapshot* snapshots, std::size_t count, std::vector<uint8_t>& out);
+
+  private:
+    struct ShockerSlot {
+      std::atomic<uint32_t> key;  // shockerId + 1, 0 if the slot is free
+      std::atomic<uint32_t> frames;
+      std::atomic<uint32_t> airTimeUs;
+      std::atomic<uint32_t> overwrites;
+      std::atomic<uint32_t> drops;
+    };
+
+    ShockerSlot* slotFor(uint16_t shockerId);
+
+    std::atomic<uint32_t> m_resetAtMs;
+    std::atomic<uint32_t> m_frames;
+    std::atomic<uint32_t> m_airTimeUs;
+    std::atomic<uint32_t> m_commands;
+    std::atomic<uint32_t> m_queueWaitUs;
+    std::atomic<uint32_t> m_queueWaitMaxUs;
+    std::atomic<uint32_t> m_overwrites;
+    std::atomic<uint32_t> m_drops;
+    std::atomic<uint32_t> m_stops;
+    std::atomic<uint32_t> m_stopLatencyMaxUs;
+    std::array<std::atomic<uint32_t>, kStopLatencyBuckets> m_stopLatency;
+    std::array<ShockerSlot, kMaxShockers> m_shockers;
+  };
+}  // namespace OpenShock
@@ -1,36 +1,113 @@
 #pragma once
 
+#include "radio/JitterBuffer.h"
+#include "radio/RFBatch.h"
+#include "radio/RFCommand.h"
+#include "radio/RFQueuePolicy.h"
+#include "radio/RFStats.h"
+#include "radio/TransmitScheduler.h"
+#include "radio/Waveform.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
+#include "SimpleMutex.h"
+#include "SlabPool.h"
 
 #include <esp32-hal-rmt.h>
+#include <esp_timer.h>
 #include <hal/gpio_types.h>
 
 #include <freertos/queue.h>
 #include <freertos/task.h>
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 namespace OpenShock {
   class RFTransmitter {
   public:
+    static constexpr std::size_t kCommandPoolSize = 32;  // 32 * ~380 bytes = ~12KB per transmitter
+    static constexpr std::size_t kStopPoolSize    = 8;   // Zero frames of stops for shockers the scheduler doesn't track, commands can't take these
+
     RFTransmitter(gpio_num_t gpioPin);
     ~RFTransmitter();
 
     inline gpio_num_t GetTxPin() const { return m_txPin; }
 
-    inline bool ok() const { return m_rmtHandle != nullptr && m_queueHandle != nullptr && m_taskHandle != nullptr; }
+    inline bool ok() const { return m_rmtHandle != nullptr && m_queueHandle != nullptr && m_stopQueueHandle != nullptr && m_taskHandle != nullptr; }
+
+    /// @brief Commands collected in a batch reach the transmit task together, so they all start on the same scheduler cycle
+    using Batch = RFBatch;
+
+    bool SendCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, bool overwriteExisting = true, uint16_t minRepeatIntervalMs = 0);
+
+    /// @brief Encodes a command and appends it to batch, nothing is sent until SendBatch
+    /// @param now Timestamp the command duration counts from, pass the same value for every command of a batch
+    bool AddToBatch(Batch& batch, ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t now, bool overwriteExisting = true, uint16_t minRepeatIntervalMs = 0);
+    /// @brief Hands every command in batch to the transmit task at once, batch is empty afterwards even on failure
+    ///
+    /// Never blocks on a full queue. Queued commands that the batch supersedes are coalesced first, if that doesn't free a slot the queue policy decides
+    /// between dropping the oldest queued batch and rejecting this one.
+    bool SendBatch(Batch& batch);
+    /// @brief Drops every command in batch without sending it, batch must come from this transmitter
+    void ReleaseBatch(Batch& batch);
+
+    /// @brief Plays a waveform on a shocker, the transmit task resamples it before every frame until it is over
+    bool SendWaveform(ShockerModelType model, uint16_t shockerId, const Waveform& waveform);
+
+    /// @brief Stops a shocker through the priority stop lane
+    ///
+    /// Stops bypass the command queue and never block the caller, the transmit task raises its own priority until they are on air. Commands for the
+    /// shocker queued before the stop are purged and its zero sequence goes out ahead of every other frame. What is already on air can't be cut short,
+    /// so the worst case latency is one burst of a command running on its own (at most 150 ms, 2 Petrainer frames) plus the completion margin and a
+    /// scheduler tick.
+    bool SendStop(ShockerModelType model, uint16_t shockerId);
 
-    bool SendCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, bool overwriteExisting = true);
     void ClearPendingCommands();
 
+    /// @brief Frame rates achieved per active shocker over the last second
+    inline std::size_t GetFrameRates(TransmitScheduler::FrameRate* out, std::size_t maxCount) const { return m_scheduler.GetFrameRates(out, maxCount); }
+
+    /// @brief Air-time, queueing, overwrite and drop counters of this transmitter
+    inline RFStats& GetStats() { return m_stats; }
+
+    /// @brief Queue fill and admission counters, transmitter is left for the caller to fill in
+    void GetQueueStatus(RFQueueStatus& out) const;
+
+    /// @brief Admission policy of every transmitter's command queue
+    static void SetQueuePolicy(RFQueuePolicy policy);
+    static RFQueuePolicy GetQueuePolicy();
+
   private:
+    struct StopRequest {
+      ShockerModelType model;
+      uint16_t shockerId;
+      int64_t queuedAtUs;
+    };
+
     void destroy();
+    void releaseCommand(RFCommand* cmd);
+    bool makeRoom(const RFCommand* incoming);
+    bool applyStop(const StopRequest& stop, int64_t now);
+    void submitCommand(RFCommand* cmd, int64_t now);
+    void sampleWaveform(const RFCommand& cmd, int64_t at, Rmt::Sequence& out);
     void TransmitTask();
+    void TransmitDone();
 
     gpio_num_t m_txPin;
     rmt_obj_t* m_rmtHandle;
     QueueHandle_t m_queueHandle;
+    QueueHandle_t m_stopQueueHandle;
     TaskHandle_t m_taskHandle;
+    esp_timer_handle_t m_txDoneTimer;
+    TransmitScheduler m_scheduler;
+    JitterBuffer m_jitterBuffer;
+    RFStats m_stats;
+    SlabPool<RFCommand, kCommandPoolSize> m_commandPool;  // Per transmitter, so a busy one can't starve the others of slots
+    SlabPool<RFCommand, kStopPoolSize> m_stopPool;
+    SimpleMutex m_sendMutex;  // Serializes senders, so a slot freed for one sender can't be taken by another
+    std::atomic<uint32_t> m_rejected;
+    std::atomic<uint32_t> m_dropped;
+    std::atomic<uint32_t> m_coalesced;
   };
 }  // namespace OpenShock
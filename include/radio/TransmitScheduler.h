@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Common.h"
+#include "radio/RFCommand.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Decides which shocker gets the next frame on a transmitter shared by multiple shockers
+  ///
+  /// Every active shocker has a deadline of (last frame start + minimum repeat interval), the due shocker with the earliest deadline is sent first.
+  /// Once a command expires its zero sequence is sent for a short while to stop the shocker, the first zero frame takes priority over everything else.
+  ///
+  /// @note Not thread-safe, only the transmit task may mutate it. GetFrameRates may be called from any task.
+  class TransmitScheduler {
+    DISABLE_COPY(TransmitScheduler);
+    DISABLE_MOVE(TransmitScheduler);
+
+  public:
+    static constexpr std::size_t kMaxShockers = 16;
+
+    struct Frame {
+      Rmt::Sequence* sequence;
+      uint16_t shockerId;
+      bool isZero;
+    };
+
+    struct FrameRate {
+      uint16_t shockerId;
+      float framesPerSecond;
+    };
+
+    TransmitScheduler();
+
+    inline bool empty() const { return m_count == 0; }
+    inline std::size_t size() const { return m_count; }
+
+    /// @brief Adds a command, replacing the active command for the same shocker unless the new command may not overwrite it
+    /// @return The command that is no longer referenced by the scheduler and must be released by the caller, or nullptr
+    RFCommand* Submit(RFCommand* command, int64_t now);
+
+    /// @brief Picks the frame that should be transmitted at now
+    /// @param nextWakeup Set to the earliest time something becomes due when nothing is due now, INT64_MAX if idle
+    /// @return true if frame should be transmitted now
+    bool Next(int64_t now, Frame& frame, int64_t& nextWakeup);
+
+    /// @brief Accounts the extra passes of a burst for a shocker, they count as sent at now
+    void CountRepeats(uint16_t shockerId, int64_t now, uint32_t frames);
+
+    /// @brief Active command of a shocker, or nullptr
+    RFCommand* Find(uint16_t shockerId);
+
+    /// @brief Cuts the active command of a shocker short and restarts its zero sequence phase, so zero frames go out next
+    /// @return false if the shocker has no active command
+    bool Stop(uint16_t shockerId, int64_t now);
+
+    /// @brief Makes every active command expire no later than until, used for E-Stop
+    /// @return true if any command was cut short
+    bool ExpireAll(int64_t until);
+
+    /// @brief Removes one command that has finished its zero sequence phase (or all commands if force is set)
+    /// @return The removed command that must be released by the caller, or nullptr if there is none
+    RFCommand* PopFinished(int64_t now, bool force = false);
+
+    std::size_t GetFrameRates(FrameRate* out, std::size_t maxCount) const;
+
+  private:
+    struct Entry {
+      RFCommand* command;
+      int64_t lastSent;
+      int64_t windowStart;
+      uint32_t windowFrames;
+      bool sentZero;
+    };
+
+    void removeAt(std::size_t index);
+    void countFrame(std::size_t index, int64_t now, uint32_t frames = 1);
+
+    std::array<Entry, kMaxShockers> m_entries;
+    std::array<std::atomic<uint32_t>, kMaxShockers> m_rates;  // [shockerId:16][centi-frames per second:16]
+    std::atomic<std::size_t> m_count;
+  };
+}  // namespace OpenShock
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "ShockerCommandType.h"
+
+#include <array>
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Intensity pattern played back by the transmit task, so ramps and pulses don't need a gateway message per step
+  ///
+  /// A waveform is a list of keyframes within a period, the period is played `repeats` times. Each keyframe holds its type and intensity until the next
+  /// one, or ramps the intensity linearly towards it. A ramp on the last keyframe goes towards the first one, so looped patterns wrap around smoothly.
+  ///
+  /// Compact encoding, little endian:
+  ///   u8 version, u8 keyframe count, u16 period ms, u8 repeats
+  ///   per keyframe: u16 offset ms, u8 type (bit 7: ramp to the next keyframe), u8 intensity
+  struct Waveform {
+    static constexpr uint8_t kVersion            = 1;
+    static constexpr std::size_t kMaxKeyframes   = 16;
+    static constexpr std::size_t kHeaderSize     = 5;
+    static constexpr std::size_t kKeyframeSize   = 4;
+    static constexpr std::size_t kMaxEncodedSize = kHeaderSize + kMaxKeyframes * kKeyframeSize;
+
+    struct Keyframe {
+      uint16_t offsetMs;  // From the start of the period, strictly increasing, the first keyframe starts at 0
+      ShockerCommandType type;
+      uint8_t intensity;
+      bool ramp;
+    };
+
+    std::array<Keyframe, kMaxKeyframes> keyframes;
+    uint8_t keyframeCount;
+    uint16_t periodMs;
+    uint8_t repeats;
+
+    /// @brief Time it takes to play every repeat of the period
+    inline uint32_t DurationMs() const { return static_cast<uint32_t>(periodMs) * repeats; }
+
+    /// @brief Type and intensity at elapsedMs since the start of playback, returns false once playback is over
+    bool Sample(int64_t elapsedMs, ShockerCommandType& type, uint8_t& intensity) const;
+
+    /// @brief Parses and validates the compact encoding, returns false if data is malformed
+    static bool Parse(const uint8_t* data, std::size_t length, Waveform& out);
+    /// @brief Writes the compact encoding, returns the number of bytes written or 0 if it doesn't fit
+    std::size_t Serialize(uint8_t* data, std::size_t length) const;
+  };
+}  // namespace OpenShock
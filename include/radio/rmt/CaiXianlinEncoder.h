@@ -1,12 +1,85 @@
 #pragma once
 
-#include "ShockerCommandType.h"
+#include "radio/rmt/internal/Protocol.h"
 
-#include <esp32-hal-rmt.h>
+#include "Checksum.h"
 
+#include <algorithm>
 #include <cstdint>
-#include <vector>
+
+// This is the encoder for the CaiXianlin shocker.
+//
+// It is based on the following documentation:
+// https://wiki.openshock.org/hardware/shockers/caixianlin/#rf-specification
 
 namespace OpenShock::Rmt::CaiXianlinEncoder {
-  std::vector<rmt_data_t> GetSequence(uint16_t transmitterId, uint8_t channelId, OpenShock::ShockerCommandType type, uint8_t intensity);
-}
+  template<uint8_t ChannelId = 0>
+  struct Protocol {
+    static_assert(ChannelId <= 0xF, "ChannelId is 4 bits wide");
+
+    static constexpr rmt_data_t Preamble = {1400, 1, 800, 0};
+    static constexpr rmt_data_t One      = {800, 1, 300, 0};
+    static constexpr rmt_data_t Zero     = {300, 1, 800, 0};
+
+    static constexpr std::array<rmt_data_t, 3> Postamble = {Zero, Zero, Zero};
+
+    static constexpr std::size_t PayloadBits = 40;
+
+    // Payload layout: [transmitterId:16][channelId:4][type:4][intensity:8][checksum:8]
+    static constexpr uint64_t Payload(uint16_t transmitterId, ShockerCommandType type, uint8_t intensity)
+    {
+      // Intensity must be between 0 and 99
+      intensity = std::min(intensity, static_cast<uint8_t>(99));
+
+      uint8_t typeVal = 0;
+      switch (type) {
+        case ShockerCommandType::Shock:
+          typeVal = 0x01;
+          break;
+        case ShockerCommandType::Vibrate:
+          typeVal = 0x02;
+          break;
+        case ShockerCommandType::Sound:
+          typeVal   = 0x03;
+          intensity = 0;  // Sound intensity must be 0 for some shockers, otherwise it wont work, or they soft lock until restarted
+          break;
+        default:
+          return Internal::kInvalidPayload;
+      }
+
+      uint32_t payload = static_cast<uint32_t>(Internal::PackFields<16, 4, 4, 8>(transmitterId, ChannelId, typeVal, intensity));
+
+      return Internal::PackFields<32, 8>(payload, Checksum::Sum8(payload));
+    }
+
+    static constexpr bool Parse(uint64_t payload, uint16_t& transmitterId, ShockerCommandType& type, uint8_t& intensity)
+    {
+      std::array<uint64_t, 5> fields = Internal::UnpackFields<16, 4, 4, 8, 8>(payload);
+
+      switch (fields[2]) {
+        case 0x01:
+          type = ShockerCommandType::Shock;
+          break;
+        case 0x02:
+          type = ShockerCommandType::Vibrate;
+          break;
+        case 0x03:
+          type = ShockerCommandType::Sound;
+          break;
+        default:
+          return false;
+      }
+
+      transmitterId = static_cast<uint16_t>(fields[0]);
+      intensity     = static_cast<uint8_t>(fields[3]);
+
+      return fields[1] == ChannelId;
+    }
+  };
+
+  template<uint8_t ChannelId = 0>
+  inline bool GetSequence(uint16_t transmitterId, ShockerCommandType type, uint8_t intensity, Sequence& out)
+  {
+    return Internal::Encode<Protocol<ChannelId>>(transmitterId, type, intensity, out);
+  }
+}  // namespace OpenShock::Rmt::CaiXianlinEncoder
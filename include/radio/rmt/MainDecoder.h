@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ShockerCommandType.h"
+#include "ShockerModelType.h"
+
+#include <esp32-hal-rmt.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenShock::Rmt {
+  struct DecodedCommand {
+    ShockerModelType model;
+    uint16_t shockerId;
+    ShockerCommandType type;
+    uint8_t intensity;
+  };
+
+  /// @brief Turns a pulse train back into the command it encodes, trying every shocker model, returns false if it is not a valid frame of any of them
+  ///
+  /// Not used by the firmware itself, lets host tests check what actually went on air.
+  bool Decode(const rmt_data_t* pulses, std::size_t length, DecodedCommand& out);
+}  // namespace OpenShock::Rmt
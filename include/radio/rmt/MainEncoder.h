@@ -1,17 +1,15 @@
 #pragma once
 
+#include "radio/rmt/Sequence.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
 
-#include <esp32-hal-rmt.h>
-
 #include <cstdint>
-#include <memory>
-#include <vector>
 
 namespace OpenShock::Rmt {
-  std::vector<rmt_data_t> GetSequence(ShockerModelType model, uint16_t shockerId, OpenShock::ShockerCommandType type, uint8_t intensity);
-  inline std::vector<rmt_data_t> GetZeroSequence(ShockerModelType model, uint16_t shockerId) {
-    return GetSequence(model, shockerId, ShockerCommandType::Vibrate, 0);
+  /// @brief Encodes a command for the given shocker model into out, returns false (and clears out) if it can't be encoded
+  bool GetSequence(ShockerModelType model, uint16_t shockerId, OpenShock::ShockerCommandType type, uint8_t intensity, Sequence& out);
+  inline bool GetZeroSequence(ShockerModelType model, uint16_t shockerId, Sequence& out) {
+    return Rmt::GetSequence(model, shockerId, ShockerCommandType::Vibrate, 0, out);
   }
 }
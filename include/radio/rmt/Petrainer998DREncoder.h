@@ -1,12 +1,90 @@
 #pragma once
 
-#include "ShockerCommandType.h"
-
-#include <esp32-hal-rmt.h>
+#include "radio/rmt/internal/Protocol.h"
 
+#include <algorithm>
 #include <cstdint>
-#include <vector>
 
 namespace OpenShock::Rmt::Petrainer998DREncoder {
-  std::vector<rmt_data_t> GetSequence(uint16_t shockerId, OpenShock::ShockerCommandType type, uint8_t intensity);
-}
+  struct Protocol {
+    static constexpr rmt_data_t Preamble = {1500, 1, 750, 0};
+    static constexpr rmt_data_t One      = {750, 1, 250, 0};
+    static constexpr rmt_data_t Zero     = {250, 1, 750, 0};
+
+    static constexpr std::array<rmt_data_t, 2> Postamble = {
+      Zero,                            // Idk why this is here, the decoded protocol has it
+      rmt_data_t {1500, 0, 1500, 0},  // Some subvariants expect a quiet period between commands
+    };
+
+    static constexpr std::size_t PayloadBits = 40;
+
+    // TODO: Below ShockerID is 17 bits wide, and intensity is 7 bits wide. This is weird as ShockerID has 1 more bit and intensity has 1 less bit than 8 bit alignment. This needs investigation.
+    // Payload layout: [channel:4][typeVal:4][shockerID:17][intensity:7][typeInvert:4][channelInvert:4] (40 bits)
+    static constexpr uint64_t Payload(uint16_t shockerId, ShockerCommandType type, uint8_t intensity)
+    {
+      // Intensity must be between 0 and 100
+      intensity = std::min(intensity, static_cast<uint8_t>(100));
+
+      int typeShift = 0;
+      switch (type) {
+        case ShockerCommandType::Shock:
+          typeShift = 0;
+          break;
+        case ShockerCommandType::Vibrate:
+          typeShift = 1;
+          break;
+        case ShockerCommandType::Sound:
+          typeShift = 2;
+          break;
+        // case ShockerCommandType::Light:
+        //   typeShift = 3;
+        //   break;
+        default:
+          return Internal::kInvalidPayload;
+      }
+
+      uint8_t typeVal    = 0b0001 << typeShift;
+      uint8_t typeInvert = ~(0b1000 >> typeShift);
+
+      // TODO: Channel argument?
+      uint8_t channel       = 0b1000;  // Can be [1000] or [1111], 4 bits wide
+      uint8_t channelInvert = 0b1110;  // Can be [1110] or [0000], 4 bits wide
+
+      return Internal::PackFields<4, 4, 17, 7, 4, 4>(channel, typeVal, shockerId, intensity, typeInvert, channelInvert);
+    }
+
+    static constexpr bool Parse(uint64_t payload, uint16_t& shockerId, ShockerCommandType& type, uint8_t& intensity)
+    {
+      std::array<uint64_t, 6> fields = Internal::UnpackFields<4, 4, 17, 7, 4, 4>(payload);
+
+      switch (fields[1]) {
+        case 0b0001:
+          type = ShockerCommandType::Shock;
+          break;
+        case 0b0010:
+          type = ShockerCommandType::Vibrate;
+          break;
+        case 0b0100:
+          type = ShockerCommandType::Sound;
+          break;
+        default:
+          return false;
+      }
+
+      // Shocker IDs are 16 bit on our side, the 17th bit is never set by the encoder
+      if (fields[2] > 0xFFFF) {
+        return false;
+      }
+
+      shockerId = static_cast<uint16_t>(fields[2]);
+      intensity = static_cast<uint8_t>(fields[3]);
+
+      return true;
+    }
+  };
+
+  inline bool GetSequence(uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Sequence& out)
+  {
+    return Internal::Encode<Protocol>(shockerId, type, intensity, out);
+  }
+}  // namespace OpenShock::Rmt::Petrainer998DREncoder
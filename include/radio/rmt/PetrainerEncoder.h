@@ -1,12 +1,79 @@
 #pragma once
 
-#include "ShockerCommandType.h"
-
-#include <esp32-hal-rmt.h>
+#include "radio/rmt/internal/Protocol.h"
 
+#include <algorithm>
 #include <cstdint>
-#include <vector>
 
 namespace OpenShock::Rmt::PetrainerEncoder {
-  std::vector<rmt_data_t> GetSequence(uint16_t shockerId, OpenShock::ShockerCommandType type, uint8_t intensity);
-}
+  struct Protocol {
+    static constexpr rmt_data_t Preamble = {750, 1, 750, 0};
+    static constexpr rmt_data_t One      = {200, 1, 1500, 0};
+    static constexpr rmt_data_t Zero     = {200, 1, 750, 0};
+
+    static constexpr std::array<rmt_data_t, 1> Postamble = {
+      rmt_data_t {200, 1, 7000, 0},
+    };
+
+    static constexpr std::size_t PayloadBits = 40;
+
+    // Payload layout: [methodBit:8][shockerId:16][intensity:8][methodChecksum:8]
+    static constexpr uint64_t Payload(uint16_t shockerId, ShockerCommandType type, uint8_t intensity)
+    {
+      // Intensity must be between 0 and 100
+      intensity = std::min(intensity, static_cast<uint8_t>(100));
+
+      uint8_t nShift = 0;
+      switch (type) {
+        case ShockerCommandType::Shock:
+          nShift = 0;
+          break;
+        case ShockerCommandType::Vibrate:
+          nShift = 1;
+          break;
+        case ShockerCommandType::Sound:
+          nShift = 2;
+          break;
+        default:
+          return Internal::kInvalidPayload;
+      }
+
+      // Type is 0x80 | (0x01 << nShift)
+      uint8_t typeVal = 0x80 | (0x01 << nShift);
+
+      // TypeSum is NOT(0x01 | (0x80 >> nShift))
+      uint8_t typeSum = ~(0x01 | (0x80 >> nShift));
+
+      return Internal::PackFields<8, 16, 8, 8>(typeVal, shockerId, intensity, typeSum);
+    }
+
+    static constexpr bool Parse(uint64_t payload, uint16_t& shockerId, ShockerCommandType& type, uint8_t& intensity)
+    {
+      std::array<uint64_t, 4> fields = Internal::UnpackFields<8, 16, 8, 8>(payload);
+
+      switch (fields[0]) {
+        case 0x81:
+          type = ShockerCommandType::Shock;
+          break;
+        case 0x82:
+          type = ShockerCommandType::Vibrate;
+          break;
+        case 0x84:
+          type = ShockerCommandType::Sound;
+          break;
+        default:
+          return false;
+      }
+
+      shockerId = static_cast<uint16_t>(fields[1]);
+      intensity = static_cast<uint8_t>(fields[2]);
+
+      return true;
+    }
+  };
+
+  inline bool GetSequence(uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Sequence& out)
+  {
+    return Internal::Encode<Protocol>(shockerId, type, intensity, out);
+  }
+}  // namespace OpenShock::Rmt::PetrainerEncoder
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <esp32-hal-rmt.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace OpenShock::Rmt {
+  // Longest sequence any of the encoders can produce (CaiXianlin: preamble + 43 bits)
+  constexpr std::size_t kMaxSequenceLength = 44;
+
+  /// @brief Fixed capacity RMT pulse train, stored inline so it can live in pools and caches without touching the heap
+  struct Sequence {
+    std::array<rmt_data_t, kMaxSequenceLength> pulses;
+    uint8_t length;
+
+    inline bool empty() const { return length == 0; }
+    inline std::size_t size() const { return length; }
+    inline rmt_data_t* data() { return pulses.data(); }
+    inline const rmt_data_t* data() const { return pulses.data(); }
+    inline void clear() { length = 0; }
+
+    /// @brief Total time the sequence takes on air, in RMT ticks
+    inline uint32_t airTime() const
+    {
+      uint32_t ticks = 0;
+      for (std::size_t i = 0; i < length; ++i) {
+        ticks += pulses[i].duration0 + pulses[i].duration1;
+      }
+
+      return ticks;
+    }
+
+    /// @brief Replaces the contents of the sequence, returns false (and clears it) if the pulses do not fit
+    inline bool assign(const rmt_data_t* begin, std::size_t count)
+    {
+      if (count > kMaxSequenceLength) {
+        length = 0;
+        return false;
+      }
+
+      std::copy(begin, begin + count, pulses.begin());
+      length = static_cast<uint8_t>(count);
+
+      return true;
+    }
+  };
+}  // namespace OpenShock::Rmt
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "ShockerCommandType.h"
+#include "ShockerModelType.h"
+
+#include "radio/rmt/Sequence.h"
+
+#include <cstdint>
+
+namespace OpenShock::Rmt::SequenceCache {
+  constexpr std::size_t kMaxPinned = 16;
+
+  struct Stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint8_t entries;
+    uint8_t capacity;
+    uint8_t pinned;
+  };
+
+  struct PinnedShocker {
+    ShockerModelType model;
+    uint16_t shockerId;
+  };
+
+  /// @brief Gets the RMT sequence for a command, encoding and caching it if it is not cached yet
+  /// @note Safe to call from multiple tasks, least recently used entries are evicted when the cache is full
+  /// @return false if the command could not be encoded, in which case out is left empty
+  bool GetSequence(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Rmt::Sequence& out);
+  inline bool GetZeroSequence(ShockerModelType model, uint16_t shockerId, Rmt::Sequence& out)
+  {
+    return SequenceCache::GetSequence(model, shockerId, ShockerCommandType::Vibrate, 0, out);
+  }
+
+  /// @brief Replaces the pinned shockers, their zero sequences are encoded right away and never evicted
+  /// @note The zero sequence is what keep-alives, command tails and stops send, so a pinned shocker's first frames need no encoding
+  /// @return Number of shockers pinned, at most kMaxPinned
+  std::size_t SetPinned(const PinnedShocker* shockers, std::size_t count);
+
+  Stats GetStats();
+  /// @brief Drops every cached and pinned sequence and resets the stats
+  void Clear();
+}  // namespace OpenShock::Rmt::SequenceCache
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "radio/rmt/Sequence.h"
+#include "ShockerCommandType.h"
+
+#include <esp32-hal-rmt.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+// A protocol descriptor is a struct with:
+//   static constexpr rmt_data_t Preamble, One, Zero;
+//   static constexpr std::array<rmt_data_t, N> Postamble;
+//   static constexpr std::size_t PayloadBits;
+//   static constexpr uint64_t Payload(uint16_t shockerId, ShockerCommandType type, uint8_t intensity);  // kInvalidPayload if the command can't be encoded
+//   static constexpr bool Parse(uint64_t payload, uint16_t& shockerId, ShockerCommandType& type, uint8_t& intensity);  // Inverse of Payload
+//
+// A frame is laid out as [Preamble][PayloadBits symbols, MSB first][Postamble...], the encoder and decoder are generated from that.
+
+namespace OpenShock::Rmt::Internal {
+  constexpr uint64_t kInvalidPayload = std::numeric_limits<uint64_t>::max();
+
+  /// @brief Packs fields MSB first, each value is truncated to its width, e.g. PackFields<16, 4>(a, b) == (a << 4) | (b & 0xF)
+  template<std::size_t... Widths, typename... Values>
+  constexpr uint64_t PackFields(Values... values)
+  {
+    static_assert(sizeof...(Widths) == sizeof...(Values), "Every field needs a width");
+    static_assert(((Widths > 0 && Widths < 64) && ...), "Field widths must be between 1 and 63 bits");
+    static_assert((Widths + ... + 0) <= 64, "Fields must fit in 64 bits");
+
+    uint64_t packed = 0;
+    ((packed = (packed << Widths) | (static_cast<uint64_t>(values) & ((uint64_t(1) << Widths) - 1))), ...);
+    return packed;
+  }
+
+  /// @brief Inverse of PackFields, e.g. UnpackFields<16, 4>((a << 4) | b) == {a, b}
+  template<std::size_t... Widths>
+  constexpr std::array<uint64_t, sizeof...(Widths)> UnpackFields(uint64_t packed)
+  {
+    static_assert(((Widths > 0 && Widths < 64) && ...), "Field widths must be between 1 and 63 bits");
+    static_assert((Widths + ... + 0) <= 64, "Fields must fit in 64 bits");
+
+    constexpr std::array<std::size_t, sizeof...(Widths)> widths = {Widths...};
+
+    std::array<uint64_t, sizeof...(Widths)> fields {};
+    std::size_t shift = (Widths + ... + 0);
+    for (std::size_t i = 0; i < widths.size(); ++i) {
+      shift -= widths[i];
+      fields[i] = (packed >> shift) & ((uint64_t(1) << widths[i]) - 1);
+    }
+
+    return fields;
+  }
+
+  template<typename Protocol>
+  constexpr std::size_t FrameLength = 1 + Protocol::PayloadBits + Protocol::Postamble.size();
+
+  template<typename Protocol>
+  using Frame = std::array<rmt_data_t, FrameLength<Protocol>>;
+
+  template<typename Protocol, std::size_t... Bit, std::size_t... Post>
+  constexpr Frame<Protocol> BuildFrame(uint64_t payload, std::index_sequence<Bit...>, std::index_sequence<Post...>)
+  {
+    return {{
+      Protocol::Preamble,
+      (((payload >> (Protocol::PayloadBits - 1 - Bit)) & 1) != 0 ? Protocol::One : Protocol::Zero)...,
+      Protocol::Postamble[Post]...,
+    }};
+  }
+
+  /// @brief Builds the frame for an encoded payload, fully unrolled and usable in constant expressions
+  template<typename Protocol>
+  constexpr Frame<Protocol> BuildFrame(uint64_t payload)
+  {
+    static_assert(Protocol::PayloadBits > 0 && Protocol::PayloadBits < 64, "PayloadBits must be between 1 and 63");
+
+    return BuildFrame<Protocol>(payload, std::make_index_sequence<Protocol::PayloadBits>(), std::make_index_sequence<Protocol::Postamble.size()>());
+  }
+
+  /// @brief Encodes a command into out, returns false (and clears out) if the protocol can't encode it
+  template<typename Protocol>
+  inline bool Encode(uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Sequence& out)
+  {
+    static_assert(FrameLength<Protocol> <= kMaxSequenceLength, "Frame does not fit in a Sequence, raise kMaxSequenceLength");
+
+    uint64_t payload = Protocol::Payload(shockerId, type, intensity);
+    if (payload == kInvalidPayload) {
+      out.clear();
+      return false;
+    }
+
+    Frame<Protocol> frame = BuildFrame<Protocol>(payload);
+
+    return out.assign(frame.data(), frame.size());
+  }
+
+  constexpr bool SamePulse(const rmt_data_t& a, const rmt_data_t& b)
+  {
+    return a.duration0 == b.duration0 && a.level0 == b.level0 && a.duration1 == b.duration1 && a.level1 == b.level1;
+  }
+
+  /// @brief Checks a frame symbol by symbol against a payload, meant for static_assert golden vectors
+  template<typename Protocol>
+  constexpr bool FrameMatches(const Frame<Protocol>& frame, uint64_t payload)
+  {
+    if (!SamePulse(frame[0], Protocol::Preamble)) {
+      return false;
+    }
+
+    for (std::size_t i = 0; i < Protocol::PayloadBits; ++i) {
+      bool one = ((payload >> (Protocol::PayloadBits - 1 - i)) & 1) != 0;
+      if (!SamePulse(frame[1 + i], one ? Protocol::One : Protocol::Zero)) {
+        return false;
+      }
+    }
+
+    for (std::size_t i = 0; i < Protocol::Postamble.size(); ++i) {
+      if (!SamePulse(frame[1 + Protocol::PayloadBits + i], Protocol::Postamble[i])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief Recovers the payload from a frame, kInvalidPayload if the pulses are not a frame of the protocol
+  ///
+  /// Pulses have to match exactly, which is what the encoders (and the host virtual RMT backend) produce, captures from real receivers need to be quantized first.
+  template<typename Protocol>
+  constexpr uint64_t DecodeFrame(const rmt_data_t* pulses, std::size_t length)
+  {
+    if (length != FrameLength<Protocol> || !SamePulse(pulses[0], Protocol::Preamble)) {
+      return kInvalidPayload;
+    }
+
+    uint64_t payload = 0;
+    for (std::size_t i = 0; i < Protocol::PayloadBits; ++i) {
+      const rmt_data_t& pulse = pulses[1 + i];
+      if (SamePulse(pulse, Protocol::One)) {
+        payload = (payload << 1) | 1;
+      } else if (SamePulse(pulse, Protocol::Zero)) {
+        payload = payload << 1;
+      } else {
+        return kInvalidPayload;
+      }
+    }
+
+    for (std::size_t i = 0; i < Protocol::Postamble.size(); ++i) {
+      if (!SamePulse(pulses[1 + Protocol::PayloadBits + i], Protocol::Postamble[i])) {
+        return kInvalidPayload;
+      }
+    }
+
+    return payload;
+  }
+
+  /// @brief Decodes a frame back into the command it encodes, the payload has to re-encode to itself so broken checksums and inverted fields are rejected
+  template<typename Protocol>
+  constexpr bool Decode(const rmt_data_t* pulses, std::size_t length, uint16_t& shockerId, ShockerCommandType& type, uint8_t& intensity)
+  {
+    uint64_t payload = DecodeFrame<Protocol>(pulses, length);
+    if (payload == kInvalidPayload) {
+      return false;
+    }
+
+    return Protocol::Parse(payload, shockerId, type, intensity) && Protocol::Payload(shockerId, type, intensity) == payload;
+  }
+
+  /// @brief Checks that a frame decodes to the given command, meant for static_assert golden vectors
+  template<typename Protocol>
+  constexpr bool FrameDecodesTo(const Frame<Protocol>& frame, uint16_t shockerId, ShockerCommandType type, uint8_t intensity)
+  {
+    uint16_t decodedId             = 0;
+    ShockerCommandType decodedType = ShockerCommandType::Stop;
+    uint8_t decodedIntensity       = 0;
+
+    return Decode<Protocol>(frame.data(), frame.size(), decodedId, decodedType, decodedIntensity) && decodedId == shockerId && decodedType == type && decodedIntensity == intensity;
+  }
+}  // namespace OpenShock::Rmt::Internal
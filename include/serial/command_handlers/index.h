@@ -21,6 +21,8 @@ namespace OpenShock::Serial::CommandHandlers {
   OpenShock::Serial::CommandGroup JsonConfigHandler();
   OpenShock::Serial::CommandGroup RawConfigHandler();
   OpenShock::Serial::CommandGroup RfTransmitHandler();
+  OpenShock::Serial::CommandGroup RfStatsHandler();
+  OpenShock::Serial::CommandGroup RfQueueHandler();
   OpenShock::Serial::CommandGroup FactoryResetHandler();
 
   inline std::vector<OpenShock::Serial::CommandGroup> AllCommandHandlers()
@@ -42,6 +44,8 @@ namespace OpenShock::Serial::CommandHandlers {
       JsonConfigHandler(),
       RawConfigHandler(),
       RfTransmitHandler(),
+      RfStatsHandler(),
+      RfQueueHandler(),
       FactoryResetHandler(),
     };
   }
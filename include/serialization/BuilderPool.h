@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Common.h"
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <cstdint>
+#include <optional>
+
+// Reusable FlatBufferBuilders for the outgoing WebSocket messages.
+//
+// A lease borrows a builder from a small fixed pool and clears it on release, so its buffer is kept for the next message instead of being allocated again.
+// Every task remembers the slot it used last and gets it back first, a task that keeps sending the same messages ends up with a buffer that fits them.
+// When every slot is taken, or a lease is nested, the lease falls back to a builder of its own sized after the largest message of that kind seen so far.
+
+namespace OpenShock::Serialization::BuilderPool {
+  enum class MessageKind : uint8_t {
+    GatewayKeepAlive,
+    GatewayBootStatus,
+    GatewayOtaInstallStarted,
+    GatewayOtaInstallProgress,
+    GatewayOtaInstallFailed,
+    GatewayRfQueueStatus,
+    GatewayLatencyReport,
+    LocalError,
+    LocalReady,
+    LocalWiFiScanStatusChanged,
+    LocalWiFiNetwork,
+    LocalWiFiNetworks,
+  };
+
+  constexpr std::size_t kKindCount          = static_cast<std::size_t>(MessageKind::LocalWiFiNetworks) + 1;
+  constexpr std::size_t kSlotCount          = 4;
+  constexpr uint32_t kMinInitialSize        = 64;
+  constexpr uint32_t kDefaultInitialSize    = 256;       // Until a message of the kind has been seen
+  constexpr uint32_t kRetainSize            = 4 * 1024;  // A builder that produced a bigger message gives its buffer back
+  constexpr uint32_t kMaxLearnedInitialSize = 16 * 1024;
+
+  struct KindStats {
+    uint32_t count;      // Messages built
+    uint32_t highWater;  // Largest finished message in bytes
+  };
+
+  /// @brief Pool counters, they wrap, consumers should diff consecutive snapshots
+  struct Stats {
+    uint32_t leases;
+    uint32_t taskHits;   // Leases that got the slot their task used last
+    uint32_t fallbacks;  // Leases that found every slot taken and built their own builder
+    uint32_t released;   // Buffers freed because their message was bigger than kRetainSize
+  };
+
+  class Lease {
+    DISABLE_COPY(Lease);
+    DISABLE_MOVE(Lease);
+
+  public:
+    explicit Lease(MessageKind kind);
+    ~Lease();
+
+    flatbuffers::FlatBufferBuilder& Get() { return *m_builder; }
+
+  private:
+    MessageKind m_kind;
+    std::size_t m_slot;  // kSlotCount for a fallback builder
+    flatbuffers::FlatBufferBuilder* m_builder;
+    std::optional<flatbuffers::FlatBufferBuilder> m_fallback;
+  };
+
+  const char* MessageKindName(MessageKind kind);
+
+  /// @brief Buffer size a new builder for this kind starts with, the high-water mark rounded up to a power of two
+  uint32_t InitialSize(MessageKind kind);
+
+  void GetKindStats(MessageKind kind, KindStats& out);
+  Stats GetStats();
+
+  /// @brief Clears the statistics and frees the buffers of all idle slots
+  void Reset();
+}  // namespace OpenShock::Serialization::BuilderPool
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "radio/Waveform.h"
 #include "ShockerModelType.h"
 #include "ShockerCommandType.h"
 
@@ -14,7 +15,15 @@ namespace OpenShock::Serialization::JsonSerial {
     OpenShock::ShockerCommandType command;
     uint8_t intensity;
     uint16_t durationMs;
+    int64_t executeAtMs;  // Gateway time, 0 to start right away
+  };
+
+  struct ShockerWaveform {
+    OpenShock::ShockerModelType model;
+    uint16_t id;
+    OpenShock::Waveform waveform;
   };
 
   bool ParseShockerCommand(const cJSON* root, ShockerCommand& out);
+  bool ParseShockerWaveform(const cJSON* root, ShockerWaveform& out);
 }  // namespace OpenShock::Serialization::JsonAPI
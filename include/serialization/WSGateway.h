@@ -1,6 +1,7 @@
 #pragma once
 
 #include "FirmwareBootType.h"
+#include "radio/RFQueuePolicy.h"
 #include "SemVer.h"
 #include "serialization/CallbackFn.h"
 
@@ -14,4 +15,6 @@ namespace OpenShock::Serialization::Gateway {
   bool SerializeOtaInstallStartedMessage(int32_t updateId, const OpenShock::SemVer& version, Common::SerializationCallbackFn callback);
   bool SerializeOtaInstallProgressMessage(int32_t updateId, Gateway::OtaInstallProgressTask task, float progress, Common::SerializationCallbackFn callback);
   bool SerializeOtaInstallFailedMessage(int32_t updateId, std::string_view message, bool fatal, Common::SerializationCallbackFn callback);
+  bool SerializeRfQueueStatusMessage(const OpenShock::RFQueueStatus& status, Common::SerializationCallbackFn callback);
+  bool SerializeLatencyReportMessage(Common::SerializationCallbackFn callback);
 }  // namespace OpenShock::Serialization::Gateway
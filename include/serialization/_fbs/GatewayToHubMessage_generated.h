@@ -31,6 +31,18 @@ struct CaptivePortalConfig;
 struct OtaInstall;
 struct OtaInstallBuilder;
 
+struct ShockerGroupMember;
+
+struct ShockerGroupDefine;
+struct ShockerGroupDefineBuilder;
+
+struct ShockerGroupCommand;
+
+struct ShockerWaveform;
+struct ShockerWaveformBuilder;
+
+struct KeepAliveEcho;
+
 struct GatewayToHubMessage;
 struct GatewayToHubMessageBuilder;
 
@@ -39,33 +51,45 @@ enum class GatewayToHubMessagePayload : uint8_t {
   ShockerCommandList = 1,
   CaptivePortalConfig = 2,
   OtaInstall = 3,
+  ShockerGroupDefine = 4,
+  ShockerGroupCommand = 5,
+  ShockerWaveform = 6,
+  KeepAliveEcho = 7,
   MIN = NONE,
-  MAX = OtaInstall
+  MAX = KeepAliveEcho
 };
 
-inline const GatewayToHubMessagePayload (&EnumValuesGatewayToHubMessagePayload())[4] {
+inline const GatewayToHubMessagePayload (&EnumValuesGatewayToHubMessagePayload())[8] {
   static const GatewayToHubMessagePayload values[] = {
     GatewayToHubMessagePayload::NONE,
     GatewayToHubMessagePayload::ShockerCommandList,
     GatewayToHubMessagePayload::CaptivePortalConfig,
-    GatewayToHubMessagePayload::OtaInstall
+    GatewayToHubMessagePayload::OtaInstall,
+    GatewayToHubMessagePayload::ShockerGroupDefine,
+    GatewayToHubMessagePayload::ShockerGroupCommand,
+    GatewayToHubMessagePayload::ShockerWaveform,
+    GatewayToHubMessagePayload::KeepAliveEcho
   };
   return values;
 }
 
 inline const char * const *EnumNamesGatewayToHubMessagePayload() {
-  static const char * const names[5] = {
+  static const char * const names[9] = {
     "NONE",
     "ShockerCommandList",
     "CaptivePortalConfig",
     "OtaInstall",
+    "ShockerGroupDefine",
+    "ShockerGroupCommand",
+    "ShockerWaveform",
+    "KeepAliveEcho",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameGatewayToHubMessagePayload(GatewayToHubMessagePayload e) {
-  if (::flatbuffers::IsOutRange(e, GatewayToHubMessagePayload::NONE, GatewayToHubMessagePayload::OtaInstall)) return "";
+  if (::flatbuffers::IsOutRange(e, GatewayToHubMessagePayload::NONE, GatewayToHubMessagePayload::KeepAliveEcho)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesGatewayToHubMessagePayload()[index];
 }
@@ -86,6 +110,22 @@ template<> struct GatewayToHubMessagePayloadTraits<OpenShock::Serialization::Gat
   static const GatewayToHubMessagePayload enum_value = GatewayToHubMessagePayload::OtaInstall;
 };
 
+template<> struct GatewayToHubMessagePayloadTraits<OpenShock::Serialization::Gateway::ShockerGroupDefine> {
+  static const GatewayToHubMessagePayload enum_value = GatewayToHubMessagePayload::ShockerGroupDefine;
+};
+
+template<> struct GatewayToHubMessagePayloadTraits<OpenShock::Serialization::Gateway::ShockerGroupCommand> {
+  static const GatewayToHubMessagePayload enum_value = GatewayToHubMessagePayload::ShockerGroupCommand;
+};
+
+template<> struct GatewayToHubMessagePayloadTraits<OpenShock::Serialization::Gateway::ShockerWaveform> {
+  static const GatewayToHubMessagePayload enum_value = GatewayToHubMessagePayload::ShockerWaveform;
+};
+
+template<> struct GatewayToHubMessagePayloadTraits<OpenShock::Serialization::Gateway::KeepAliveEcho> {
+  static const GatewayToHubMessagePayload enum_value = GatewayToHubMessagePayload::KeepAliveEcho;
+};
+
 bool VerifyGatewayToHubMessagePayload(::flatbuffers::Verifier &verifier, const void *obj, GatewayToHubMessagePayload type);
 bool VerifyGatewayToHubMessagePayloadVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<GatewayToHubMessagePayload> *types);
 
@@ -168,6 +208,119 @@ struct CaptivePortalConfig::Traits {
   using type = CaptivePortalConfig;
 };
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) ShockerGroupMember FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t model_;
+  int8_t padding0__;
+  uint16_t id_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.ShockerGroupMember";
+  }
+  ShockerGroupMember()
+      : model_(0),
+        padding0__(0),
+        id_(0) {
+    (void)padding0__;
+  }
+  ShockerGroupMember(OpenShock::Serialization::Types::ShockerModelType _model, uint16_t _id)
+      : model_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_model))),
+        padding0__(0),
+        id_(::flatbuffers::EndianScalar(_id)) {
+    (void)padding0__;
+  }
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(::flatbuffers::EndianScalar(model_));
+  }
+  uint16_t id() const {
+    return ::flatbuffers::EndianScalar(id_);
+  }
+};
+FLATBUFFERS_STRUCT_END(ShockerGroupMember, 4);
+
+struct ShockerGroupMember::Traits {
+  using type = ShockerGroupMember;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) ShockerGroupCommand FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint16_t group_;
+  uint8_t type_;
+  uint8_t intensity_;
+  uint16_t duration_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.ShockerGroupCommand";
+  }
+  ShockerGroupCommand()
+      : group_(0),
+        type_(0),
+        intensity_(0),
+        duration_(0) {
+  }
+  ShockerGroupCommand(uint16_t _group, OpenShock::Serialization::Types::ShockerCommandType _type, uint8_t _intensity, uint16_t _duration)
+      : group_(::flatbuffers::EndianScalar(_group)),
+        type_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_type))),
+        intensity_(::flatbuffers::EndianScalar(_intensity)),
+        duration_(::flatbuffers::EndianScalar(_duration)) {
+  }
+  /// Group defined earlier by a ShockerGroupDefine, every member gets the same command
+  uint16_t group() const {
+    return ::flatbuffers::EndianScalar(group_);
+  }
+  OpenShock::Serialization::Types::ShockerCommandType type() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerCommandType>(::flatbuffers::EndianScalar(type_));
+  }
+  uint8_t intensity() const {
+    return ::flatbuffers::EndianScalar(intensity_);
+  }
+  uint16_t duration() const {
+    return ::flatbuffers::EndianScalar(duration_);
+  }
+};
+FLATBUFFERS_STRUCT_END(ShockerGroupCommand, 6);
+
+struct ShockerGroupCommand::Traits {
+  using type = ShockerGroupCommand;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) KeepAliveEcho FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint64_t uptime_;
+  uint64_t gateway_time_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.KeepAliveEcho";
+  }
+  KeepAliveEcho()
+      : uptime_(0),
+        gateway_time_(0) {
+  }
+  KeepAliveEcho(uint64_t _uptime, uint64_t _gateway_time)
+      : uptime_(::flatbuffers::EndianScalar(_uptime)),
+        gateway_time_(::flatbuffers::EndianScalar(_gateway_time)) {
+  }
+  /// Uptime from the keep-alive this answers, unchanged
+  uint64_t uptime() const {
+    return ::flatbuffers::EndianScalar(uptime_);
+  }
+  /// Gateway time in ms when it answered, the clock execute_at on a ShockerCommandList is in
+  uint64_t gateway_time() const {
+    return ::flatbuffers::EndianScalar(gateway_time_);
+  }
+};
+FLATBUFFERS_STRUCT_END(KeepAliveEcho, 16);
+
+struct KeepAliveEcho::Traits {
+  using type = KeepAliveEcho;
+};
+
 struct ShockerCommandList FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef ShockerCommandListBuilder Builder;
   struct Traits;
@@ -175,15 +328,21 @@ struct ShockerCommandList FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
     return "OpenShock.Serialization.Gateway.ShockerCommandList";
   }
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_COMMANDS = 4
+    VT_COMMANDS = 4,
+    VT_EXECUTE_AT = 6
   };
   const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerCommand *> *commands() const {
     return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerCommand *> *>(VT_COMMANDS);
   }
+  /// Gateway time in ms the whole list starts at, 0 starts it right away
+  uint64_t execute_at() const {
+    return GetField<uint64_t>(VT_EXECUTE_AT, 0);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffsetRequired(verifier, VT_COMMANDS) &&
            verifier.VerifyVector(commands()) &&
+           VerifyField<uint64_t>(verifier, VT_EXECUTE_AT, 8) &&
            verifier.EndTable();
   }
 };
@@ -195,6 +354,9 @@ struct ShockerCommandListBuilder {
   void add_commands(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerCommand *>> commands) {
     fbb_.AddOffset(ShockerCommandList::VT_COMMANDS, commands);
   }
+  void add_execute_at(uint64_t execute_at) {
+    fbb_.AddElement<uint64_t>(ShockerCommandList::VT_EXECUTE_AT, execute_at, 0);
+  }
   explicit ShockerCommandListBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -209,8 +371,10 @@ struct ShockerCommandListBuilder {
 
 inline ::flatbuffers::Offset<ShockerCommandList> CreateShockerCommandList(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerCommand *>> commands = 0) {
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerCommand *>> commands = 0,
+    uint64_t execute_at = 0) {
   ShockerCommandListBuilder builder_(_fbb);
+  builder_.add_execute_at(execute_at);
   builder_.add_commands(commands);
   return builder_.Finish();
 }
@@ -222,11 +386,13 @@ struct ShockerCommandList::Traits {
 
 inline ::flatbuffers::Offset<ShockerCommandList> CreateShockerCommandListDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    const std::vector<OpenShock::Serialization::Gateway::ShockerCommand> *commands = nullptr) {
+    const std::vector<OpenShock::Serialization::Gateway::ShockerCommand> *commands = nullptr,
+    uint64_t execute_at = 0) {
   auto commands__ = commands ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Gateway::ShockerCommand>(*commands) : 0;
   return OpenShock::Serialization::Gateway::CreateShockerCommandList(
       _fbb,
-      commands__);
+      commands__,
+      execute_at);
 }
 
 struct OtaInstall FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
@@ -280,6 +446,165 @@ struct OtaInstall::Traits {
   static auto constexpr Create = CreateOtaInstall;
 };
 
+struct ShockerGroupDefine FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ShockerGroupDefineBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.ShockerGroupDefine";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ID = 4,
+    VT_MEMBERS = 6
+  };
+  uint16_t id() const {
+    return GetField<uint16_t>(VT_ID, 0);
+  }
+  /// Replaces the members of the group, no members removes the group
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerGroupMember *> *members() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerGroupMember *> *>(VT_MEMBERS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint16_t>(verifier, VT_ID, 2) &&
+           VerifyOffset(verifier, VT_MEMBERS) &&
+           verifier.VerifyVector(members()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ShockerGroupDefineBuilder {
+  typedef ShockerGroupDefine Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_id(uint16_t id) {
+    fbb_.AddElement<uint16_t>(ShockerGroupDefine::VT_ID, id, 0);
+  }
+  void add_members(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerGroupMember *>> members) {
+    fbb_.AddOffset(ShockerGroupDefine::VT_MEMBERS, members);
+  }
+  explicit ShockerGroupDefineBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ShockerGroupDefine> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ShockerGroupDefine>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ShockerGroupDefine> CreateShockerGroupDefine(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint16_t id = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::ShockerGroupMember *>> members = 0) {
+  ShockerGroupDefineBuilder builder_(_fbb);
+  builder_.add_members(members);
+  builder_.add_id(id);
+  return builder_.Finish();
+}
+
+struct ShockerGroupDefine::Traits {
+  using type = ShockerGroupDefine;
+  static auto constexpr Create = CreateShockerGroupDefine;
+};
+
+inline ::flatbuffers::Offset<ShockerGroupDefine> CreateShockerGroupDefineDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint16_t id = 0,
+    const std::vector<OpenShock::Serialization::Gateway::ShockerGroupMember> *members = nullptr) {
+  auto members__ = members ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Gateway::ShockerGroupMember>(*members) : 0;
+  return OpenShock::Serialization::Gateway::CreateShockerGroupDefine(
+      _fbb,
+      id,
+      members__);
+}
+
+struct ShockerWaveform FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ShockerWaveformBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.ShockerWaveform";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_MODEL = 4,
+    VT_ID = 6,
+    VT_WAVEFORM = 8
+  };
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(GetField<uint8_t>(VT_MODEL, 0));
+  }
+  uint16_t id() const {
+    return GetField<uint16_t>(VT_ID, 0);
+  }
+  /// Compact waveform encoding, played back on the hub (see radio/Waveform.h in the firmware)
+  const ::flatbuffers::Vector<uint8_t> *waveform() const {
+    return GetPointer<const ::flatbuffers::Vector<uint8_t> *>(VT_WAVEFORM);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_MODEL, 1) &&
+           VerifyField<uint16_t>(verifier, VT_ID, 2) &&
+           VerifyOffsetRequired(verifier, VT_WAVEFORM) &&
+           verifier.VerifyVector(waveform()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ShockerWaveformBuilder {
+  typedef ShockerWaveform Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_model(OpenShock::Serialization::Types::ShockerModelType model) {
+    fbb_.AddElement<uint8_t>(ShockerWaveform::VT_MODEL, static_cast<uint8_t>(model), 0);
+  }
+  void add_id(uint16_t id) {
+    fbb_.AddElement<uint16_t>(ShockerWaveform::VT_ID, id, 0);
+  }
+  void add_waveform(::flatbuffers::Offset<::flatbuffers::Vector<uint8_t>> waveform) {
+    fbb_.AddOffset(ShockerWaveform::VT_WAVEFORM, waveform);
+  }
+  explicit ShockerWaveformBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ShockerWaveform> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ShockerWaveform>(end);
+    fbb_.Required(o, ShockerWaveform::VT_WAVEFORM);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ShockerWaveform> CreateShockerWaveform(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    OpenShock::Serialization::Types::ShockerModelType model = OpenShock::Serialization::Types::ShockerModelType::CaiXianlin,
+    uint16_t id = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint8_t>> waveform = 0) {
+  ShockerWaveformBuilder builder_(_fbb);
+  builder_.add_waveform(waveform);
+  builder_.add_id(id);
+  builder_.add_model(model);
+  return builder_.Finish();
+}
+
+struct ShockerWaveform::Traits {
+  using type = ShockerWaveform;
+  static auto constexpr Create = CreateShockerWaveform;
+};
+
+inline ::flatbuffers::Offset<ShockerWaveform> CreateShockerWaveformDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    OpenShock::Serialization::Types::ShockerModelType model = OpenShock::Serialization::Types::ShockerModelType::CaiXianlin,
+    uint16_t id = 0,
+    const std::vector<uint8_t> *waveform = nullptr) {
+  auto waveform__ = waveform ? _fbb.CreateVector<uint8_t>(*waveform) : 0;
+  return OpenShock::Serialization::Gateway::CreateShockerWaveform(
+      _fbb,
+      model,
+      id,
+      waveform__);
+}
+
 struct GatewayToHubMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef GatewayToHubMessageBuilder Builder;
   struct Traits;
@@ -306,6 +631,18 @@ struct GatewayToHubMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Tabl
   const OpenShock::Serialization::Gateway::OtaInstall *payload_as_OtaInstall() const {
     return payload_type() == OpenShock::Serialization::Gateway::GatewayToHubMessagePayload::OtaInstall ? static_cast<const OpenShock::Serialization::Gateway::OtaInstall *>(payload()) : nullptr;
   }
+  const OpenShock::Serialization::Gateway::ShockerGroupDefine *payload_as_ShockerGroupDefine() const {
+    return payload_type() == OpenShock::Serialization::Gateway::GatewayToHubMessagePayload::ShockerGroupDefine ? static_cast<const OpenShock::Serialization::Gateway::ShockerGroupDefine *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Gateway::ShockerGroupCommand *payload_as_ShockerGroupCommand() const {
+    return payload_type() == OpenShock::Serialization::Gateway::GatewayToHubMessagePayload::ShockerGroupCommand ? static_cast<const OpenShock::Serialization::Gateway::ShockerGroupCommand *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Gateway::ShockerWaveform *payload_as_ShockerWaveform() const {
+    return payload_type() == OpenShock::Serialization::Gateway::GatewayToHubMessagePayload::ShockerWaveform ? static_cast<const OpenShock::Serialization::Gateway::ShockerWaveform *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Gateway::KeepAliveEcho *payload_as_KeepAliveEcho() const {
+    return payload_type() == OpenShock::Serialization::Gateway::GatewayToHubMessagePayload::KeepAliveEcho ? static_cast<const OpenShock::Serialization::Gateway::KeepAliveEcho *>(payload()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_PAYLOAD_TYPE, 1) &&
@@ -327,6 +664,22 @@ template<> inline const OpenShock::Serialization::Gateway::OtaInstall *GatewayTo
   return payload_as_OtaInstall();
 }
 
+template<> inline const OpenShock::Serialization::Gateway::ShockerGroupDefine *GatewayToHubMessage::payload_as<OpenShock::Serialization::Gateway::ShockerGroupDefine>() const {
+  return payload_as_ShockerGroupDefine();
+}
+
+template<> inline const OpenShock::Serialization::Gateway::ShockerGroupCommand *GatewayToHubMessage::payload_as<OpenShock::Serialization::Gateway::ShockerGroupCommand>() const {
+  return payload_as_ShockerGroupCommand();
+}
+
+template<> inline const OpenShock::Serialization::Gateway::ShockerWaveform *GatewayToHubMessage::payload_as<OpenShock::Serialization::Gateway::ShockerWaveform>() const {
+  return payload_as_ShockerWaveform();
+}
+
+template<> inline const OpenShock::Serialization::Gateway::KeepAliveEcho *GatewayToHubMessage::payload_as<OpenShock::Serialization::Gateway::KeepAliveEcho>() const {
+  return payload_as_KeepAliveEcho();
+}
+
 struct GatewayToHubMessageBuilder {
   typedef GatewayToHubMessage Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -379,6 +732,20 @@ inline bool VerifyGatewayToHubMessagePayload(::flatbuffers::Verifier &verifier,
       auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::OtaInstall *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case GatewayToHubMessagePayload::ShockerGroupDefine: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::ShockerGroupDefine *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case GatewayToHubMessagePayload::ShockerGroupCommand: {
+      return verifier.VerifyField<OpenShock::Serialization::Gateway::ShockerGroupCommand>(static_cast<const uint8_t *>(obj), 0, 2);
+    }
+    case GatewayToHubMessagePayload::ShockerWaveform: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::ShockerWaveform *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case GatewayToHubMessagePayload::KeepAliveEcho: {
+      return verifier.VerifyField<OpenShock::Serialization::Gateway::KeepAliveEcho>(static_cast<const uint8_t *>(obj), 0, 8);
+    }
     default: return true;
   }
 }
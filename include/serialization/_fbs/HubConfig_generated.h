@@ -13,10 +13,18 @@ static_assert(FLATBUFFERS_VERSION_MAJOR == 24 &&
               FLATBUFFERS_VERSION_REVISION == 25,
              "Non-compatible flatbuffers version included");
 
+#include "ShockerModelType_generated.h"
+
 namespace OpenShock {
 namespace Serialization {
 namespace Configuration {
 
+struct RFRoute;
+
+struct RegisteredShocker;
+
+struct RFRepeatInterval;
+
 struct RFConfig;
 struct RFConfigBuilder;
 
@@ -119,6 +127,143 @@ inline const char *EnumNameOtaUpdateStep(OtaUpdateStep e) {
   return EnumNamesOtaUpdateStep()[index];
 }
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) RFRoute FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t model_;
+  uint8_t transmitter_;
+  uint16_t shocker_id_;
+  uint8_t by_shocker_id_;
+  int8_t padding0__;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Configuration.RFRoute";
+  }
+  RFRoute()
+      : model_(0),
+        transmitter_(0),
+        shocker_id_(0),
+        by_shocker_id_(0),
+        padding0__(0) {
+    (void)padding0__;
+  }
+  RFRoute(OpenShock::Serialization::Types::ShockerModelType _model, uint8_t _transmitter, uint16_t _shocker_id, bool _by_shocker_id)
+      : model_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_model))),
+        transmitter_(::flatbuffers::EndianScalar(_transmitter)),
+        shocker_id_(::flatbuffers::EndianScalar(_shocker_id)),
+        by_shocker_id_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_by_shocker_id))),
+        padding0__(0) {
+    (void)padding0__;
+  }
+  /// The shocker model this route applies to
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(::flatbuffers::EndianScalar(model_));
+  }
+  /// Index of the transmitter to use, 0 is tx_pin, 1 and up are extra_tx_pins
+  uint8_t transmitter() const {
+    return ::flatbuffers::EndianScalar(transmitter_);
+  }
+  /// The shocker this route applies to, only used if by_shocker_id is set
+  uint16_t shocker_id() const {
+    return ::flatbuffers::EndianScalar(shocker_id_);
+  }
+  /// Whether this route only applies to a single shocker, otherwise it applies to every shocker of the model
+  bool by_shocker_id() const {
+    return ::flatbuffers::EndianScalar(by_shocker_id_) != 0;
+  }
+};
+FLATBUFFERS_STRUCT_END(RFRoute, 6);
+
+struct RFRoute::Traits {
+  using type = RFRoute;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) RegisteredShocker FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t model_;
+  int8_t padding0__;
+  uint16_t rf_id_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Configuration.RegisteredShocker";
+  }
+  RegisteredShocker()
+      : model_(0),
+        padding0__(0),
+        rf_id_(0) {
+    (void)padding0__;
+  }
+  RegisteredShocker(OpenShock::Serialization::Types::ShockerModelType _model, uint16_t _rf_id)
+      : model_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_model))),
+        padding0__(0),
+        rf_id_(::flatbuffers::EndianScalar(_rf_id)) {
+    (void)padding0__;
+  }
+  /// The shocker model
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(::flatbuffers::EndianScalar(model_));
+  }
+  /// The id the shocker is paired to
+  uint16_t rf_id() const {
+    return ::flatbuffers::EndianScalar(rf_id_);
+  }
+};
+FLATBUFFERS_STRUCT_END(RegisteredShocker, 4);
+
+struct RegisteredShocker::Traits {
+  using type = RegisteredShocker;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) RFRepeatInterval FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t model_;
+  uint8_t by_shocker_id_;
+  uint16_t shocker_id_;
+  uint16_t interval_ms_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Configuration.RFRepeatInterval";
+  }
+  RFRepeatInterval()
+      : model_(0),
+        by_shocker_id_(0),
+        shocker_id_(0),
+        interval_ms_(0) {
+  }
+  RFRepeatInterval(OpenShock::Serialization::Types::ShockerModelType _model, bool _by_shocker_id, uint16_t _shocker_id, uint16_t _interval_ms)
+      : model_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_model))),
+        by_shocker_id_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_by_shocker_id))),
+        shocker_id_(::flatbuffers::EndianScalar(_shocker_id)),
+        interval_ms_(::flatbuffers::EndianScalar(_interval_ms)) {
+  }
+  /// The shocker model this interval applies to
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(::flatbuffers::EndianScalar(model_));
+  }
+  /// Whether this interval only applies to a single shocker, otherwise it applies to every shocker of the model
+  bool by_shocker_id() const {
+    return ::flatbuffers::EndianScalar(by_shocker_id_) != 0;
+  }
+  /// The shocker this interval applies to, only used if by_shocker_id is set
+  uint16_t shocker_id() const {
+    return ::flatbuffers::EndianScalar(shocker_id_);
+  }
+  /// Minimum time between the start of two frames for the shocker, in milliseconds
+  uint16_t interval_ms() const {
+    return ::flatbuffers::EndianScalar(interval_ms_);
+  }
+};
+FLATBUFFERS_STRUCT_END(RFRepeatInterval, 6);
+
+struct RFRepeatInterval::Traits {
+  using type = RFRepeatInterval;
+};
+
 struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef RFConfigBuilder Builder;
   struct Traits;
@@ -127,7 +272,12 @@ struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   }
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_TX_PIN = 4,
-    VT_KEEPALIVE_ENABLED = 6
+    VT_KEEPALIVE_ENABLED = 6,
+    VT_EXTRA_TX_PINS = 8,
+    VT_ROUTES = 10,
+    VT_QUEUE_POLICY = 12,
+    VT_SHOCKERS = 14,
+    VT_REPEAT_INTERVALS = 16
   };
   /// The GPIO pin connected to the RF modulator's data pin for transmitting (TX)
   int8_t tx_pin() const {
@@ -137,10 +287,39 @@ struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   bool keepalive_enabled() const {
     return GetField<uint8_t>(VT_KEEPALIVE_ENABLED, 0) != 0;
   }
+  /// GPIO pins of additional RF modulators, each one gets its own transmitter
+  const ::flatbuffers::Vector<int8_t> *extra_tx_pins() const {
+    return GetPointer<const ::flatbuffers::Vector<int8_t> *>(VT_EXTRA_TX_PINS);
+  }
+  /// Which transmitter to use for a shocker or shocker model, shockers without a route use the first transmitter
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRoute *> *routes() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRoute *> *>(VT_ROUTES);
+  }
+  /// What a transmitter does when its command queue is full, 0 drops the oldest queued commands, 1 rejects new ones
+  uint8_t queue_policy() const {
+    return GetField<uint8_t>(VT_QUEUE_POLICY, 0);
+  }
+  /// Shockers registered to this hub on the backend, kept so they can be served before the gateway connects
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RegisteredShocker *> *shockers() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RegisteredShocker *> *>(VT_SHOCKERS);
+  }
+  /// Minimum repeat interval for a shocker or shocker model, shockers without one are repeated as often as the channel allows
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRepeatInterval *> *repeat_intervals() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRepeatInterval *> *>(VT_REPEAT_INTERVALS);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<int8_t>(verifier, VT_TX_PIN, 1) &&
            VerifyField<uint8_t>(verifier, VT_KEEPALIVE_ENABLED, 1) &&
+           VerifyOffset(verifier, VT_EXTRA_TX_PINS) &&
+           verifier.VerifyVector(extra_tx_pins()) &&
+           VerifyOffset(verifier, VT_ROUTES) &&
+           verifier.VerifyVector(routes()) &&
+           VerifyField<uint8_t>(verifier, VT_QUEUE_POLICY, 1) &&
+           VerifyOffset(verifier, VT_SHOCKERS) &&
+           verifier.VerifyVector(shockers()) &&
+           VerifyOffset(verifier, VT_REPEAT_INTERVALS) &&
+           verifier.VerifyVector(repeat_intervals()) &&
            verifier.EndTable();
   }
 };
@@ -155,6 +334,21 @@ struct RFConfigBuilder {
   void add_keepalive_enabled(bool keepalive_enabled) {
     fbb_.AddElement<uint8_t>(RFConfig::VT_KEEPALIVE_ENABLED, static_cast<uint8_t>(keepalive_enabled), 0);
   }
+  void add_extra_tx_pins(::flatbuffers::Offset<::flatbuffers::Vector<int8_t>> extra_tx_pins) {
+    fbb_.AddOffset(RFConfig::VT_EXTRA_TX_PINS, extra_tx_pins);
+  }
+  void add_routes(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRoute *>> routes) {
+    fbb_.AddOffset(RFConfig::VT_ROUTES, routes);
+  }
+  void add_queue_policy(uint8_t queue_policy) {
+    fbb_.AddElement<uint8_t>(RFConfig::VT_QUEUE_POLICY, queue_policy, 0);
+  }
+  void add_shockers(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RegisteredShocker *>> shockers) {
+    fbb_.AddOffset(RFConfig::VT_SHOCKERS, shockers);
+  }
+  void add_repeat_intervals(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRepeatInterval *>> repeat_intervals) {
+    fbb_.AddOffset(RFConfig::VT_REPEAT_INTERVALS, repeat_intervals);
+  }
   explicit RFConfigBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -169,8 +363,18 @@ struct RFConfigBuilder {
 inline ::flatbuffers::Offset<RFConfig> CreateRFConfig(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     int8_t tx_pin = 0,
-    bool keepalive_enabled = false) {
+    bool keepalive_enabled = false,
+    ::flatbuffers::Offset<::flatbuffers::Vector<int8_t>> extra_tx_pins = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRoute *>> routes = 0,
+    uint8_t queue_policy = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RegisteredShocker *>> shockers = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Configuration::RFRepeatInterval *>> repeat_intervals = 0) {
   RFConfigBuilder builder_(_fbb);
+  builder_.add_repeat_intervals(repeat_intervals);
+  builder_.add_shockers(shockers);
+  builder_.add_routes(routes);
+  builder_.add_extra_tx_pins(extra_tx_pins);
+  builder_.add_queue_policy(queue_policy);
   builder_.add_keepalive_enabled(keepalive_enabled);
   builder_.add_tx_pin(tx_pin);
   return builder_.Finish();
@@ -181,6 +385,30 @@ struct RFConfig::Traits {
   static auto constexpr Create = CreateRFConfig;
 };
 
+inline ::flatbuffers::Offset<RFConfig> CreateRFConfigDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int8_t tx_pin = 0,
+    bool keepalive_enabled = false,
+    const std::vector<int8_t> *extra_tx_pins = nullptr,
+    const std::vector<OpenShock::Serialization::Configuration::RFRoute> *routes = nullptr,
+    uint8_t queue_policy = 0,
+    const std::vector<OpenShock::Serialization::Configuration::RegisteredShocker> *shockers = nullptr,
+    const std::vector<OpenShock::Serialization::Configuration::RFRepeatInterval> *repeat_intervals = nullptr) {
+  auto extra_tx_pins__ = extra_tx_pins ? _fbb.CreateVector<int8_t>(*extra_tx_pins) : 0;
+  auto routes__ = routes ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Configuration::RFRoute>(*routes) : 0;
+  auto shockers__ = shockers ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Configuration::RegisteredShocker>(*shockers) : 0;
+  auto repeat_intervals__ = repeat_intervals ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Configuration::RFRepeatInterval>(*repeat_intervals) : 0;
+  return OpenShock::Serialization::Configuration::CreateRFConfig(
+      _fbb,
+      tx_pin,
+      keepalive_enabled,
+      extra_tx_pins__,
+      routes__,
+      queue_policy,
+      shockers__,
+      repeat_intervals__);
+}
+
 struct EStopConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef EStopConfigBuilder Builder;
   struct Traits;
@@ -484,7 +712,8 @@ struct BackendConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_DOMAIN = 4,
     VT_AUTH_TOKEN = 6,
-    VT_LCG_OVERRIDE = 8
+    VT_LCG_OVERRIDE = 8,
+    VT_LCG_CACHE = 10
   };
   /// Domain name of the backend server, e.g. "api.shocklink.net"
   const ::flatbuffers::String *domain() const {
@@ -498,6 +727,10 @@ struct BackendConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const ::flatbuffers::String *lcg_override() const {
     return GetPointer<const ::flatbuffers::String *>(VT_LCG_OVERRIDE);
   }
+  /// Live-Control-Gateway (LCG) the backend assigned last, reused on reconnect until it fails
+  const ::flatbuffers::String *lcg_cache() const {
+    return GetPointer<const ::flatbuffers::String *>(VT_LCG_CACHE);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_DOMAIN) &&
@@ -506,6 +739,8 @@ struct BackendConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            verifier.VerifyString(auth_token()) &&
            VerifyOffset(verifier, VT_LCG_OVERRIDE) &&
            verifier.VerifyString(lcg_override()) &&
+           VerifyOffset(verifier, VT_LCG_CACHE) &&
+           verifier.VerifyString(lcg_cache()) &&
            verifier.EndTable();
   }
 };
@@ -523,6 +758,9 @@ struct BackendConfigBuilder {
   void add_lcg_override(::flatbuffers::Offset<::flatbuffers::String> lcg_override) {
     fbb_.AddOffset(BackendConfig::VT_LCG_OVERRIDE, lcg_override);
   }
+  void add_lcg_cache(::flatbuffers::Offset<::flatbuffers::String> lcg_cache) {
+    fbb_.AddOffset(BackendConfig::VT_LCG_CACHE, lcg_cache);
+  }
   explicit BackendConfigBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -538,8 +776,10 @@ inline ::flatbuffers::Offset<BackendConfig> CreateBackendConfig(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     ::flatbuffers::Offset<::flatbuffers::String> domain = 0,
     ::flatbuffers::Offset<::flatbuffers::String> auth_token = 0,
-    ::flatbuffers::Offset<::flatbuffers::String> lcg_override = 0) {
+    ::flatbuffers::Offset<::flatbuffers::String> lcg_override = 0,
+    ::flatbuffers::Offset<::flatbuffers::String> lcg_cache = 0) {
   BackendConfigBuilder builder_(_fbb);
+  builder_.add_lcg_cache(lcg_cache);
   builder_.add_lcg_override(lcg_override);
   builder_.add_auth_token(auth_token);
   builder_.add_domain(domain);
@@ -555,15 +795,18 @@ inline ::flatbuffers::Offset<BackendConfig> CreateBackendConfigDirect(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     const char *domain = nullptr,
     const char *auth_token = nullptr,
-    const char *lcg_override = nullptr) {
+    const char *lcg_override = nullptr,
+    const char *lcg_cache = nullptr) {
   auto domain__ = domain ? _fbb.CreateString(domain) : 0;
   auto auth_token__ = auth_token ? _fbb.CreateString(auth_token) : 0;
   auto lcg_override__ = lcg_override ? _fbb.CreateString(lcg_override) : 0;
+  auto lcg_cache__ = lcg_cache ? _fbb.CreateString(lcg_cache) : 0;
   return OpenShock::Serialization::Configuration::CreateBackendConfig(
       _fbb,
       domain__,
       auth_token__,
-      lcg_override__);
+      lcg_override__,
+      lcg_cache__);
 }
 
 struct SerialInputConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
@@ -34,6 +34,14 @@ struct OtaInstallProgressBuilder;
 struct OtaInstallFailed;
 struct OtaInstallFailedBuilder;
 
+struct RfQueueStatus;
+struct RfQueueStatusBuilder;
+
+struct LatencyStageStats;
+
+struct LatencyReport;
+struct LatencyReportBuilder;
+
 struct HubToGatewayMessage;
 struct HubToGatewayMessageBuilder;
 
@@ -89,37 +97,43 @@ enum class HubToGatewayMessagePayload : uint8_t {
   OtaInstallStarted = 3,
   OtaInstallProgress = 4,
   OtaInstallFailed = 5,
+  RfQueueStatus = 6,
+  LatencyReport = 7,
   MIN = NONE,
-  MAX = OtaInstallFailed
+  MAX = LatencyReport
 };
 
-inline const HubToGatewayMessagePayload (&EnumValuesHubToGatewayMessagePayload())[6] {
+inline const HubToGatewayMessagePayload (&EnumValuesHubToGatewayMessagePayload())[8] {
   static const HubToGatewayMessagePayload values[] = {
     HubToGatewayMessagePayload::NONE,
     HubToGatewayMessagePayload::KeepAlive,
     HubToGatewayMessagePayload::BootStatus,
     HubToGatewayMessagePayload::OtaInstallStarted,
     HubToGatewayMessagePayload::OtaInstallProgress,
-    HubToGatewayMessagePayload::OtaInstallFailed
+    HubToGatewayMessagePayload::OtaInstallFailed,
+    HubToGatewayMessagePayload::RfQueueStatus,
+    HubToGatewayMessagePayload::LatencyReport
   };
   return values;
 }
 
 inline const char * const *EnumNamesHubToGatewayMessagePayload() {
-  static const char * const names[7] = {
+  static const char * const names[9] = {
     "NONE",
     "KeepAlive",
     "BootStatus",
     "OtaInstallStarted",
     "OtaInstallProgress",
     "OtaInstallFailed",
+    "RfQueueStatus",
+    "LatencyReport",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameHubToGatewayMessagePayload(HubToGatewayMessagePayload e) {
-  if (::flatbuffers::IsOutRange(e, HubToGatewayMessagePayload::NONE, HubToGatewayMessagePayload::OtaInstallFailed)) return "";
+  if (::flatbuffers::IsOutRange(e, HubToGatewayMessagePayload::NONE, HubToGatewayMessagePayload::LatencyReport)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesHubToGatewayMessagePayload()[index];
 }
@@ -148,6 +162,14 @@ template<> struct HubToGatewayMessagePayloadTraits<OpenShock::Serialization::Gat
   static const HubToGatewayMessagePayload enum_value = HubToGatewayMessagePayload::OtaInstallFailed;
 };
 
+template<> struct HubToGatewayMessagePayloadTraits<OpenShock::Serialization::Gateway::RfQueueStatus> {
+  static const HubToGatewayMessagePayload enum_value = HubToGatewayMessagePayload::RfQueueStatus;
+};
+
+template<> struct HubToGatewayMessagePayloadTraits<OpenShock::Serialization::Gateway::LatencyReport> {
+  static const HubToGatewayMessagePayload enum_value = HubToGatewayMessagePayload::LatencyReport;
+};
+
 bool VerifyHubToGatewayMessagePayload(::flatbuffers::Verifier &verifier, const void *obj, HubToGatewayMessagePayload type);
 bool VerifyHubToGatewayMessagePayloadVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<HubToGatewayMessagePayload> *types);
 
@@ -176,6 +198,61 @@ struct KeepAlive::Traits {
   using type = KeepAlive;
 };
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) LatencyStageStats FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t stage_;
+  int8_t padding0__;
+  int16_t padding1__;
+  uint32_t count_;
+  uint32_t sum_us_;
+  uint32_t max_us_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.LatencyStageStats";
+  }
+  LatencyStageStats()
+      : stage_(0),
+        padding0__(0),
+        padding1__(0),
+        count_(0),
+        sum_us_(0),
+        max_us_(0) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  LatencyStageStats(uint8_t _stage, uint32_t _count, uint32_t _sum_us, uint32_t _max_us)
+      : stage_(::flatbuffers::EndianScalar(_stage)),
+        padding0__(0),
+        padding1__(0),
+        count_(::flatbuffers::EndianScalar(_count)),
+        sum_us_(::flatbuffers::EndianScalar(_sum_us)),
+        max_us_(::flatbuffers::EndianScalar(_max_us)) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  /// Verify, Dispatch, Enqueue, Dequeue, Emit, Total (WebSocket frame received -> first RF frame on air)
+  uint8_t stage() const {
+    return ::flatbuffers::EndianScalar(stage_);
+  }
+  /// Counters since boot, they wrap, the gateway diffs consecutive reports
+  uint32_t count() const {
+    return ::flatbuffers::EndianScalar(count_);
+  }
+  uint32_t sum_us() const {
+    return ::flatbuffers::EndianScalar(sum_us_);
+  }
+  uint32_t max_us() const {
+    return ::flatbuffers::EndianScalar(max_us_);
+  }
+};
+FLATBUFFERS_STRUCT_END(LatencyStageStats, 16);
+
+struct LatencyStageStats::Traits {
+  using type = LatencyStageStats;
+};
+
 struct BootStatus FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef BootStatusBuilder Builder;
   struct Traits;
@@ -462,6 +539,197 @@ inline ::flatbuffers::Offset<OtaInstallFailed> CreateOtaInstallFailedDirect(
       fatal);
 }
 
+/// Command queue fill and admission counters of one RF transmitter, the counters wrap
+struct RfQueueStatus FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef RfQueueStatusBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.RfQueueStatus";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TRANSMITTER = 4,
+    VT_QUEUE_DEPTH = 6,
+    VT_QUEUE_CAPACITY = 8,
+    VT_REJECT_NEW = 10,
+    VT_REJECTED = 12,
+    VT_DROPPED = 14,
+    VT_COALESCED = 16
+  };
+  uint8_t transmitter() const {
+    return GetField<uint8_t>(VT_TRANSMITTER, 0);
+  }
+  /// Command batches waiting for the transmit task
+  uint8_t queue_depth() const {
+    return GetField<uint8_t>(VT_QUEUE_DEPTH, 0);
+  }
+  uint8_t queue_capacity() const {
+    return GetField<uint8_t>(VT_QUEUE_CAPACITY, 0);
+  }
+  /// Whether a full queue rejects new commands, otherwise the oldest queued commands are dropped
+  bool reject_new() const {
+    return GetField<uint8_t>(VT_REJECT_NEW, 0) != 0;
+  }
+  /// Commands and stops refused because their queue was full
+  uint32_t rejected() const {
+    return GetField<uint32_t>(VT_REJECTED, 0);
+  }
+  /// Queued commands dropped to make room for newer ones
+  uint32_t dropped() const {
+    return GetField<uint32_t>(VT_DROPPED, 0);
+  }
+  /// Queued commands replaced by a newer command for the same shocker before they were sent
+  uint32_t coalesced() const {
+    return GetField<uint32_t>(VT_COALESCED, 0);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_TRANSMITTER, 1) &&
+           VerifyField<uint8_t>(verifier, VT_QUEUE_DEPTH, 1) &&
+           VerifyField<uint8_t>(verifier, VT_QUEUE_CAPACITY, 1) &&
+           VerifyField<uint8_t>(verifier, VT_REJECT_NEW, 1) &&
+           VerifyField<uint32_t>(verifier, VT_REJECTED, 4) &&
+           VerifyField<uint32_t>(verifier, VT_DROPPED, 4) &&
+           VerifyField<uint32_t>(verifier, VT_COALESCED, 4) &&
+           verifier.EndTable();
+  }
+};
+
+struct RfQueueStatusBuilder {
+  typedef RfQueueStatus Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_transmitter(uint8_t transmitter) {
+    fbb_.AddElement<uint8_t>(RfQueueStatus::VT_TRANSMITTER, transmitter, 0);
+  }
+  void add_queue_depth(uint8_t queue_depth) {
+    fbb_.AddElement<uint8_t>(RfQueueStatus::VT_QUEUE_DEPTH, queue_depth, 0);
+  }
+  void add_queue_capacity(uint8_t queue_capacity) {
+    fbb_.AddElement<uint8_t>(RfQueueStatus::VT_QUEUE_CAPACITY, queue_capacity, 0);
+  }
+  void add_reject_new(bool reject_new) {
+    fbb_.AddElement<uint8_t>(RfQueueStatus::VT_REJECT_NEW, static_cast<uint8_t>(reject_new), 0);
+  }
+  void add_rejected(uint32_t rejected) {
+    fbb_.AddElement<uint32_t>(RfQueueStatus::VT_REJECTED, rejected, 0);
+  }
+  void add_dropped(uint32_t dropped) {
+    fbb_.AddElement<uint32_t>(RfQueueStatus::VT_DROPPED, dropped, 0);
+  }
+  void add_coalesced(uint32_t coalesced) {
+    fbb_.AddElement<uint32_t>(RfQueueStatus::VT_COALESCED, coalesced, 0);
+  }
+  explicit RfQueueStatusBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<RfQueueStatus> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<RfQueueStatus>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<RfQueueStatus> CreateRfQueueStatus(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint8_t transmitter = 0,
+    uint8_t queue_depth = 0,
+    uint8_t queue_capacity = 0,
+    bool reject_new = false,
+    uint32_t rejected = 0,
+    uint32_t dropped = 0,
+    uint32_t coalesced = 0) {
+  RfQueueStatusBuilder builder_(_fbb);
+  builder_.add_coalesced(coalesced);
+  builder_.add_dropped(dropped);
+  builder_.add_rejected(rejected);
+  builder_.add_reject_new(reject_new);
+  builder_.add_queue_capacity(queue_capacity);
+  builder_.add_queue_depth(queue_depth);
+  builder_.add_transmitter(transmitter);
+  return builder_.Finish();
+}
+
+struct RfQueueStatus::Traits {
+  using type = RfQueueStatus;
+  static auto constexpr Create = CreateRfQueueStatus;
+};
+
+struct LatencyReport FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef LatencyReportBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Gateway.LatencyReport";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_STAGES = 4,
+    VT_BUCKETS = 6
+  };
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::LatencyStageStats *> *stages() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Gateway::LatencyStageStats *> *>(VT_STAGES);
+  }
+  /// Histogram counts of every stage in the order of stages, the same number per stage, bucket i holds latencies up to 128 us << i and the last one everything above
+  const ::flatbuffers::Vector<uint32_t> *buckets() const {
+    return GetPointer<const ::flatbuffers::Vector<uint32_t> *>(VT_BUCKETS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_STAGES) &&
+           verifier.VerifyVector(stages()) &&
+           VerifyOffset(verifier, VT_BUCKETS) &&
+           verifier.VerifyVector(buckets()) &&
+           verifier.EndTable();
+  }
+};
+
+struct LatencyReportBuilder {
+  typedef LatencyReport Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_stages(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::LatencyStageStats *>> stages) {
+    fbb_.AddOffset(LatencyReport::VT_STAGES, stages);
+  }
+  void add_buckets(::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> buckets) {
+    fbb_.AddOffset(LatencyReport::VT_BUCKETS, buckets);
+  }
+  explicit LatencyReportBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<LatencyReport> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<LatencyReport>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<LatencyReport> CreateLatencyReport(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Gateway::LatencyStageStats *>> stages = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint32_t>> buckets = 0) {
+  LatencyReportBuilder builder_(_fbb);
+  builder_.add_buckets(buckets);
+  builder_.add_stages(stages);
+  return builder_.Finish();
+}
+
+struct LatencyReport::Traits {
+  using type = LatencyReport;
+  static auto constexpr Create = CreateLatencyReport;
+};
+
+inline ::flatbuffers::Offset<LatencyReport> CreateLatencyReportDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<OpenShock::Serialization::Gateway::LatencyStageStats> *stages = nullptr,
+    const std::vector<uint32_t> *buckets = nullptr) {
+  auto stages__ = stages ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Gateway::LatencyStageStats>(*stages) : 0;
+  auto buckets__ = buckets ? _fbb.CreateVector<uint32_t>(*buckets) : 0;
+  return OpenShock::Serialization::Gateway::CreateLatencyReport(
+      _fbb,
+      stages__,
+      buckets__);
+}
+
 struct HubToGatewayMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef HubToGatewayMessageBuilder Builder;
   struct Traits;
@@ -494,6 +762,12 @@ struct HubToGatewayMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Tabl
   const OpenShock::Serialization::Gateway::OtaInstallFailed *payload_as_OtaInstallFailed() const {
     return payload_type() == OpenShock::Serialization::Gateway::HubToGatewayMessagePayload::OtaInstallFailed ? static_cast<const OpenShock::Serialization::Gateway::OtaInstallFailed *>(payload()) : nullptr;
   }
+  const OpenShock::Serialization::Gateway::RfQueueStatus *payload_as_RfQueueStatus() const {
+    return payload_type() == OpenShock::Serialization::Gateway::HubToGatewayMessagePayload::RfQueueStatus ? static_cast<const OpenShock::Serialization::Gateway::RfQueueStatus *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Gateway::LatencyReport *payload_as_LatencyReport() const {
+    return payload_type() == OpenShock::Serialization::Gateway::HubToGatewayMessagePayload::LatencyReport ? static_cast<const OpenShock::Serialization::Gateway::LatencyReport *>(payload()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_PAYLOAD_TYPE, 1) &&
@@ -523,6 +797,14 @@ template<> inline const OpenShock::Serialization::Gateway::OtaInstallFailed *Hub
   return payload_as_OtaInstallFailed();
 }
 
+template<> inline const OpenShock::Serialization::Gateway::RfQueueStatus *HubToGatewayMessage::payload_as<OpenShock::Serialization::Gateway::RfQueueStatus>() const {
+  return payload_as_RfQueueStatus();
+}
+
+template<> inline const OpenShock::Serialization::Gateway::LatencyReport *HubToGatewayMessage::payload_as<OpenShock::Serialization::Gateway::LatencyReport>() const {
+  return payload_as_LatencyReport();
+}
+
 struct HubToGatewayMessageBuilder {
   typedef HubToGatewayMessage Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -583,6 +865,14 @@ inline bool VerifyHubToGatewayMessagePayload(::flatbuffers::Verifier &verifier,
       auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::OtaInstallFailed *>(obj);
       return verifier.VerifyTable(ptr);
     }
+    case HubToGatewayMessagePayload::RfQueueStatus: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::RfQueueStatus *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case HubToGatewayMessagePayload::LatencyReport: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Gateway::LatencyReport *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }
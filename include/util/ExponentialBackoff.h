@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace OpenShock::Util {
+  /// @brief Retry delays that double with every failed attempt up to a cap, with jitter so hubs that lost the same gateway don't come back in lockstep
+  ///
+  /// Half of each delay is fixed and half is random, so the delays still grow reliably while the retries of many hubs spread out.
+  class ExponentialBackoff {
+  public:
+    constexpr ExponentialBackoff(uint32_t baseMs, uint32_t maxMs)
+      : m_baseMs(baseMs)
+      , m_maxMs(maxMs)
+      , m_failures(0)
+    {
+    }
+
+    constexpr uint32_t failures() const { return m_failures; }
+
+    /// @brief Upper bound of the next delay without jitter
+    constexpr uint32_t ceilingMs() const
+    {
+      uint32_t ceiling = m_baseMs;
+      for (uint32_t i = 0; i < m_failures && ceiling < m_maxMs; ++i) {
+        ceiling *= 2;
+      }
+
+      return std::min(ceiling, m_maxMs);
+    }
+
+    /// @brief Records a failed attempt and returns how long to wait before the next one, random is any uniformly distributed value
+    uint32_t Fail(uint32_t random)
+    {
+      uint32_t ceiling = ceilingMs();
+      uint32_t half    = ceiling / 2;
+
+      if (m_failures < UINT32_MAX) {
+        ++m_failures;
+      }
+
+      return (ceiling - half) + random % (half + 1);
+    }
+
+    /// @brief Call after a successful attempt, the next failure starts over at the base delay
+    void Reset() { m_failures = 0; }
+
+  private:
+    uint32_t m_baseMs;
+    uint32_t m_maxMs;
+    uint32_t m_failures;
+  };
+}  // namespace OpenShock::Util
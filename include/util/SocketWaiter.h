@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Common.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenShock::Util {
+  /// @brief Blocks a task until one of its sockets has data, another task wakes it, or a timeout passes, so network loops don't have to poll on a fixed interval
+  /// @note lwIP select can't wait on a task notification, so Wake sends a byte to a loopback UDP socket that is part of every select, like esp_http_server's control socket
+  class SocketWaiter {
+    DISABLE_COPY(SocketWaiter);
+    DISABLE_MOVE(SocketWaiter);
+
+  public:
+    SocketWaiter();
+    ~SocketWaiter();
+
+    /// @brief Creates the wake socket, needs the network stack to be up, without it Wait still works but only wakes for sockets and timeouts
+    bool Init();
+
+    /// @brief Whether the wake socket is set up, callers that rely on Wake should fall back to polling without it
+    inline bool ok() const { return m_wakeFd >= 0; }
+
+    /// @brief Makes the current or the next Wait return early, safe to call from any task
+    void Wake();
+
+    /// @brief Blocks until one of the sockets is readable, Wake is called, or timeoutMs passes, negative file descriptors are ignored
+    /// @return True if it returned early, false on timeout
+    bool Wait(const int* fds, std::size_t count, uint32_t timeoutMs);
+
+  private:
+    int m_wakeFd;
+    std::atomic<bool> m_wakePending;  // A wake byte is in flight, further wakes don't need another one
+  };
+}  // namespace OpenShock::Util
@@ -19,13 +19,17 @@ const char* const TAG = "CaptivePortalInstance";
 
 #include <WiFi.h>
 
-const uint16_t HTTP_PORT                 = 80;
-const uint16_t WEBSOCKET_PORT            = 81;
-const uint16_t DNS_PORT                  = 53;
-const uint32_t WEBSOCKET_PING_INTERVAL   = 10'000;
-const uint32_t WEBSOCKET_PING_TIMEOUT    = 1000;
-const uint8_t WEBSOCKET_PING_RETRIES     = 3;
-const uint32_t WEBSOCKET_UPDATE_INTERVAL = 10;  // 10ms / 100Hz
+#include <array>
+
+const uint16_t HTTP_PORT                        = 80;
+const uint16_t WEBSOCKET_PORT                   = 81;
+const uint16_t DNS_PORT                         = 53;
+const uint32_t WEBSOCKET_PING_INTERVAL          = 10'000;
+const uint32_t WEBSOCKET_PING_TIMEOUT           = 1000;
+const uint8_t WEBSOCKET_PING_RETRIES            = 3;
+const uint32_t WEBSOCKET_POLL_INTERVAL          = 100;   // WiFiServer hides its listening socket, new connections and heartbeats are still polled, client data wakes the task right away
+const uint32_t WEBSOCKET_FALLBACK_POLL_INTERVAL = 10;    // Without a wake socket, client data and stop requests are polled at the old 100Hz
+const uint32_t TASK_STOP_TIMEOUT_MS             = 1000;
 
 using namespace OpenShock;
 
@@ -63,6 +67,9 @@ CaptivePortalInstance::CaptivePortalInstance()
   , m_socketDeFragger(std::bind(&CaptivePortalInstance::handleWebSocketEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4))
   , m_fileSystem()
   , m_dnsServer()
+  , m_waiter()
+  , m_stopRequested(false)
+  , m_taskStopped(false)
   , m_taskHandle(nullptr) {
   m_socketServer.onEvent(std::bind(&WebSocketDeFragger::handler, &m_socketDeFragger, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
   m_socketServer.begin();
@@ -123,6 +130,10 @@ discord.gg/OpenShock
 
   m_webServer.begin();
 
+  if (!m_waiter.Init()) {
+    OS_LOGE(TAG, "Failed to set up wake socket, polling every %u ms instead", WEBSOCKET_FALLBACK_POLL_INTERVAL);
+  }
+
   if (fsOk) {
     if (TaskUtils::TaskCreateExpensive(&Util::FnProxy<&CaptivePortalInstance::task>, TAG, 8192, this, 1, &m_taskHandle) != pdPASS) {  // PROFILED: 4-6KB stack usage
       OS_LOGE(TAG, "Failed to create task");
@@ -132,7 +143,19 @@ discord.gg/OpenShock
 
 CaptivePortalInstance::~CaptivePortalInstance() {
   if (m_taskHandle != nullptr) {
-    vTaskDelete(m_taskHandle);
+    // Deleting the task while it sits in lwIP select would leave lwIP pointing into its stack, so it is asked to exit instead
+    m_stopRequested = true;
+    m_waiter.Wake();
+
+    for (uint32_t waited = 0; !m_taskStopped && waited < TASK_STOP_TIMEOUT_MS; waited += 10) {
+      vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    if (!m_taskStopped) {
+      OS_LOGE(TAG, "Task did not stop in time, deleting it");
+      vTaskDelete(m_taskHandle);
+    }
+
     m_taskHandle = nullptr;
   }
   m_webServer.end();
@@ -142,11 +165,49 @@ CaptivePortalInstance::~CaptivePortalInstance() {
 }
 
 void CaptivePortalInstance::task() {
-  while (true) {
+  std::array<int, WEBSOCKETS_SERVER_CLIENT_MAX> fds;
+
+  while (!m_stopRequested) {
     m_socketServer.loop();
     // instance->m_dnsServer.processNextRequest();
-    vTaskDelay(pdMS_TO_TICKS(WEBSOCKET_UPDATE_INTERVAL));
+
+    // Already read off the socket, it won't signal it again
+    if (m_socketServer.hasBufferedData()) {
+      continue;
+    }
+
+    if (!m_waiter.ok()) {
+      vTaskDelay(pdMS_TO_TICKS(WEBSOCKET_FALLBACK_POLL_INTERVAL));
+      continue;
+    }
+
+    std::size_t count = m_socketServer.clientFds(fds.data(), fds.size());
+    m_waiter.Wait(fds.data(), count, WEBSOCKET_POLL_INTERVAL);
+  }
+
+  m_taskStopped = true;  // The instance may be gone from here on
+  vTaskDelete(nullptr);
+}
+
+std::size_t CaptivePortalInstance::SocketServer::clientFds(int* fds, std::size_t maxFds) {
+  std::size_t count = 0;
+  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX && count < maxFds; ++i) {
+    if (_clients[i].tcp != nullptr) {
+      fds[count++] = _clients[i].tcp->fd();
+    }
   }
+
+  return count;
+}
+
+bool CaptivePortalInstance::SocketServer::hasBufferedData() {
+  for (uint8_t i = 0; i < WEBSOCKETS_SERVER_CLIENT_MAX; ++i) {
+    if (_clients[i].tcp != nullptr && _clients[i].tcp->available() > 0) {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 void CaptivePortalInstance::handleWebSocketClientConnected(uint8_t socketId) {
@@ -0,0 +1,99 @@
+#include "ClockSync.h"
+
+#include "SimpleMutex.h"
+
+#include <array>
+
+using namespace OpenShock;
+
+namespace {
+  struct Sample {
+    int64_t offsetMs;
+    int64_t rttMs;
+    int64_t sampledAt;
+  };
+}  // namespace
+
+static OpenShock::SimpleMutex s_clockMutex                   = {};
+static std::array<Sample, ClockSync::kSampleCount> s_samples = {};
+static std::size_t s_sampleCount                             = 0;
+static std::size_t s_nextSample                              = 0;
+
+bool ClockSync::AddSample(int64_t sentAt, int64_t gatewayTime, int64_t receivedAt)
+{
+  if (receivedAt < sentAt || gatewayTime <= 0) {
+    return false;
+  }
+
+  int64_t rttMs = receivedAt - sentAt;
+
+  Sample sample = {
+    .offsetMs  = gatewayTime - (sentAt + rttMs / 2),
+    .rttMs     = rttMs,
+    .sampledAt = receivedAt,
+  };
+
+  ScopedLock lock__(&s_clockMutex);
+
+  s_samples[s_nextSample] = sample;
+  s_nextSample            = (s_nextSample + 1) % s_samples.size();
+  if (s_sampleCount < s_samples.size()) {
+    ++s_sampleCount;
+  }
+
+  return true;
+}
+
+bool ClockSync::GetEstimate(int64_t now, Estimate& out)
+{
+  ScopedLock lock__(&s_clockMutex);
+
+  const Sample* best = nullptr;
+  uint8_t count      = 0;
+  for (std::size_t i = 0; i < s_sampleCount; ++i) {
+    const Sample& sample = s_samples[i];
+    if (now - sample.sampledAt > kMaxSampleAgeMs) {
+      continue;
+    }
+
+    ++count;
+
+    // Shortest round trip wins, the newer one on ties since it has drifted less
+    if (best == nullptr || sample.rttMs < best->rttMs || (sample.rttMs == best->rttMs && sample.sampledAt > best->sampledAt)) {
+      best = &sample;
+    }
+  }
+
+  if (best == nullptr) {
+    return false;
+  }
+
+  out = Estimate {
+    .offsetMs    = best->offsetMs,
+    .rttMs       = best->rttMs,
+    .sampledAt   = best->sampledAt,
+    .sampleCount = count,
+  };
+
+  return true;
+}
+
+bool ClockSync::ToLocalTime(int64_t gatewayTime, int64_t now, int64_t& out)
+{
+  Estimate estimate;
+  if (!GetEstimate(now, estimate)) {
+    return false;
+  }
+
+  out = gatewayTime - estimate.offsetMs;
+
+  return true;
+}
+
+void ClockSync::Reset()
+{
+  ScopedLock lock__(&s_clockMutex);
+
+  s_sampleCount = 0;
+  s_nextSample  = 0;
+}
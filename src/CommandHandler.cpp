@@ -5,23 +5,33 @@
 const char* const TAG = "CommandHandler";
 
 #include "Chipset.h"
+#include "ClockSync.h"
 #include "Common.h"
 #include "config/Config.h"
 #include "EStopManager.h"
+#include "LatencyTrace.h"
 #include "Logging.h"
+#include "radio/KeepAliveScheduler.h"
+#include "radio/rmt/SequenceCache.h"
 #include "radio/RFTransmitter.h"
 #include "ReadWriteMutex.h"
+#include "ShockerGroups.h"
 #include "SimpleMutex.h"
 #include "Time.h"
 #include "util/TaskUtils.h"
 
 #include <freertos/queue.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
-const int64_t KEEP_ALIVE_INTERVAL  = 60'000;
-const uint16_t KEEP_ALIVE_DURATION = 300;
+const int64_t KEEP_ALIVE_INTERVAL       = 60'000;
+const int64_t KEEP_ALIVE_STAGGER        = 5000;  // Keep-alives are sent up to this much early, depending on the shocker, so they don't bunch up
+const uint16_t KEEP_ALIVE_DURATION      = 300;
+const std::size_t KEEP_ALIVE_BATCH_SIZE = 16;
+const int64_t MAX_EXECUTE_AHEAD         = 2000;  // Longest a timestamped command is held for, timestamps further out are treated as bogus
 
 uint32_t calculateEepyTime(int64_t timeToKeepAlive)
 {
@@ -36,8 +46,12 @@ struct KnownShocker {
   int64_t lastActivityTimestamp;
 };
 
-static OpenShock::ReadWriteMutex s_rfTransmitterMutex            = {};
-static std::unique_ptr<OpenShock::RFTransmitter> s_rfTransmitter = nullptr;
+// Transmitter 0 is the primary transmitter on the configured TX pin, the rest are extra transmitters.
+// A slot is nullptr if that transmitter failed to initialize, so route indices stay stable.
+static OpenShock::ReadWriteMutex s_rfTransmitterMutex                          = {};
+static std::vector<std::unique_ptr<OpenShock::RFTransmitter>> s_rfTransmitters = {};
+static std::vector<OpenShock::Config::RFRoute> s_rfRoutes                      = {};
+static std::vector<OpenShock::Config::RFRepeatInterval> s_rfRepeatIntervals    = {};
 
 static OpenShock::SimpleMutex s_estopManagerMutex = {};
 
@@ -47,18 +61,158 @@ static TaskHandle_t s_keepAliveTaskHandle         = nullptr;
 
 using namespace OpenShock;
 
+// Must be called with s_rfTransmitterMutex held, s_rfTransmitters must not be empty
+static std::size_t _getRfTransmitterIndex(ShockerModelType model, uint16_t shockerId)
+{
+  // A route for the exact shocker wins over a route for its model
+  std::size_t index = 0;
+  for (const Config::RFRoute& route : s_rfRoutes) {
+    if (route.model != model) {
+      continue;
+    }
+
+    if (!route.byShockerId) {
+      index = route.transmitter;
+    } else if (route.shockerId == shockerId) {
+      index = route.transmitter;
+      break;
+    }
+  }
+
+  if (index >= s_rfTransmitters.size()) {
+    index = 0;
+  }
+
+  return index;
+}
+
+// Must be called with s_rfTransmitterMutex held
+static uint16_t _getMinRepeatIntervalMs(ShockerModelType model, uint16_t shockerId)
+{
+  // An interval for the exact shocker wins over an interval for its model, like routes
+  uint16_t intervalMs = 0;
+  for (const Config::RFRepeatInterval& repeatInterval : s_rfRepeatIntervals) {
+    if (repeatInterval.model != model) {
+      continue;
+    }
+
+    if (!repeatInterval.byShockerId) {
+      intervalMs = repeatInterval.intervalMs;
+    } else if (repeatInterval.shockerId == shockerId) {
+      intervalMs = repeatInterval.intervalMs;
+      break;
+    }
+  }
+
+  return intervalMs;
+}
+
+// Must be called with s_rfTransmitterMutex held
+static RFTransmitter* _getRfTransmitter(ShockerModelType model, uint16_t shockerId)
+{
+  if (s_rfTransmitters.empty()) {
+    return nullptr;
+  }
+
+  return s_rfTransmitters[_getRfTransmitterIndex(model, shockerId)].get();
+}
+
+// Must be called with s_rfTransmitterMutex held
+static bool _isRfTxPinInUse(gpio_num_t txPin, std::size_t ignoreIndex)
+{
+  for (std::size_t i = 0; i < s_rfTransmitters.size(); ++i) {
+    if (i != ignoreIndex && s_rfTransmitters[i] != nullptr && s_rfTransmitters[i]->GetTxPin() == txPin) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Sends keep-alives for all shockers as one batch per transmitter, so they reach the transmit task as a single queue item
+static void _sendKeepAlives(const KeepAliveScheduler::Shocker* shockers, std::size_t count)
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  if (s_rfTransmitters.empty()) {
+    OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring %zu keep-alives", count);
+    return;
+  }
+
+  std::array<RFTransmitter::Batch, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> batches = {};
+
+  int64_t now = OpenShock::millis();
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const KeepAliveScheduler::Shocker& shocker = shockers[i];
+
+    OS_LOGV(TAG, "Sending keep-alive for shocker %u", shocker.shockerId);
+
+    std::size_t index          = _getRfTransmitterIndex(shocker.model, shocker.shockerId);
+    RFTransmitter* transmitter = s_rfTransmitters[index].get();
+    if (transmitter == nullptr) {
+      OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring keep-alive for shocker %u", shocker.shockerId);
+      continue;
+    }
+
+    // Never overwrite, a shocker that is running a user command doesn't need a keep-alive
+    if (!transmitter->AddToBatch(batches[index], shocker.model, shocker.shockerId, ShockerCommandType::Vibrate, 0, KEEP_ALIVE_DURATION, now, false, _getMinRepeatIntervalMs(shocker.model, shocker.shockerId))) {
+      OS_LOGW(TAG, "Failed to send keep-alive for shocker %u", shocker.shockerId);
+    }
+  }
+
+  for (std::size_t i = 0; i < s_rfTransmitters.size(); ++i) {
+    if (batches[i].size != 0 && !s_rfTransmitters[i]->SendBatch(batches[i])) {
+      OS_LOGW(TAG, "Failed to send keep-alives on transmitter %zu", i);
+    }
+  }
+}
+
+// Pins the zero sequences of registered shockers, so keep-alives and the first command's tail and stop don't have to be encoded
+static void _warmSequenceCache(const std::vector<Config::RegisteredShocker>& shockers)
+{
+  std::array<Rmt::SequenceCache::PinnedShocker, Rmt::SequenceCache::kMaxPinned> pinned;
+
+  std::size_t count = std::min(shockers.size(), pinned.size());
+  for (std::size_t i = 0; i < count; ++i) {
+    pinned[i] = {.model = shockers[i].model, .shockerId = shockers[i].shockerId};
+  }
+
+  std::size_t pinnedCount = Rmt::SequenceCache::SetPinned(pinned.data(), count);
+  if (pinnedCount != shockers.size()) {
+    OS_LOGW(TAG, "Pinned %zu of %zu registered shockers", pinnedCount, shockers.size());
+  }
+}
+
+// Hands registered shockers to the keep-alive task as if they were last active an interval ago, so they are kept awake before their first command
+// Must be called with s_keepAliveMutex held
+static void _seedKeepAlives(const std::vector<Config::RegisteredShocker>& shockers)
+{
+  if (s_keepAliveQueue == nullptr) {
+    return;
+  }
+
+  int64_t lastActivity = OpenShock::millis() - KEEP_ALIVE_INTERVAL;
+  for (const Config::RegisteredShocker& shocker : shockers) {
+    KnownShocker cmd {.model = shocker.model, .shockerId = shocker.shockerId, .lastActivityTimestamp = lastActivity};
+    if (xQueueSend(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
+      OS_LOGE(TAG, "Failed to send keep-alive command to queue");
+      break;
+    }
+  }
+}
+
 void _keepAliveTask(void* arg)
 {
   (void)arg;
 
-  int64_t timeToKeepAlive = KEEP_ALIVE_INTERVAL;
+  KeepAliveScheduler scheduler(KEEP_ALIVE_INTERVAL, KEEP_ALIVE_STAGGER);
 
-  // Map of shocker IDs to time of next keep-alive
-  std::unordered_map<uint16_t, KnownShocker> activityMap;
+  std::array<KeepAliveScheduler::Shocker, KEEP_ALIVE_BATCH_SIZE> due;
 
   while (true) {
-    // Calculate eepyTime based on the timeToKeepAlive
-    uint32_t eepyTime = calculateEepyTime(timeToKeepAlive);
+    // Sleep until the next shocker is due, or until activity is reported
+    uint32_t eepyTime = calculateEepyTime(scheduler.NextDeadline());
 
     KnownShocker cmd;
     while (xQueueReceive(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(eepyTime)) == pdTRUE) {
@@ -68,37 +222,15 @@ void _keepAliveTask(void* arg)
         break;  // This should never be reached
       }
 
-      activityMap[cmd.shockerId] = cmd;
+      scheduler.Touch(cmd.model, cmd.shockerId, cmd.lastActivityTimestamp);
 
-      eepyTime = calculateEepyTime(std::min(timeToKeepAlive, cmd.lastActivityTimestamp + KEEP_ALIVE_INTERVAL));
+      eepyTime = calculateEepyTime(scheduler.NextDeadline());
     }
 
-    // Update the time to now
-    int64_t now = OpenShock::millis();
-
-    // Keep track of the minimum activity time, so we know when to wake up
-    timeToKeepAlive = now + KEEP_ALIVE_INTERVAL;
-
-    // For every entry that has a keep-alive time less than now, send a keep-alive
-    for (auto it = activityMap.begin(); it != activityMap.end(); ++it) {
-      auto& cmdRef = it->second;
-
-      if (cmdRef.lastActivityTimestamp + KEEP_ALIVE_INTERVAL < now) {
-        OS_LOGV(TAG, "Sending keep-alive for shocker %u", cmdRef.shockerId);
-
-        if (s_rfTransmitter == nullptr) {
-          OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring keep-alive");
-          break;
-        }
-
-        if (!s_rfTransmitter->SendCommand(cmdRef.model, cmdRef.shockerId, ShockerCommandType::Vibrate, 0, KEEP_ALIVE_DURATION, false)) {
-          OS_LOGW(TAG, "Failed to send keep-alive for shocker %u", cmdRef.shockerId);
-        }
-
-        cmdRef.lastActivityTimestamp = now;
-      }
-
-      timeToKeepAlive = std::min(timeToKeepAlive, cmdRef.lastActivityTimestamp + KEEP_ALIVE_INTERVAL);
+    // Anything left over when more than a batch is due goes out on the next iteration without sleeping
+    std::size_t count = scheduler.TakeDue(OpenShock::millis(), due.data(), due.size());
+    if (count != 0) {
+      _sendKeepAlives(due.data(), count);
     }
   }
 }
@@ -130,6 +262,12 @@ bool _internalSetKeepAliveEnabled(bool enabled)
 
       return false;
     }
+
+    // A fresh task knows no shockers, start it off with the registered ones
+    std::vector<Config::RegisteredShocker> shockers;
+    if (Config::GetRFConfigShockers(shockers)) {
+      _seedKeepAlives(shockers);
+    }
   } else {
     OS_LOGV(TAG, "Disabling keep-alive task");
     if (s_keepAliveTaskHandle != nullptr && s_keepAliveQueue != nullptr) {
@@ -183,13 +321,43 @@ bool CommandHandler::Init()
     }
   }
 
-  s_rfTransmitter = std::make_unique<RFTransmitter>(txPin);
-  if (!s_rfTransmitter->ok()) {
+  auto rfxmit = std::make_unique<RFTransmitter>(txPin);
+  if (!rfxmit->ok()) {
     OS_LOGE(TAG, "Failed to initialize RF Transmitter");
-    s_rfTransmitter = nullptr;
     return false;
   }
 
+  s_rfTransmitters.clear();
+  s_rfTransmitters.emplace_back(std::move(rfxmit));
+
+  for (gpio_num_t extraTxPin : rfConfig.extraTxPins) {
+    if (s_rfTransmitters.size() >= OPENSHOCK_RF_TX_MAX_TRANSMITTERS) {
+      OS_LOGW(TAG, "Too many RF transmitters configured, ignoring the rest");
+      break;
+    }
+
+    if (!OpenShock::IsValidOutputPin(extraTxPin) || _isRfTxPinInUse(extraTxPin, SIZE_MAX)) {
+      OS_LOGW(TAG, "Configured extra RF TX pin (%hhi) is invalid or already in use, skipping it", extraTxPin);
+      s_rfTransmitters.emplace_back(nullptr);
+      continue;
+    }
+
+    rfxmit = std::make_unique<RFTransmitter>(extraTxPin);
+    if (!rfxmit->ok()) {
+      OS_LOGW(TAG, "Failed to initialize RF Transmitter on extra pin (%hhi), skipping it", extraTxPin);
+      rfxmit = nullptr;
+    }
+
+    s_rfTransmitters.emplace_back(std::move(rfxmit));
+  }
+
+  s_rfRoutes          = rfConfig.routes;
+  s_rfRepeatIntervals = rfConfig.repeatIntervals;
+
+  RFTransmitter::SetQueuePolicy(rfConfig.queuePolicy);
+
+  _warmSequenceCache(rfConfig.shockers);
+
   if (rfConfig.keepAliveEnabled) {
     _internalSetKeepAliveEnabled(true);
   }
@@ -207,7 +375,7 @@ bool CommandHandler::Init()
 
 bool CommandHandler::Ok()
 {
-  return s_rfTransmitter != nullptr;
+  return !s_rfTransmitters.empty() && s_rfTransmitters[0] != nullptr;
 }
 
 SetGPIOResultCode CommandHandler::SetRfTxPin(gpio_num_t txPin)
@@ -218,9 +386,18 @@ SetGPIOResultCode CommandHandler::SetRfTxPin(gpio_num_t txPin)
 
   ScopedWriteLock lock__(&s_rfTransmitterMutex);
 
-  if (s_rfTransmitter != nullptr) {
+  if (_isRfTxPinInUse(txPin, 0)) {
+    OS_LOGE(TAG, "RF TX pin is already used by another transmitter");
+    return SetGPIOResultCode::InvalidPin;
+  }
+
+  if (s_rfTransmitters.empty()) {
+    s_rfTransmitters.emplace_back(nullptr);
+  }
+
+  if (s_rfTransmitters[0] != nullptr) {
     OS_LOGV(TAG, "Destroying existing RF transmitter");
-    s_rfTransmitter = nullptr;
+    s_rfTransmitters[0] = nullptr;
   }
 
   OS_LOGV(TAG, "Creating new RF transmitter");
@@ -235,11 +412,198 @@ SetGPIOResultCode CommandHandler::SetRfTxPin(gpio_num_t txPin)
     return SetGPIOResultCode::InternalError;
   }
 
-  s_rfTransmitter = std::move(rfxmit);
+  s_rfTransmitters[0] = std::move(rfxmit);
+
+  return SetGPIOResultCode::Success;
+}
+
+std::vector<gpio_num_t> CommandHandler::GetRfTxPins()
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  std::vector<gpio_num_t> txPins;
+  txPins.reserve(s_rfTransmitters.size());
+
+  for (const auto& transmitter : s_rfTransmitters) {
+    txPins.push_back(transmitter != nullptr ? transmitter->GetTxPin() : static_cast<gpio_num_t>(OPENSHOCK_GPIO_INVALID));
+  }
+
+  return txPins;
+}
+
+SetGPIOResultCode CommandHandler::AddRfTxPin(gpio_num_t txPin)
+{
+  if (!OpenShock::IsValidOutputPin(txPin)) {
+    return SetGPIOResultCode::InvalidPin;
+  }
+
+  ScopedWriteLock lock__(&s_rfTransmitterMutex);
+
+  if (s_rfTransmitters.empty() || s_rfTransmitters.size() >= OPENSHOCK_RF_TX_MAX_TRANSMITTERS) {
+    OS_LOGE(TAG, "Cannot add RF transmitter, primary transmitter missing or limit reached");
+    return SetGPIOResultCode::InternalError;
+  }
+
+  if (_isRfTxPinInUse(txPin, SIZE_MAX)) {
+    OS_LOGE(TAG, "RF TX pin is already used by another transmitter");
+    return SetGPIOResultCode::InvalidPin;
+  }
+
+  std::vector<gpio_num_t> extraTxPins;
+  if (!Config::GetRFConfigExtraTxPins(extraTxPins)) {
+    OS_LOGE(TAG, "Failed to get extra RF TX pins from config");
+    return SetGPIOResultCode::InternalError;
+  }
+
+  auto rfxmit = std::make_unique<RFTransmitter>(txPin);
+  if (!rfxmit->ok()) {
+    OS_LOGE(TAG, "Failed to initialize RF transmitter");
+    return SetGPIOResultCode::InternalError;
+  }
+
+  extraTxPins.push_back(txPin);
+  if (!Config::SetRFConfigExtraTxPins(extraTxPins)) {
+    OS_LOGE(TAG, "Failed to set extra RF TX pins in config");
+    return SetGPIOResultCode::InternalError;
+  }
+
+  s_rfTransmitters.emplace_back(std::move(rfxmit));
 
   return SetGPIOResultCode::Success;
 }
 
+bool CommandHandler::RemoveRfTxPin(uint8_t transmitter)
+{
+  ScopedWriteLock lock__(&s_rfTransmitterMutex);
+
+  // The primary transmitter can only be moved, not removed
+  if (transmitter == 0 || transmitter >= s_rfTransmitters.size()) {
+    return false;
+  }
+
+  std::vector<gpio_num_t> extraTxPins;
+  if (!Config::GetRFConfigExtraTxPins(extraTxPins) || transmitter > extraTxPins.size()) {
+    OS_LOGE(TAG, "Failed to get extra RF TX pins from config");
+    return false;
+  }
+
+  extraTxPins.erase(extraTxPins.begin() + (transmitter - 1));
+
+  // Routes to the removed transmitter go back to the primary one, routes to later transmitters shift down with them
+  std::vector<Config::RFRoute> routes = s_rfRoutes;
+  routes.erase(std::remove_if(routes.begin(), routes.end(), [transmitter](const Config::RFRoute& route) { return route.transmitter == transmitter; }), routes.end());
+  for (Config::RFRoute& route : routes) {
+    if (route.transmitter > transmitter) {
+      --route.transmitter;
+    }
+  }
+
+  if (!Config::SetRFConfigExtraTxPins(extraTxPins) || !Config::SetRFConfigRoutes(routes)) {
+    OS_LOGE(TAG, "Failed to save RF transmitters to config");
+    return false;
+  }
+
+  s_rfTransmitters.erase(s_rfTransmitters.begin() + transmitter);
+  s_rfRoutes = std::move(routes);
+
+  return true;
+}
+
+std::vector<Config::RFRoute> CommandHandler::GetRfRoutes()
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  return s_rfRoutes;
+}
+
+bool CommandHandler::SetRfRoute(const Config::RFRoute& route)
+{
+  ScopedWriteLock lock__(&s_rfTransmitterMutex);
+
+  if (route.transmitter >= s_rfTransmitters.size()) {
+    return false;
+  }
+
+  std::vector<Config::RFRoute> routes = s_rfRoutes;
+
+  auto it = std::find_if(routes.begin(), routes.end(), [&route](const Config::RFRoute& other) { return other.model == route.model && other.byShockerId == route.byShockerId && (!route.byShockerId || other.shockerId == route.shockerId); });
+  if (it != routes.end()) {
+    *it = route;
+  } else {
+    routes.push_back(route);
+  }
+
+  if (!Config::SetRFConfigRoutes(routes)) {
+    OS_LOGE(TAG, "Failed to set RF routes in config");
+    return false;
+  }
+
+  s_rfRoutes = std::move(routes);
+
+  return true;
+}
+
+bool CommandHandler::RemoveRfRoute(ShockerModelType model, bool byShockerId, uint16_t shockerId)
+{
+  ScopedWriteLock lock__(&s_rfTransmitterMutex);
+
+  std::vector<Config::RFRoute> routes = s_rfRoutes;
+
+  auto it = std::find_if(routes.begin(), routes.end(), [=](const Config::RFRoute& route) { return route.model == model && route.byShockerId == byShockerId && (!byShockerId || route.shockerId == shockerId); });
+  if (it == routes.end()) {
+    return false;
+  }
+
+  routes.erase(it);
+
+  if (!Config::SetRFConfigRoutes(routes)) {
+    OS_LOGE(TAG, "Failed to set RF routes in config");
+    return false;
+  }
+
+  s_rfRoutes = std::move(routes);
+
+  return true;
+}
+
+std::vector<Config::RFRepeatInterval> CommandHandler::GetRfRepeatIntervals()
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  return s_rfRepeatIntervals;
+}
+
+bool CommandHandler::SetRfRepeatInterval(const Config::RFRepeatInterval& repeatInterval)
+{
+  ScopedWriteLock lock__(&s_rfTransmitterMutex);
+
+  std::vector<Config::RFRepeatInterval> repeatIntervals = s_rfRepeatIntervals;
+
+  auto it = std::find_if(repeatIntervals.begin(), repeatIntervals.end(), [&repeatInterval](const Config::RFRepeatInterval& other) {
+    return other.model == repeatInterval.model && other.byShockerId == repeatInterval.byShockerId && (!repeatInterval.byShockerId || other.shockerId == repeatInterval.shockerId);
+  });
+  if (repeatInterval.intervalMs == 0) {
+    if (it == repeatIntervals.end()) {
+      return true;
+    }
+
+    repeatIntervals.erase(it);
+  } else if (it != repeatIntervals.end()) {
+    *it = repeatInterval;
+  } else {
+    repeatIntervals.push_back(repeatInterval);
+  }
+
+  if (!Config::SetRFConfigRepeatIntervals(repeatIntervals)) {
+    OS_LOGE(TAG, "Failed to set RF repeat intervals in config");
+    return false;
+  }
+
+  s_rfRepeatIntervals = std::move(repeatIntervals);
+
+  return true;
+}
+
 SetGPIOResultCode CommandHandler::SetEStopPin(gpio_num_t estopPin)
 {
   if (OpenShock::IsValidInputPin(static_cast<int8_t>(estopPin))) {
@@ -277,6 +641,34 @@ bool CommandHandler::SetKeepAliveEnabled(bool enabled)
   return true;
 }
 
+bool CommandHandler::SetRfQueuePolicy(RFQueuePolicy policy)
+{
+  if (!Config::SetRFConfigQueuePolicy(policy)) {
+    OS_LOGE(TAG, "Failed to set RF queue policy in config");
+    return false;
+  }
+
+  RFTransmitter::SetQueuePolicy(policy);
+
+  return true;
+}
+
+bool CommandHandler::SetShockerRegistry(const std::vector<Config::RegisteredShocker>& shockers)
+{
+  if (!Config::SetRFConfigShockers(shockers)) {
+    OS_LOGE(TAG, "Failed to set registered shockers in config");
+    return false;
+  }
+
+  _warmSequenceCache(shockers);
+
+  // Shockers the keep-alive task already tracks keep their deadline, seeding only adds the new ones
+  ScopedReadLock lock__(&s_keepAliveMutex);
+  _seedKeepAlives(shockers);
+
+  return true;
+}
+
 bool CommandHandler::SetKeepAlivePaused(bool paused)
 {
   bool keepAliveEnabled = false;
@@ -298,8 +690,10 @@ bool CommandHandler::SetKeepAlivePaused(bool paused)
 
 gpio_num_t CommandHandler::GetRfTxPin()
 {
-  if (s_rfTransmitter != nullptr) {
-    return s_rfTransmitter->GetTxPin();
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  if (!s_rfTransmitters.empty() && s_rfTransmitters[0] != nullptr) {
+    return s_rfTransmitters[0]->GetTxPin();
   }
 
   gpio_num_t txPin;
@@ -311,35 +705,155 @@ gpio_num_t CommandHandler::GetRfTxPin()
   return txPin;
 }
 
-bool CommandHandler::HandleCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs)
+std::size_t CommandHandler::GetFrameRates(TransmitScheduler::FrameRate* out, std::size_t maxCount)
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  std::size_t count = 0;
+  for (const auto& transmitter : s_rfTransmitters) {
+    if (transmitter != nullptr) {
+      count += transmitter->GetFrameRates(out + count, maxCount - count);
+    }
+  }
+
+  return count;
+}
+
+std::size_t CommandHandler::GetRfStats(RFStats::Snapshot* out, std::size_t maxCount)
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < s_rfTransmitters.size() && count < maxCount; ++i) {
+    RFTransmitter* transmitter = s_rfTransmitters[i].get();
+    if (transmitter == nullptr) {
+      continue;
+    }
+
+    RFStats::Snapshot& snapshot = out[count++];
+
+    snapshot.transmitter = static_cast<uint8_t>(i);
+    snapshot.txPin       = static_cast<int8_t>(transmitter->GetTxPin());
+    transmitter->GetStats().GetSnapshot(snapshot);
+  }
+
+  return count;
+}
+
+std::size_t CommandHandler::GetRfQueueStatus(RFQueueStatus* out, std::size_t maxCount)
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < s_rfTransmitters.size() && count < maxCount; ++i) {
+    RFTransmitter* transmitter = s_rfTransmitters[i].get();
+    if (transmitter == nullptr) {
+      continue;
+    }
+
+    RFQueueStatus& status = out[count++];
+
+    status.transmitter = static_cast<uint8_t>(i);
+    transmitter->GetQueueStatus(status);
+  }
+
+  return count;
+}
+
+void CommandHandler::ResetRfStats()
+{
+  ScopedReadLock lock__(&s_rfTransmitterMutex);
+
+  for (const auto& transmitter : s_rfTransmitters) {
+    if (transmitter != nullptr) {
+      transmitter->GetStats().Reset();
+    }
+  }
+}
+
+/// @brief Uptime a command with a gateway execution timestamp should start at, now if it has none or it can't be honored
+static int64_t _resolveExecuteAt(int64_t executeAtGatewayMs, int64_t now)
+{
+  if (executeAtGatewayMs == 0) {
+    return now;
+  }
+
+  int64_t executeAt;
+  if (!OpenShock::ClockSync::ToLocalTime(executeAtGatewayMs, now, executeAt)) {
+    OS_LOGW(TAG, "Gateway clock is not synced, executing timestamped command right away");
+    return now;
+  }
+
+  if (executeAt > now + MAX_EXECUTE_AHEAD) {
+    OS_LOGW(TAG, "Command timestamp is %lld ms ahead, executing right away", executeAt - now);
+    return now;
+  }
+
+  // Late commands still go out, as soon as possible
+  return std::max(executeAt, now);
+}
+
+bool CommandHandler::HandleCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t executeAtGatewayMs)
 {
   ScopedReadLock lock__rf(&s_rfTransmitterMutex);
 
-  if (s_rfTransmitter == nullptr) {
+  RFTransmitter* transmitter = _getRfTransmitter(model, shockerId);
+  if (transmitter == nullptr) {
     OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring command");
     return false;
   }
 
-  // Stop logic
+  bool ok;
+  int64_t now = OpenShock::millis();
+
+  // Stops take the priority lane, which purges whatever is still queued for the shocker, timestamps don't hold them back
   if (type == ShockerCommandType::Stop) {
-    OS_LOGV(TAG, "Stop command received, clearing pending commands");
+    OS_LOGV(TAG, "Stop command received, sending through stop lane");
 
-    type       = ShockerCommandType::Vibrate;
-    intensity  = 0;
     durationMs = 300;
 
-    s_rfTransmitter->ClearPendingCommands();
+    ok = transmitter->SendStop(model, shockerId);
   } else {
     OS_LOGD(TAG, "Command received: %u %u %u %u", model, shockerId, type, intensity);
+
+    now = _resolveExecuteAt(executeAtGatewayMs, now);
+
+    RFTransmitter::Batch batch = {};
+    ok                         = transmitter->AddToBatch(batch, model, shockerId, type, intensity, durationMs, now, true, _getMinRepeatIntervalMs(model, shockerId)) && transmitter->SendBatch(batch);
+  }
+
+  lock__rf.unlock();
+  ScopedReadLock lock__ka(&s_keepAliveMutex);
+
+  if (ok && s_keepAliveQueue != nullptr) {
+    KnownShocker cmd {.model = model, .shockerId = shockerId, .lastActivityTimestamp = now + durationMs};
+    if (xQueueSend(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
+      OS_LOGE(TAG, "Failed to send keep-alive command to queue");
+    }
   }
 
-  bool ok = s_rfTransmitter->SendCommand(model, shockerId, type, intensity, durationMs);
+  return ok;
+}
+
+bool CommandHandler::HandleWaveform(ShockerModelType model, uint16_t shockerId, const Waveform& waveform)
+{
+  ScopedReadLock lock__rf(&s_rfTransmitterMutex);
+
+  RFTransmitter* transmitter = _getRfTransmitter(model, shockerId);
+  if (transmitter == nullptr) {
+    OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring waveform");
+    return false;
+  }
+
+  OS_LOGD(TAG, "Waveform received: %u %u, %hhu keyframes over %u ms", model, shockerId, waveform.keyframeCount, waveform.DurationMs());
+
+  bool ok = transmitter->SendWaveform(model, shockerId, waveform);
 
   lock__rf.unlock();
   ScopedReadLock lock__ka(&s_keepAliveMutex);
 
   if (ok && s_keepAliveQueue != nullptr) {
-    KnownShocker cmd {.model = model, .shockerId = shockerId, .lastActivityTimestamp = OpenShock::millis() + durationMs};
+    KnownShocker cmd {.model = model, .shockerId = shockerId, .lastActivityTimestamp = OpenShock::millis() + waveform.DurationMs()};
     if (xQueueSend(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
       OS_LOGE(TAG, "Failed to send keep-alive command to queue");
     }
@@ -347,3 +861,127 @@ bool CommandHandler::HandleCommand(ShockerModelType model, uint16_t shockerId, S
 
   return ok;
 }
+
+struct PendingCommand {
+  ShockerModelType model;
+  uint16_t shockerId;
+  ShockerCommandType type;
+  uint8_t intensity;
+  uint16_t durationMs;
+};
+
+// Handles count commands under a single lock, getCommand(i) returns the i-th one, so callers don't have to copy their commands anywhere first
+template<typename GetCommand>
+static std::size_t _handleCommands(std::size_t count, int64_t executeAtGatewayMs, GetCommand getCommand)
+{
+  LatencyTrace::Mark(LatencyTrace::Stage::Dispatch);
+
+  ScopedReadLock lock__rf(&s_rfTransmitterMutex);
+
+  if (s_rfTransmitters.empty()) {
+    OS_LOGW(TAG, "RF Transmitter is not initialized, ignoring %zu commands", count);
+    return 0;
+  }
+
+  // One batch per transmitter, every command in the list shares the same start time
+  std::array<RFTransmitter::Batch, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> batches = {};
+
+  int64_t now          = _resolveExecuteAt(executeAtGatewayMs, OpenShock::millis());
+  std::size_t accepted = 0;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    PendingCommand command = getCommand(i);
+
+    std::size_t index          = _getRfTransmitterIndex(command.model, command.shockerId);
+    RFTransmitter* transmitter = s_rfTransmitters[index].get();
+    if (transmitter == nullptr) {
+      OS_LOGW(TAG, "RF Transmitter for shocker %u is not initialized, ignoring command", command.shockerId);
+      continue;
+    }
+
+    // Stops take the priority lane right away instead of waiting for the batch
+    if (command.type == ShockerCommandType::Stop) {
+      OS_LOGV(TAG, "Stop command received, sending through stop lane");
+
+      // Commands earlier in the list would be queued after the stop and outlive it, the stop supersedes them
+      RFTransmitter::Batch superseded = batches[index].RemoveShocker(command.shockerId);
+      accepted += superseded.size;
+      transmitter->ReleaseBatch(superseded);
+
+      if (transmitter->SendStop(command.model, command.shockerId)) {
+        ++accepted;
+      } else {
+        OS_LOGE(TAG, "Failed to stop shocker %u", command.shockerId);
+      }
+      continue;
+    }
+
+    OS_LOGD(TAG, "Command received: %u %u %u %u", command.model, command.shockerId, command.type, command.intensity);
+
+    if (!transmitter->AddToBatch(batches[index], command.model, command.shockerId, command.type, command.intensity, command.durationMs, now, true, _getMinRepeatIntervalMs(command.model, command.shockerId))) {
+      OS_LOGE(TAG, "Failed to queue command for shocker %u", command.shockerId);
+    }
+  }
+
+  // A single queue item per transmitter, so its task picks up the whole batch in one go
+  for (std::size_t i = 0; i < s_rfTransmitters.size(); ++i) {
+    RFTransmitter::Batch& batch = batches[i];
+    std::size_t size            = batch.size;
+
+    if (size != 0 && s_rfTransmitters[i]->SendBatch(batch)) {
+      accepted += size;
+    }
+  }
+
+  LatencyTrace::Mark(LatencyTrace::Stage::Enqueue);
+
+  lock__rf.unlock();
+
+  if (accepted == 0) {
+    return 0;
+  }
+
+  ScopedReadLock lock__ka(&s_keepAliveMutex);
+
+  if (s_keepAliveQueue != nullptr) {
+    for (std::size_t i = 0; i < count; ++i) {
+      PendingCommand command = getCommand(i);
+
+      KnownShocker cmd {.model = command.model, .shockerId = command.shockerId, .lastActivityTimestamp = now + command.durationMs};
+      if (xQueueSend(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
+        OS_LOGE(TAG, "Failed to send keep-alive command to queue");
+        break;
+      }
+    }
+  }
+
+  return accepted;
+}
+
+std::size_t CommandHandler::HandleCommandList(const flatbuffers::Vector<const Serialization::Gateway::ShockerCommand*>& commands, int64_t executeAtGatewayMs)
+{
+  return _handleCommands(commands.size(), executeAtGatewayMs, [&commands](std::size_t i) {
+    const Serialization::Gateway::ShockerCommand* command = commands.Get(i);
+    return PendingCommand {command->model(), command->id(), command->type(), command->intensity(), command->duration()};
+  });
+}
+
+bool CommandHandler::HandleGroupCommand(uint16_t groupId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t executeAtGatewayMs)
+{
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+
+  std::size_t count = ShockerGroups::GetMembers(groupId, members.data(), members.size());
+  if (count == 0) {
+    OS_LOGW(TAG, "Group %u is not defined, ignoring command", groupId);
+    return false;
+  }
+
+  std::size_t accepted = _handleCommands(count, executeAtGatewayMs, [&](std::size_t i) {
+    return PendingCommand {members[i].model, members[i].shockerId, type, intensity, durationMs};
+  });
+  if (accepted != count) {
+    OS_LOGW(TAG, "Group %u: %zu of %zu commands accepted", groupId, accepted, count);
+  }
+
+  return accepted == count;
+}
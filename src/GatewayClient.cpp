@@ -2,9 +2,12 @@
 
 const char* const TAG = "GatewayClient";
 
+#include "ClockSync.h"
+#include "CommandHandler.h"
 #include "Common.h"
 #include "config/Config.h"
 #include "event_handlers/WebSocket.h"
+#include "LatencyTrace.h"
 #include "Logging.h"
 #include "OtaUpdateManager.h"
 #include "serialization/WSGateway.h"
@@ -12,11 +15,30 @@ const char* const TAG = "GatewayClient";
 #include "util/CertificateUtils.h"
 #include "VisualStateManager.h"
 
+#include <algorithm>
+
 using namespace OpenShock;
 
+const int64_t KEEP_ALIVE_INTERVAL     = 15'000;
+const int64_t RF_QUEUE_CHECK_INTERVAL = 1000;  // The gateway hears about a saturated transmitter within a second, without a message per rejection
+const int64_t LATENCY_REPORT_INTERVAL = 60'000;  // Histograms are cumulative, the gateway diffs reports, so this only sets the time resolution
+
 static bool s_bootStatusSent = false;
 
-GatewayClient::GatewayClient(const std::string& authToken) : m_webSocket(), m_lastKeepAlive(0), m_state(State::Disconnected) {
+static bool _isRfQueueSaturated(const RFQueueStatus& status) {
+  return status.depth * 4 >= status.capacity * 3;
+}
+
+GatewayClient::GatewayClient(const std::string& authToken, GatewayOutboundQueue& outbox)
+  : m_webSocket()
+  , m_deFragger(std::bind(&GatewayClient::_handleEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), EventHandlers::WebSocket::kMaxGatewayMessageSize, EventHandlers::WebSocket::kMaxGatewayMessageSize)
+  , m_outbox(outbox)
+  , m_lastKeepAlive(0)
+  , m_lastRfQueueCheck(0)
+  , m_reportedRfQueues()
+  , m_lastLatencyReport(0)
+  , m_reportedLatencyCount(0)
+  , m_state(State::Disconnected) {
   OS_LOGD(TAG, "Creating GatewayClient");
 
   std::string headers = "Firmware-Version: " OPENSHOCK_FW_VERSION "\r\n"
@@ -25,7 +47,7 @@ GatewayClient::GatewayClient(const std::string& authToken) : m_webSocket(), m_la
 
   m_webSocket.setUserAgent(OpenShock::Constants::FW_USERAGENT);
   m_webSocket.setExtraHeaders(headers.c_str());
-  m_webSocket.onEvent(std::bind(&GatewayClient::_handleEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  m_webSocket.onEvent([this](WStype_t type, uint8_t* payload, std::size_t length) { m_deFragger.handler(0, type, payload, length); });
 }
 GatewayClient::~GatewayClient() {
   OS_LOGD(TAG, "Destroying GatewayClient");
@@ -64,22 +86,6 @@ void GatewayClient::disconnect() {
   m_webSocket.disconnect();
 }
 
-bool GatewayClient::sendMessageTXT(std::string_view data) {
-  if (m_state != State::Connected) {
-    return false;
-  }
-
-  return m_webSocket.sendTXT(data.data(), data.length());
-}
-
-bool GatewayClient::sendMessageBIN(const uint8_t* data, std::size_t length) {
-  if (m_state != State::Connected) {
-    return false;
-  }
-
-  return m_webSocket.sendBIN(data, length);
-}
-
 bool GatewayClient::loop() {
   if (m_state == State::Disconnected) {
     return false;
@@ -93,18 +99,56 @@ bool GatewayClient::loop() {
     return true;
   }
 
+  _drainOutbox();
+
   int64_t msNow = OpenShock::millis();
 
   int64_t timeSinceLastKA = msNow - m_lastKeepAlive;
 
-  if (timeSinceLastKA >= 15'000) {
+  if (timeSinceLastKA >= KEEP_ALIVE_INTERVAL) {
     _sendKeepAlive();
     m_lastKeepAlive = msNow;
   }
 
+  if (msNow - m_lastRfQueueCheck >= RF_QUEUE_CHECK_INTERVAL) {
+    _sendRfQueueStatus(false);
+    m_lastRfQueueCheck = msNow;
+  }
+
+  if (msNow - m_lastLatencyReport >= LATENCY_REPORT_INTERVAL) {
+    _sendLatencyReport(false);
+    m_lastLatencyReport = msNow;
+  }
+
   return true;
 }
 
+uint32_t GatewayClient::msUntilPeriodicWork() const {
+  if (m_state != State::Connected) {
+    return UINT32_MAX;
+  }
+
+  int64_t msNow = OpenShock::millis();
+  int64_t msDue = std::min({m_lastKeepAlive + KEEP_ALIVE_INTERVAL, m_lastRfQueueCheck + RF_QUEUE_CHECK_INTERVAL, m_lastLatencyReport + LATENCY_REPORT_INTERVAL});
+
+  return static_cast<uint32_t>(std::clamp<int64_t>(msDue - msNow, 0, UINT32_MAX));
+}
+
+int GatewayClient::Socket::fd() {
+  if (_client.ssl != nullptr) {
+    return _client.ssl->fd();
+  }
+  if (_client.tcp != nullptr) {
+    return _client.tcp->fd();
+  }
+
+  return -1;
+}
+
+bool GatewayClient::Socket::hasBufferedData() {
+  return _client.tcp != nullptr && _client.tcp->available() > 0;
+}
+
 void GatewayClient::_setState(State state) {
   if (m_state == state) {
     return;
@@ -115,7 +159,9 @@ void GatewayClient::_setState(State state) {
   switch (m_state) {
     case State::Disconnected:
       OS_LOGI(TAG, "Disconnected from API");
+      m_outbox.Discard();  // Progress of whatever was going on is stale by the time we are back
       OpenShock::VisualStateManager::SetWebSocketConnected(false);
+      OpenShock::ClockSync::Reset();  // The next gateway might run on another clock
       break;
     case State::Connected:
       OS_LOGI(TAG, "Connected to API");
@@ -163,44 +209,82 @@ void GatewayClient::_sendBootStatus() {
   }
 }
 
-void GatewayClient::_handleEvent(WStype_t type, uint8_t* payload, std::size_t length) {
-  (void)payload;
+void GatewayClient::_sendRfQueueStatus(bool force) {
+  std::array<RFQueueStatus, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> statuses;
+  std::size_t count = CommandHandler::GetRfQueueStatus(statuses.data(), statuses.size());
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const RFQueueStatus& status = statuses[i];
+    RFQueueStatus& reported     = m_reportedRfQueues[status.transmitter];
+
+    // Only changes are worth a message, a saturated queue is reported when it fills up and when it drains again
+    bool changed = status.rejected != reported.rejected || status.dropped != reported.dropped || status.coalesced != reported.coalesced || status.policy != reported.policy || _isRfQueueSaturated(status) != _isRfQueueSaturated(reported);
+    if (!force && !changed) {
+      continue;
+    }
+
+    OS_LOGV(TAG, "Sending RF queue status of transmitter %hhu", status.transmitter);
+    if (Serialization::Gateway::SerializeRfQueueStatusMessage(status, [this](const uint8_t* data, std::size_t len) { return m_webSocket.sendBIN(data, len); })) {
+      reported = status;
+    }
+  }
+}
+
+void GatewayClient::_sendLatencyReport(bool force) {
+  LatencyTrace::StageStats total;
+  LatencyTrace::GetStats(LatencyTrace::Stage::Total, total);
+
+  if (!force && total.count == m_reportedLatencyCount) {
+    return;
+  }
+
+  OS_LOGV(TAG, "Sending latency report (%u traced commands)", total.count);
+  if (Serialization::Gateway::SerializeLatencyReportMessage([this](const uint8_t* data, std::size_t len) { return m_webSocket.sendBIN(data, len); })) {
+    m_reportedLatencyCount = total.count;
+  }
+}
+
+void GatewayClient::_drainOutbox() {
+  m_outbox.Drain([this](WebSocketMessageType type, const uint8_t* data, std::size_t length) {
+    if (type == WebSocketMessageType::Text) {
+      return m_webSocket.sendTXT(reinterpret_cast<const char*>(data), length);
+    }
+
+    return m_webSocket.sendBIN(data, length);
+  });
+}
+
+void GatewayClient::_handleEvent(uint8_t socketId, WebSocketMessageType type, const uint8_t* payload, uint32_t length) {
+  (void)socketId;
 
   switch (type) {
-    case WStype_DISCONNECTED:
+    case WebSocketMessageType::Disconnected:
       _setState(State::Disconnected);
       break;
-    case WStype_CONNECTED:
+    case WebSocketMessageType::Connected:
       _setState(State::Connected);
       _sendKeepAlive();
       _sendBootStatus();
+      _sendRfQueueStatus(true);  // Baseline for the counters, the gateway diffs against it
+      _sendLatencyReport(true);
       break;
-    case WStype_TEXT:
+    case WebSocketMessageType::Text:
       OS_LOGW(TAG, "Received text from API, JSON parsing is not supported anymore :D");
       break;
-    case WStype_ERROR:
-      OS_LOGE(TAG, "Received error from API");
-      break;
-    case WStype_FRAGMENT_TEXT_START:
-      OS_LOGD(TAG, "Received fragment text start from API");
+    case WebSocketMessageType::Error:
+      OS_LOGE(TAG, "Received error from API: %.*s", static_cast<int>(length), reinterpret_cast<const char*>(payload));
       break;
-    case WStype_FRAGMENT:
-      OS_LOGD(TAG, "Received fragment from API");
-      break;
-    case WStype_FRAGMENT_FIN:
-      OS_LOGD(TAG, "Received fragment fin from API");
-      break;
-    case WStype_PING:
+    case WebSocketMessageType::Ping:
       OS_LOGD(TAG, "Received ping from API");
       break;
-    case WStype_PONG:
+    case WebSocketMessageType::Pong:
       OS_LOGV(TAG, "Received pong from API");
       break;
-    case WStype_BIN:
+    case WebSocketMessageType::Binary:
+      // Fragmented messages arrive here once the defragmenter has the whole message
+      LatencyTrace::Begin();
       EventHandlers::WebSocket::HandleGatewayBinary(payload, length);
-      break;
-    case WStype_FRAGMENT_BIN_START:
-      OS_LOGE(TAG, "Received binary fragment start from API, this is not supported!");
+      LatencyTrace::End();
       break;
     default:
       OS_LOGE(TAG, "Received unknown event from API");
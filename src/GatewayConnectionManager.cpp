@@ -4,12 +4,20 @@ const char* const TAG = "GatewayConnectionManager";
 
 #include "VisualStateManager.h"
 
+#include "CommandHandler.h"
 #include "config/Config.h"
 #include "GatewayClient.h"
 #include "http/JsonAPI.h"
 #include "Logging.h"
 #include "Time.h"
+#include "util/ExponentialBackoff.h"
+#include "util/SocketWaiter.h"
+#include "util/TaskUtils.h"
 
+#include <esp_system.h>
+
+#include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 //
@@ -34,14 +42,45 @@ const uint8_t FLAG_LINKED = 1 << 1;
 
 const uint8_t LINK_CODE_LENGTH = 6;
 
+const std::size_t MAX_REGISTERED_SHOCKERS = 32;  // Matches the keep-alive queue, accounts with more shockers only get the first ones warmed up
+
+const uint32_t RECONNECT_BACKOFF_BASE_MS = 1000;
+const uint32_t RECONNECT_BACKOFF_MAX_MS  = 60'000;
+const int64_t CONNECT_TIMEOUT_MS         = 15'000;              // The websocket library retries a failed handshake on its own, this bounds how long we let it
+const int64_t STABLE_CONNECTION_MS       = 60'000;              // A gateway that accepts and then drops us keeps the backoff growing until a connection lasts this long
+const int64_t LCG_CACHE_TTL_MS           = 6 * 60 * 60 * 1000;  // Counted from boot for an assignment loaded from flash, until the background refresh replaces it
+
+const uint32_t LCG_REFRESH_TASK_STACK_SIZE = 8192;  // Same HTTP and JSON path as the OTA task (6.2KB profiled), the task logs its high water mark when done
+
+const uint32_t IDLE_WAIT_MAX_MS       = 1000;  // Config changes from other tasks (auth token, LCG override) don't wake the main task, this bounds how late they are noticed
+const uint32_t CONNECTING_WAIT_MAX_MS = 50;    // The websocket library polls its handshake and retries on its own schedule while connecting
+const TickType_t FALLBACK_POLL_TICKS  = 5;     // Update interval without a wake socket, nothing would wake the main task for queued messages
+
 static uint8_t s_flags                                 = 0;
 static std::unique_ptr<OpenShock::GatewayClient> s_wsClient = nullptr;
+static OpenShock::GatewayOutboundQueue s_outbox;  // Only the client's loop drains it, any task may push
+static OpenShock::Util::SocketWaiter s_waiter;    // The main task sleeps in it between updates, woken by the gateway socket and by other tasks
+
+// Reconnect state, only touched by Update on the main task
+static OpenShock::Util::ExponentialBackoff s_backoff(RECONNECT_BACKOFF_BASE_MS, RECONNECT_BACKOFF_MAX_MS);
+static int64_t s_nextAttemptAt    = 0;
+static int64_t s_attemptStartedAt = 0;  // 0 when no connection attempt is waiting for the gateway
+static int64_t s_connectedAt      = 0;  // 0 when not connected to the gateway
+static int64_t s_lcgCachedAt      = 0;  // 0 while the cached assignment is the one loaded from flash, its age is unknown
+static bool s_attemptUsesCache    = false;
+static bool s_hadIP               = false;
+
+// Shared with the LCG refresh task
+static std::atomic<bool> s_lcgRefreshRunning = false;
+static std::atomic<bool> s_lcgRefreshed      = false;
+static std::atomic<bool> s_tokenRevoked      = false;
 
 void _evGotIPHandler(arduino_event_t* event) {
   (void)event;
 
   s_flags |= FLAG_HAS_IP;
   OS_LOGD(TAG, "Got IP address");
+  s_waiter.Wake();
 }
 
 void _evWiFiDisconnectedHandler(arduino_event_t* event) {
@@ -51,6 +90,7 @@ void _evWiFiDisconnectedHandler(arduino_event_t* event) {
   s_wsClient = nullptr;
   OS_LOGD(TAG, "Lost IP address");
   OpenShock::VisualStateManager::SetWebSocketConnected(false);
+  s_waiter.Wake();
 }
 
 using namespace OpenShock;
@@ -61,6 +101,10 @@ bool GatewayConnectionManager::Init() {
   WiFi.onEvent(_evGotIPHandler, ARDUINO_EVENT_WIFI_STA_GOT_IP6);
   WiFi.onEvent(_evWiFiDisconnectedHandler, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
 
+  if (!s_waiter.Init()) {
+    OS_LOGE(TAG, "Failed to set up wake socket, polling every %u ticks instead", FALLBACK_POLL_TICKS);
+  }
+
   return true;
 }
 
@@ -123,6 +167,7 @@ AccountLinkResultCode GatewayConnectionManager::Link(std::string_view linkCode)
 
   s_flags |= FLAG_LINKED;
   OS_LOGD(TAG, "Successfully linked to account");
+  s_waiter.Wake();
 
   return AccountLinkResultCode::Success;
 }
@@ -130,6 +175,7 @@ void GatewayConnectionManager::UnLink() {
   s_flags &= FLAG_HAS_IP;
   s_wsClient = nullptr;
   Config::ClearBackendAuthToken();
+  s_waiter.Wake();
 }
 
 bool GatewayConnectionManager::SendMessageTXT(std::string_view data) {
@@ -137,15 +183,29 @@ bool GatewayConnectionManager::SendMessageTXT(std::string_view data) {
     return false;
   }
 
-  return s_wsClient->sendMessageTXT(data);
+  if (!s_outbox.Push(WebSocketMessageType::Text, reinterpret_cast<const uint8_t*>(data.data()), data.length())) {
+    return false;
+  }
+
+  s_waiter.Wake();
+  return true;
 }
 
-bool GatewayConnectionManager::SendMessageBIN(const uint8_t* data, std::size_t length) {
+bool GatewayConnectionManager::SendMessageBIN(const uint8_t* data, std::size_t length, OutboundCoalesceKey key) {
   if (s_wsClient == nullptr) {
     return false;
   }
 
-  return s_wsClient->sendMessageBIN(data, length);
+  if (!s_outbox.Push(WebSocketMessageType::Binary, data, length, key)) {
+    return false;
+  }
+
+  s_waiter.Wake();
+  return true;
+}
+
+OpenShock::OutboundQueueStats GatewayConnectionManager::GetOutboxStats() {
+  return s_outbox.stats();
 }
 
 bool FetchDeviceInfo(std::string_view authToken) {
@@ -178,8 +238,21 @@ bool FetchDeviceInfo(std::string_view authToken) {
   OS_LOGI(TAG, "Device ID:   %s", response.data.deviceId.c_str());
   OS_LOGI(TAG, "Device Name: %s", response.data.deviceName.c_str());
   OS_LOGI(TAG, "Shockers:");
+
+  std::vector<Config::RegisteredShocker> shockers;
+  shockers.reserve(std::min(response.data.shockers.size(), MAX_REGISTERED_SHOCKERS));
+
   for (auto& shocker : response.data.shockers) {
     OS_LOGI(TAG, "  [%s] rf=%u model=%u", shocker.id.c_str(), shocker.rfId, shocker.model);
+
+    if (shockers.size() < MAX_REGISTERED_SHOCKERS) {
+      shockers.push_back({.model = shocker.model, .shockerId = shocker.rfId});
+    }
+  }
+
+  // Kept across reboots, so the next boot can warm these shockers up before the gateway connects
+  if (!CommandHandler::SetShockerRegistry(shockers)) {
+    OS_LOGW(TAG, "Failed to save registered shockers");
   }
 
   s_flags |= FLAG_LINKED;
@@ -187,9 +260,92 @@ bool FetchDeviceInfo(std::string_view authToken) {
   return true;
 }
 
-static int64_t _lastConnectionAttempt = 0;
+static void _retryLater() {
+  uint32_t delayMs = s_backoff.Fail(esp_random());
+  s_nextAttemptAt  = OpenShock::millis() + delayMs;
+
+  OS_LOGD(TAG, "Retrying gateway connection in %u ms (attempt %u)", delayMs, s_backoff.failures());
+}
+
+static bool _getCachedLcg(int64_t msNow, std::string& fqdn) {
+  if (!Config::GetBackendLCGCache(fqdn) || fqdn.empty()) {
+    return false;
+  }
+
+  if (msNow - s_lcgCachedAt >= LCG_CACHE_TTL_MS) {
+    OS_LOGD(TAG, "Cached LCG assignment expired");
+    Config::ClearBackendLCGCache();
+    fqdn.clear();
+    return false;
+  }
+
+  return true;
+}
+
+static void _lcgRefreshTask(void* arg) {
+  (void)arg;
+
+  std::string authToken;
+  if (!Config::GetBackendAuthToken(authToken)) {
+    OS_LOGE(TAG, "Failed to get auth token");
+  } else if (!FetchDeviceInfo(authToken)) {
+    // Startup skipped verifying the token for the cached assignment, this is where an unlinked hub finds out
+    if (!Config::HasBackendAuthToken()) {
+      s_tokenRevoked = true;
+    }
+  } else {
+    auto response = HTTP::JsonAPI::AssignLcg(authToken);
+
+    if (response.result == HTTP::RequestResult::Success && response.code == 200) {
+      if (Config::SetBackendLCGCache(response.data.fqdn)) {
+        s_lcgRefreshed = true;
+      } else {
+        OS_LOGW(TAG, "Failed to cache LCG assignment");
+      }
+    } else {
+      // The connection that got us here still works, a failed refresh is retried on the next cached connection
+      OS_LOGW(TAG, "Failed to refresh cached LCG assignment: %d %d", response.result, response.code);
+    }
+  }
+
+  OS_LOGD(TAG, "LCG refresh task used %u of %u bytes of stack", LCG_REFRESH_TASK_STACK_SIZE - uxTaskGetStackHighWaterMark(nullptr), LCG_REFRESH_TASK_STACK_SIZE);
+
+  s_lcgRefreshRunning = false;
+  vTaskDelete(nullptr);
+}
+
+// The cache survives reboots but its fetch time doesn't, and startup skips the device info for it, so both are fetched again once per boot without holding up the connection
+static void _refreshCachedLcg() {
+  if (s_lcgCachedAt != 0 || s_lcgRefreshRunning.exchange(true)) {
+    return;
+  }
+
+  if (TaskUtils::TaskCreateExpensive(_lcgRefreshTask, "LCGRefresh", LCG_REFRESH_TASK_STACK_SIZE, nullptr, 1, nullptr) != pdPASS) {
+    OS_LOGE(TAG, "Failed to create LCG refresh task");
+    s_lcgRefreshRunning = false;
+  }
+}
+
+static void _connect(const char* fqdn, bool fromCache) {
+  s_attemptStartedAt = OpenShock::millis();
+  s_attemptUsesCache = fromCache;
+  s_wsClient->connect(fqdn);
+}
+
+static void _onAttemptFailed() {
+  s_attemptStartedAt = 0;
+
+  // The gateway or the token behind the cached assignment is gone, the next attempt asks the backend again
+  if (s_attemptUsesCache) {
+    OS_LOGI(TAG, "Cached LCG did not accept the connection, dropping it");
+    Config::ClearBackendLCGCache();
+    s_attemptUsesCache = false;
+  }
+
+  _retryLater();
+}
+
 bool StartConnectingToLCG() {
-  // TODO: this function is very slow, should be optimized!
   if (s_wsClient == nullptr) {  // If wsClient is already initialized, we are already paired or connected
     OS_LOGD(TAG, "wsClient is null");
     return false;
@@ -202,18 +358,16 @@ bool StartConnectingToLCG() {
   }
 
   int64_t msNow = OpenShock::millis();
-  if (_lastConnectionAttempt != 0 && (msNow - _lastConnectionAttempt) < 20'000) {  // Only try to connect every 20 seconds
+  if (msNow < s_nextAttemptAt) {
     return false;
   }
 
-  _lastConnectionAttempt = msNow;
-
   if (Config::HasBackendLCGOverride()) {
     std::string lcgOverride;
     Config::GetBackendLCGOverride(lcgOverride);
 
     OS_LOGD(TAG, "Connecting to overridden LCG endpoint %s", lcgOverride.c_str());
-    s_wsClient->connect(lcgOverride.c_str());
+    _connect(lcgOverride.c_str(), false);
     return true;
   }
 
@@ -222,6 +376,13 @@ bool StartConnectingToLCG() {
     return false;
   }
 
+  std::string cachedFqdn;
+  if (_getCachedLcg(msNow, cachedFqdn)) {
+    OS_LOGD(TAG, "Connecting to cached LCG endpoint %s", cachedFqdn.c_str());
+    _connect(cachedFqdn.c_str(), true);
+    return true;
+  }
+
   std::string authToken;
   if (!Config::GetBackendAuthToken(authToken)) {
     OS_LOGE(TAG, "Failed to get auth token");
@@ -231,10 +392,12 @@ bool StartConnectingToLCG() {
   auto response = HTTP::JsonAPI::AssignLcg(authToken);
 
   if (response.result == HTTP::RequestResult::RateLimited) {
+    _retryLater();
     return false;  // Just return false, don't spam the console with errors
   }
   if (response.result != HTTP::RequestResult::Success) {
     OS_LOGE(TAG, "Error while fetching LCG endpoint: %d %d", response.result, response.code);
+    _retryLater();
     return false;
   }
 
@@ -246,19 +409,49 @@ bool StartConnectingToLCG() {
 
   if (response.code != 200) {
     OS_LOGE(TAG, "Unexpected response code: %d", response.code);
+    _retryLater();
     return false;
   }
 
+  if (!Config::SetBackendLCGCache(response.data.fqdn)) {
+    OS_LOGW(TAG, "Failed to cache LCG assignment");
+  }
+  s_lcgCachedAt = msNow;
+
   OS_LOGD(TAG, "Connecting to LCG endpoint %s in country %s", response.data.fqdn.c_str(), response.data.country.c_str());
-  s_wsClient->connect(response.data.fqdn.c_str());
+  _connect(response.data.fqdn.c_str(), true);
 
   return true;
 }
 
 void GatewayConnectionManager::Update() {
+  if (s_lcgRefreshed.exchange(false)) {
+    s_lcgCachedAt = OpenShock::millis();
+  }
+
+  if (s_tokenRevoked.exchange(false)) {
+    OS_LOGW(TAG, "Auth token was revoked, disconnecting from LCG");
+    s_flags &= FLAG_HAS_IP;
+    s_wsClient = nullptr;
+  }
+
+  bool hasIP = (s_flags & FLAG_HAS_IP) != 0;
+  if (hasIP && !s_hadIP) {
+    // A fresh network link, whatever failed before deserves a quick retry
+    s_backoff.Reset();
+    s_nextAttemptAt    = 0;
+    s_attemptStartedAt = 0;
+    s_connectedAt      = 0;
+  }
+  s_hadIP = hasIP;
+
   if (s_wsClient == nullptr) {
     // Can't connect to the API without WiFi or an auth token
-    if ((s_flags & FLAG_HAS_IP) == 0 || !Config::HasBackendAuthToken()) {
+    if (!hasIP || !Config::HasBackendAuthToken()) {
+      return;
+    }
+
+    if (OpenShock::millis() < s_nextAttemptAt) {
       return;
     }
 
@@ -268,20 +461,100 @@ void GatewayConnectionManager::Update() {
       return;
     }
 
-    // Fetch device info
-    if (!FetchDeviceInfo(authToken.c_str())) {
-      return;
+    // A cached assignment was handed out for this token, so skip verifying it over HTTP, the gateway refuses a revoked token and the cache is dropped then
+    std::string cachedFqdn;
+    if (Config::HasBackendLCGOverride() || !_getCachedLcg(OpenShock::millis(), cachedFqdn)) {
+      if (!FetchDeviceInfo(authToken.c_str())) {
+        _retryLater();
+        return;
+      }
+
+      OS_LOGD(TAG, "Successfully verified auth token");
     }
 
     s_flags |= FLAG_LINKED;
-    OS_LOGD(TAG, "Successfully verified auth token");
 
-    s_wsClient = std::make_unique<GatewayClient>(authToken);
+    // Whatever the previous client left queued is stale, it was reset without going through its disconnect (WiFi loss, unlink, timeout), and only this task may drain the outbox
+    s_outbox.Discard();
+
+    s_wsClient    = std::make_unique<GatewayClient>(authToken, s_outbox);
+    s_connectedAt = 0;
   }
 
   if (s_wsClient->loop()) {
+    if (s_wsClient->state() == GatewayClient::State::Connected) {
+      int64_t msNow = OpenShock::millis();
+      if (s_attemptStartedAt != 0) {
+        s_attemptStartedAt = 0;
+        s_connectedAt      = msNow;
+
+        if (s_attemptUsesCache) {
+          _refreshCachedLcg();
+        }
+      } else if (s_backoff.failures() != 0 && msNow - s_connectedAt >= STABLE_CONNECTION_MS) {
+        s_backoff.Reset();
+      }
+      return;
+    }
+
+    if (s_attemptStartedAt == 0) {
+      return;
+    }
+
+    if (OpenShock::millis() - s_attemptStartedAt >= CONNECT_TIMEOUT_MS) {
+      OS_LOGW(TAG, "Timed out connecting to LCG");
+      s_wsClient = nullptr;  // Stops the websocket library from retrying on its own
+      _onAttemptFailed();
+    }
+
     return;
   }
 
+  if (s_attemptStartedAt != 0) {
+    _onAttemptFailed();
+  } else if (s_connectedAt != 0) {
+    // Backs off like a failed attempt, so a gateway that drops every hub at once isn't hit by all of them right away
+    OS_LOGD(TAG, "Lost connection to LCG after %lld ms", OpenShock::millis() - s_connectedAt);
+    s_connectedAt = 0;
+    _retryLater();
+  }
+
   StartConnectingToLCG();
 }
+
+void GatewayConnectionManager::WaitForActivity() {
+  if (!s_waiter.ok()) {
+    vTaskDelay(FALLBACK_POLL_TICKS);
+    return;
+  }
+
+  uint32_t timeoutMs = IDLE_WAIT_MAX_MS;
+  int fd             = -1;
+
+  if (s_wsClient != nullptr && s_wsClient->state() != GatewayClient::State::Disconnected) {
+    // Already decrypted, the socket won't signal it again
+    if (s_wsClient->hasBufferedData()) {
+      return;
+    }
+
+    fd = s_wsClient->socketFd();
+
+    if (s_wsClient->state() == GatewayClient::State::Connected) {
+      timeoutMs = std::min(timeoutMs, s_wsClient->msUntilPeriodicWork());
+    } else {
+      timeoutMs = CONNECTING_WAIT_MAX_MS;
+    }
+  } else {
+    // Waiting out the reconnect backoff, losing or getting an IP wakes us earlier
+    int64_t msUntilAttempt = s_nextAttemptAt - OpenShock::millis();
+    if (msUntilAttempt > 0) {
+      timeoutMs = static_cast<uint32_t>(std::min<int64_t>(msUntilAttempt, timeoutMs));
+    }
+  }
+
+  if (timeoutMs == 0) {
+    return;
+  }
+
+  s_waiter.Wait(&fd, 1, timeoutMs);
+}
@@ -0,0 +1,122 @@
+#include "LatencyTrace.h"
+
+#include "Time.h"
+
+#include <atomic>
+
+using namespace OpenShock;
+
+namespace {
+  struct Histogram {
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sumUs;
+    std::atomic<uint32_t> maxUs;
+    std::array<std::atomic<uint32_t>, LatencyTrace::kBucketCount> buckets;
+  };
+
+  struct Trace {
+    int64_t originUs;
+    int64_t lastUs;
+  };
+}  // namespace
+
+static std::array<Histogram, LatencyTrace::kStageCount> s_histograms = {};
+
+// Only the task that received a frame knows it, so traces never cross tasks
+static thread_local Trace s_trace = {};
+
+static std::size_t bucketFor(uint32_t latencyUs)
+{
+  std::size_t bucket = 0;
+  while (bucket + 1 < LatencyTrace::kBucketCount && latencyUs >= LatencyTrace::BucketUpperBoundUs(bucket)) {
+    ++bucket;
+  }
+
+  return bucket;
+}
+
+void LatencyTrace::Begin()
+{
+  int64_t now = OpenShock::micros();
+
+  s_trace.originUs = now;
+  s_trace.lastUs   = now;
+}
+
+void LatencyTrace::End()
+{
+  s_trace = {};
+}
+
+void LatencyTrace::Mark(Stage stage)
+{
+  if (s_trace.originUs == 0) {
+    return;
+  }
+
+  int64_t now = OpenShock::micros();
+
+  Record(stage, static_cast<uint32_t>(now - s_trace.lastUs));
+  s_trace.lastUs = now;
+}
+
+int64_t LatencyTrace::Origin()
+{
+  return s_trace.originUs;
+}
+
+void LatencyTrace::Record(Stage stage, uint32_t latencyUs)
+{
+  Histogram& histogram = s_histograms[static_cast<std::size_t>(stage)];
+
+  histogram.count.fetch_add(1, std::memory_order_relaxed);
+  histogram.sumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+  histogram.buckets[bucketFor(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+
+  uint32_t max = histogram.maxUs.load(std::memory_order_relaxed);
+  while (latencyUs > max && !histogram.maxUs.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) { }
+}
+
+const char* LatencyTrace::StageName(Stage stage)
+{
+  switch (stage) {
+    case Stage::Verify:
+      return "Verify";
+    case Stage::Dispatch:
+      return "Dispatch";
+    case Stage::Enqueue:
+      return "Enqueue";
+    case Stage::Dequeue:
+      return "Dequeue";
+    case Stage::Emit:
+      return "Emit";
+    case Stage::Total:
+      return "Total";
+    default:
+      return "Unknown";
+  }
+}
+
+void LatencyTrace::GetStats(Stage stage, StageStats& out)
+{
+  const Histogram& histogram = s_histograms[static_cast<std::size_t>(stage)];
+
+  out.count = histogram.count.load(std::memory_order_relaxed);
+  out.sumUs = histogram.sumUs.load(std::memory_order_relaxed);
+  out.maxUs = histogram.maxUs.load(std::memory_order_relaxed);
+  for (std::size_t i = 0; i < kBucketCount; ++i) {
+    out.buckets[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+  }
+}
+
+void LatencyTrace::Reset()
+{
+  for (Histogram& histogram : s_histograms) {
+    histogram.count.store(0, std::memory_order_relaxed);
+    histogram.sumUs.store(0, std::memory_order_relaxed);
+    histogram.maxUs.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint32_t>& bucket : histogram.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
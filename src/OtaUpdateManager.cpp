@@ -110,6 +110,11 @@ void _otaEvWiFiDisconnectedHandler(arduino_event_t* event)
   xTaskNotify(_taskHandle, OTA_TASK_EVENT_WIFI_DISCONNECTED, eSetBits);
 }
 
+// SendMessageBIN takes a coalesce key, so it can't be handed to the serializers as a callback directly
+bool _sendGatewayMessage(const uint8_t* data, std::size_t len)
+{
+  return GatewayConnectionManager::SendMessageBIN(data, len);
+}
 bool _sendProgressMessage(Serialization::Gateway::OtaInstallProgressTask task, float progress)
 {
   int32_t updateId;
@@ -118,7 +123,10 @@ bool _sendProgressMessage(Serialization::Gateway::OtaInstallProgressTask task, f
     return false;
   }
 
-  if (!Serialization::Gateway::SerializeOtaInstallProgressMessage(updateId, task, progress, GatewayConnectionManager::SendMessageBIN)) {
+  // Only the latest progress matters, a queued update the gateway loop has not sent yet is replaced
+  auto send = [](const uint8_t* data, std::size_t len) { return GatewayConnectionManager::SendMessageBIN(data, len, OutboundCoalesceKey::OtaInstallProgress); };
+
+  if (!Serialization::Gateway::SerializeOtaInstallProgressMessage(updateId, task, progress, send)) {
     OS_LOGE(TAG, "Failed to send OTA install progress message");
     return false;
   }
@@ -133,7 +141,7 @@ bool _sendFailureMessage(std::string_view message, bool fatal = false)
     return false;
   }
 
-  if (!Serialization::Gateway::SerializeOtaInstallFailedMessage(updateId, message, fatal, GatewayConnectionManager::SendMessageBIN)) {
+  if (!Serialization::Gateway::SerializeOtaInstallFailedMessage(updateId, message, fatal, _sendGatewayMessage)) {
     OS_LOGE(TAG, "Failed to send OTA install failed message");
     return false;
   }
@@ -334,7 +342,7 @@ void _otaUpdateTask(void* arg)
       continue;
     }
 
-    if (!Serialization::Gateway::SerializeOtaInstallStartedMessage(updateId, version, GatewayConnectionManager::SendMessageBIN)) {
+    if (!Serialization::Gateway::SerializeOtaInstallStartedMessage(updateId, version, _sendGatewayMessage)) {
       OS_LOGE(TAG, "Failed to serialize OTA install started message");
       continue;
     }
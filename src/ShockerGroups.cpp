@@ -0,0 +1,111 @@
+#include "ShockerGroups.h"
+
+#include "SimpleMutex.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace OpenShock;
+
+namespace {
+  struct Group {
+    uint16_t id;
+    uint8_t memberCount;
+    std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+  };
+}  // namespace
+
+static OpenShock::SimpleMutex s_groupMutex                   = {};
+static std::array<Group, ShockerGroups::kMaxGroups> s_groups = {};
+static std::size_t s_groupCount                              = 0;
+
+// Must be called with s_groupMutex held
+static Group* findGroup(uint16_t groupId)
+{
+  for (std::size_t i = 0; i < s_groupCount; ++i) {
+    if (s_groups[i].id == groupId) {
+      return &s_groups[i];
+    }
+  }
+
+  return nullptr;
+}
+
+bool ShockerGroups::Define(uint16_t groupId, const Member* members, std::size_t count)
+{
+  if (count > kMaxMembers) {
+    return false;
+  }
+
+  ScopedLock lock__(&s_groupMutex);
+
+  Group* group = findGroup(groupId);
+
+  if (count == 0) {
+    if (group != nullptr) {
+      // Order doesn't matter, fill the hole with the last group
+      *group = s_groups[--s_groupCount];
+    }
+    return true;
+  }
+
+  if (group == nullptr) {
+    if (s_groupCount >= s_groups.size()) {
+      return false;
+    }
+
+    group     = &s_groups[s_groupCount++];
+    group->id = groupId;
+  }
+
+  // A shocker listed twice would get every command twice
+  uint8_t memberCount = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    const Member& member = members[i];
+
+    bool duplicate = false;
+    for (std::size_t j = 0; j < memberCount; ++j) {
+      if (group->members[j].model == member.model && group->members[j].shockerId == member.shockerId) {
+        duplicate = true;
+        break;
+      }
+    }
+
+    if (!duplicate) {
+      group->members[memberCount++] = member;
+    }
+  }
+
+  group->memberCount = memberCount;
+
+  return true;
+}
+
+std::size_t ShockerGroups::GetMembers(uint16_t groupId, Member* out, std::size_t maxCount)
+{
+  ScopedLock lock__(&s_groupMutex);
+
+  const Group* group = findGroup(groupId);
+  if (group == nullptr) {
+    return 0;
+  }
+
+  std::size_t count = std::min(static_cast<std::size_t>(group->memberCount), maxCount);
+  std::copy(group->members.begin(), group->members.begin() + count, out);
+
+  return count;
+}
+
+std::size_t ShockerGroups::Count()
+{
+  ScopedLock lock__(&s_groupMutex);
+
+  return s_groupCount;
+}
+
+void ShockerGroups::Clear()
+{
+  ScopedLock lock__(&s_groupMutex);
+
+  s_groupCount = 0;
+}
@@ -4,21 +4,19 @@ const char* const TAG = "WebSocketDeFragger";
 
 #include "Logging.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 
 using namespace OpenShock;
 
-uint8_t* _reallocOrFree(uint8_t* ptr, std::size_t size) {
-  void* newPtr = realloc(ptr, size);
-  if (newPtr == nullptr) {
-    free(ptr);
-    OS_PANIC(TAG, "Failed to allocate memory");
-  }
-
-  return reinterpret_cast<uint8_t*>(newPtr);
-}
+const uint32_t DEFRAGGER_MIN_CAPACITY = 512;
 
-WebSocketDeFragger::WebSocketDeFragger(EventCallback callback) : m_messages(), m_callback(callback) { }
+WebSocketDeFragger::WebSocketDeFragger(EventCallback callback, uint32_t maxMessageSize, uint32_t retainCapacity)
+  : m_buffers()
+  , m_maxMessageSize(maxMessageSize)
+  , m_retainCapacity(retainCapacity)
+  , m_callback(callback) { }
 
 WebSocketDeFragger::~WebSocketDeFragger() {
   clear();
@@ -33,25 +31,27 @@ void WebSocketDeFragger::handler(uint8_t socketId, WStype_t type, const uint8_t*
       start(socketId, WebSocketMessageType::Text, payload, length);
       return;
     case WStype_FRAGMENT:
-      append(socketId, payload, length);
+      append(socketId, payload, length, false);
       return;
     case WStype_FRAGMENT_FIN:
-      finish(socketId, payload, length);
+      append(socketId, payload, length, true);
       return;
-    [[likely]] default:
-      clear(socketId);
+    default:
       break;
   }
 
   WebSocketMessageType messageType;
   switch (type) {
     [[unlikely]] case WStype_ERROR:
+      clear(socketId);
       messageType = WebSocketMessageType::Error;
       break;
     case WStype_DISCONNECTED:
+      clear(socketId);
       messageType = WebSocketMessageType::Disconnected;
       break;
     case WStype_CONNECTED:
+      clear(socketId);
       messageType = WebSocketMessageType::Connected;
       break;
     case WStype_TEXT:
@@ -67,11 +67,19 @@ void WebSocketDeFragger::handler(uint8_t socketId, WStype_t type, const uint8_t*
       messageType = WebSocketMessageType::Pong;
       break;
     [[unlikely]] default:
-      const char* const errorMessage = "Unknown WebSocket event type";
-      m_callback(socketId, WebSocketMessageType::Error, reinterpret_cast<const uint8_t*>(errorMessage), strlen(errorMessage));
+      clear(socketId);
+      fail(socketId, "Unknown WebSocket event type");
       return;
   }
 
+  // Control frames may arrive between fragments, a data frame means the fragmented message was abandoned
+  if (messageType == WebSocketMessageType::Text || messageType == WebSocketMessageType::Binary) {
+    Buffer* buffer = find(socketId);
+    if (buffer != nullptr) {
+      buffer->receiving = false;
+    }
+  }
+
   m_callback(socketId, messageType, payload, length);
 }
 
@@ -80,80 +88,130 @@ void WebSocketDeFragger::onEvent(const EventCallback& callback) {
 }
 
 void WebSocketDeFragger::clear(uint8_t socketId) {
-  auto it = m_messages.find(socketId);
-  if (it != m_messages.end()) {
-    free(it->second.data);
-    m_messages.erase(it);
+  Buffer* buffer = find(socketId);
+  if (buffer != nullptr) {
+    release(*buffer);
   }
 }
 
 void WebSocketDeFragger::clear() {
-  for (auto it = m_messages.begin(); it != m_messages.end(); ++it) {
-    free(it->second.data);
+  for (Buffer& buffer : m_buffers) {
+    if (buffer.assigned) {
+      release(buffer);
+    }
   }
-  m_messages.clear();
 }
 
-void WebSocketDeFragger::start(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it != m_messages.end()) {
-    auto& message = it->second;
+WebSocketDeFragger::Buffer* WebSocketDeFragger::find(uint8_t socketId) {
+  for (Buffer& buffer : m_buffers) {
+    if (buffer.assigned && buffer.socketId == socketId) {
+      return &buffer;
+    }
+  }
+
+  return nullptr;
+}
+
+WebSocketDeFragger::Buffer* WebSocketDeFragger::acquire(uint8_t socketId) {
+  Buffer* buffer = find(socketId);
+  if (buffer != nullptr) {
+    return buffer;
+  }
 
-    if (message.capacity < length) {
-      message.data     = _reallocOrFree(message.data, length);
-      message.capacity = length;
+  for (Buffer& candidate : m_buffers) {
+    if (!candidate.assigned) {
+      candidate.assigned = true;
+      candidate.socketId = socketId;
+      return &candidate;
     }
+  }
 
-    memcpy(message.data, data, length);
-    message.size = length;
+  return nullptr;
+}
 
-    return;
+bool WebSocketDeFragger::reserve(Buffer& buffer, uint32_t size) {
+  if (size <= buffer.capacity) {
+    return true;
+  }
+
+  if (size > m_maxMessageSize) {
+    return false;
   }
 
-  Message message {.data = reinterpret_cast<uint8_t*>(malloc(length)), .size = length, .capacity = length, .type = type};
+  // Grow in powers of two, so a message arriving in many small fragments only reallocates a handful of times
+  uint32_t capacity = std::max(buffer.capacity, DEFRAGGER_MIN_CAPACITY);
+  while (capacity < size) {
+    capacity *= 2;
+  }
+  capacity = std::min(capacity, m_maxMessageSize);
+
+  void* data = realloc(buffer.data, capacity);
+  if (data == nullptr) {
+    return false;  // The old buffer is still valid and stays with the socket
+  }
 
-  memcpy(message.data, data, length);
+  buffer.data     = reinterpret_cast<uint8_t*>(data);
+  buffer.capacity = capacity;
+
+  return true;
+}
 
-  m_messages.insert(std::make_pair(socketId, message));
+void WebSocketDeFragger::release(Buffer& buffer) {
+  free(buffer.data);
+  buffer = {};
 }
 
-void WebSocketDeFragger::append(uint8_t socketId, const uint8_t* data, uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it == m_messages.end()) {
+void WebSocketDeFragger::fail(uint8_t socketId, const char* message) {
+  OS_LOGW(TAG, "Socket %u: %s", socketId, message);
+  m_callback(socketId, WebSocketMessageType::Error, reinterpret_cast<const uint8_t*>(message), strlen(message));
+}
+
+void WebSocketDeFragger::start(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length) {
+  Buffer* buffer = acquire(socketId);
+  if (buffer == nullptr) {
+    fail(socketId, "No buffer left for fragmented message");
     return;
   }
 
-  auto& message = it->second;
-
-  uint32_t newLength = message.size + length;
-  if (message.capacity < newLength) {
-    message.data     = _reallocOrFree(message.data, newLength);
-    message.capacity = newLength;
+  if (!reserve(*buffer, length)) {
+    buffer->receiving = false;
+    fail(socketId, "Fragmented message is too large");
+    return;
   }
 
-  memcpy(message.data + message.size, data, length);
-  message.size = newLength;
+  memcpy(buffer->data, data, length);
+  buffer->size      = length;
+  buffer->type      = type;
+  buffer->receiving = true;
 }
 
-void WebSocketDeFragger::finish(uint8_t socketId, const uint8_t* data, uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it == m_messages.end()) {
+void WebSocketDeFragger::append(uint8_t socketId, const uint8_t* data, uint32_t length, bool fin) {
+  Buffer* buffer = find(socketId);
+  if (buffer == nullptr || !buffer->receiving) {
+    return;  // The start was dropped, so is the rest of the message
+  }
+
+  uint32_t size = buffer->size + length;
+  if (size < buffer->size || !reserve(*buffer, size)) {
+    buffer->receiving = false;
+    fail(socketId, "Fragmented message is too large");
     return;
   }
 
-  auto& message = it->second;
+  memcpy(buffer->data + buffer->size, data, length);
+  buffer->size = size;
 
-  uint32_t newLength = message.size + length;
-  if (message.capacity < newLength) {
-    message.data     = _reallocOrFree(message.data, newLength);
-    message.capacity = newLength;
+  if (!fin) {
+    return;
   }
 
-  memcpy(message.data + message.size, data, length);
-  message.size = newLength;
+  buffer->receiving = false;
 
-  m_callback(socketId, message.type, message.data, message.size);
+  m_callback(socketId, buffer->type, buffer->data, buffer->size);
 
-  free(message.data);
-  m_messages.erase(it);
+  // The callback might have cleared the socket
+  buffer = find(socketId);
+  if (buffer != nullptr && buffer->capacity > m_retainCapacity) {
+    release(*buffer);
+  }
 }
@@ -11,13 +11,15 @@ BackendConfig::BackendConfig()
   : domain(OPENSHOCK_API_DOMAIN)
   , authToken()
   , lcgOverride()
+  , lcgCache()
 {
 }
 
-BackendConfig::BackendConfig(std::string_view domain, std::string_view authToken, std::string_view lcgOverride)
+BackendConfig::BackendConfig(std::string_view domain, std::string_view authToken, std::string_view lcgOverride, std::string_view lcgCache)
   : domain(domain)
   , authToken(authToken)
   , lcgOverride(lcgOverride)
+  , lcgCache(lcgCache)
 {
 }
 
@@ -25,6 +27,7 @@ void BackendConfig::ToDefault() {
   domain = OPENSHOCK_API_DOMAIN;
   authToken.clear();
   lcgOverride.clear();
+  lcgCache.clear();
 }
 
 bool BackendConfig::FromFlatbuffers(const Serialization::Configuration::BackendConfig* config) {
@@ -37,6 +40,7 @@ bool BackendConfig::FromFlatbuffers(const Serialization::Configuration::BackendC
   Internal::Utils::FromFbsStr(domain, config->domain(), OPENSHOCK_API_DOMAIN);
   Internal::Utils::FromFbsStr(authToken, config->auth_token(), "");
   Internal::Utils::FromFbsStr(lcgOverride, config->lcg_override(), "");
+  Internal::Utils::FromFbsStr(lcgCache, config->lcg_cache(), "");
 
   return true;
 }
@@ -52,8 +56,9 @@ flatbuffers::Offset<OpenShock::Serialization::Configuration::BackendConfig> Back
   }
 
   auto lcgOverrideOffset = builder.CreateString(lcgOverride);
+  auto lcgCacheOffset    = builder.CreateString(lcgCache);
 
-  return Serialization::Configuration::CreateBackendConfig(builder, domainOffset, authTokenOffset, lcgOverrideOffset);
+  return Serialization::Configuration::CreateBackendConfig(builder, domainOffset, authTokenOffset, lcgOverrideOffset, lcgCacheOffset);
 }
 
 bool BackendConfig::FromJSON(const cJSON* json) {
@@ -71,6 +76,7 @@ bool BackendConfig::FromJSON(const cJSON* json) {
   Internal::Utils::FromJsonStr(domain, json, "domain", OPENSHOCK_API_DOMAIN);
   Internal::Utils::FromJsonStr(authToken, json, "authToken", "");
   Internal::Utils::FromJsonStr(lcgOverride, json, "lcgOverride", "");
+  Internal::Utils::FromJsonStr(lcgCache, json, "lcgCache", "");
 
   return true;
 }
@@ -85,6 +91,7 @@ cJSON* BackendConfig::ToJSON(bool withSensitiveData) const {
   }
 
   cJSON_AddStringToObject(root, "lcgOverride", lcgOverride.c_str());
+  cJSON_AddStringToObject(root, "lcgCache", lcgCache.c_str());
 
   return root;
 }
@@ -428,6 +428,40 @@ bool Config::SetRFConfigTxPin(gpio_num_t txPin)
   return _trySaveConfig();
 }
 
+bool Config::GetRFConfigExtraTxPins(std::vector<gpio_num_t>& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.rf.extraTxPins;
+
+  return true;
+}
+
+bool Config::SetRFConfigExtraTxPins(const std::vector<gpio_num_t>& extraTxPins)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  _configData.rf.extraTxPins = extraTxPins;
+  return _trySaveConfig();
+}
+
+bool Config::GetRFConfigRoutes(std::vector<Config::RFRoute>& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.rf.routes;
+
+  return true;
+}
+
+bool Config::SetRFConfigRoutes(const std::vector<Config::RFRoute>& routes)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  _configData.rf.routes = routes;
+  return _trySaveConfig();
+}
+
 bool Config::GetRFConfigKeepAliveEnabled(bool& out)
 {
   CONFIG_LOCK_READ(false);
@@ -445,6 +479,62 @@ bool Config::SetRFConfigKeepAliveEnabled(bool enabled)
   return _trySaveConfig();
 }
 
+bool Config::GetRFConfigQueuePolicy(RFQueuePolicy& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.rf.queuePolicy;
+
+  return true;
+}
+
+bool Config::SetRFConfigQueuePolicy(RFQueuePolicy policy)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  _configData.rf.queuePolicy = policy;
+  return _trySaveConfig();
+}
+
+bool Config::GetRFConfigShockers(std::vector<Config::RegisteredShocker>& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.rf.shockers;
+
+  return true;
+}
+
+bool Config::SetRFConfigShockers(const std::vector<Config::RegisteredShocker>& shockers)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  // Set on every gateway connect, skip the flash write when nothing changed
+  if (_configData.rf.shockers == shockers) {
+    return true;
+  }
+
+  _configData.rf.shockers = shockers;
+  return _trySaveConfig();
+}
+
+bool Config::GetRFConfigRepeatIntervals(std::vector<Config::RFRepeatInterval>& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.rf.repeatIntervals;
+
+  return true;
+}
+
+bool Config::SetRFConfigRepeatIntervals(const std::vector<Config::RFRepeatInterval>& repeatIntervals)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  _configData.rf.repeatIntervals = repeatIntervals;
+  return _trySaveConfig();
+}
+
 bool Config::AnyWiFiCredentials(std::function<bool(const Config::WiFiCredentials&)> predicate)
 {
   CONFIG_LOCK_READ(false);
@@ -602,6 +692,7 @@ bool Config::SetBackendDomain(std::string_view domain)
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.domain = std::string(domain);
+  _configData.backend.lcgCache.clear();  // Assigned by the previous backend
   return _trySaveConfig();
 }
 
@@ -626,6 +717,7 @@ bool Config::SetBackendAuthToken(std::string_view token)
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.authToken = std::string(token);
+  _configData.backend.lcgCache.clear();  // Assigned to the previous token
   return _trySaveConfig();
 }
 
@@ -634,6 +726,7 @@ bool Config::ClearBackendAuthToken()
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.authToken.clear();
+  _configData.backend.lcgCache.clear();
   return _trySaveConfig();
 }
 
@@ -669,6 +762,40 @@ bool Config::ClearBackendLCGOverride()
   return _trySaveConfig();
 }
 
+bool Config::GetBackendLCGCache(std::string& out)
+{
+  CONFIG_LOCK_READ(false);
+
+  out = _configData.backend.lcgCache;
+
+  return true;
+}
+
+bool Config::SetBackendLCGCache(std::string_view fqdn)
+{
+  CONFIG_LOCK_WRITE(false);
+
+  // Usually the same gateway as last time, skip the flash write then
+  if (_configData.backend.lcgCache == fqdn) {
+    return true;
+  }
+
+  _configData.backend.lcgCache = std::string(fqdn);
+  return _trySaveConfig();
+}
+
+bool Config::ClearBackendLCGCache()
+{
+  CONFIG_LOCK_WRITE(false);
+
+  if (_configData.backend.lcgCache.empty()) {
+    return true;
+  }
+
+  _configData.backend.lcgCache.clear();
+  return _trySaveConfig();
+}
+
 bool Config::GetSerialInputConfigEchoEnabled(bool& out)
 {
   CONFIG_LOCK_READ(false);
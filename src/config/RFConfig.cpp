@@ -6,24 +6,51 @@ const char* const TAG = "Config::RFConfig";
 #include "config/internal/utils.h"
 #include "Logging.h"
 
+
 using namespace OpenShock::Config;
 
 RFConfig::RFConfig()
   : txPin(static_cast<gpio_num_t>(OPENSHOCK_RF_TX_GPIO))
+  , extraTxPins()
+  , routes()
   , keepAliveEnabled(true)
+  , queuePolicy(RFQueuePolicy::DropOldest)
+  , shockers()
+  , repeatIntervals()
 {
 }
 
 RFConfig::RFConfig(gpio_num_t txPin, bool keepAliveEnabled)
   : txPin(txPin)
+  , extraTxPins()
+  , routes()
+  , keepAliveEnabled(keepAliveEnabled)
+  , queuePolicy(RFQueuePolicy::DropOldest)
+  , shockers()
+  , repeatIntervals()
+{
+}
+
+RFConfig::RFConfig(gpio_num_t txPin, const std::vector<gpio_num_t>& extraTxPins, const std::vector<RFRoute>& routes, bool keepAliveEnabled)
+  : txPin(txPin)
+  , extraTxPins(extraTxPins)
+  , routes(routes)
   , keepAliveEnabled(keepAliveEnabled)
+  , queuePolicy(RFQueuePolicy::DropOldest)
+  , shockers()
+  , repeatIntervals()
 {
 }
 
 void RFConfig::ToDefault()
 {
-  txPin            = static_cast<gpio_num_t>(OPENSHOCK_RF_TX_GPIO);
+  txPin = static_cast<gpio_num_t>(OPENSHOCK_RF_TX_GPIO);
+  extraTxPins.clear();
+  routes.clear();
   keepAliveEnabled = true;
+  queuePolicy      = RFQueuePolicy::DropOldest;
+  shockers.clear();
+  repeatIntervals.clear();
 }
 
 bool RFConfig::FromFlatbuffers(const Serialization::Configuration::RFConfig* config)
@@ -37,12 +64,87 @@ bool RFConfig::FromFlatbuffers(const Serialization::Configuration::RFConfig* con
   Internal::Utils::FromU8GpioNum(txPin, config->tx_pin(), static_cast<gpio_num_t>(OPENSHOCK_RF_TX_GPIO));
   keepAliveEnabled = config->keepalive_enabled();
 
+  // Unknown policies from a newer firmware fall back to the default
+  queuePolicy = config->queue_policy() == static_cast<uint8_t>(RFQueuePolicy::RejectNew) ? RFQueuePolicy::RejectNew : RFQueuePolicy::DropOldest;
+
+  extraTxPins.clear();
+  if (auto fbsExtraTxPins = config->extra_tx_pins(); fbsExtraTxPins != nullptr) {
+    for (int8_t fbsPin : *fbsExtraTxPins) {
+      gpio_num_t pin;
+      if (Internal::Utils::FromU8GpioNum(pin, fbsPin)) {
+        extraTxPins.push_back(pin);
+      }
+    }
+  }
+
+  routes.clear();
+  if (auto fbsRoutes = config->routes(); fbsRoutes != nullptr) {
+    for (auto fbsRoute : *fbsRoutes) {
+      routes.push_back(RFRoute {
+        .model       = fbsRoute->model(),
+        .transmitter = fbsRoute->transmitter(),
+        .shockerId   = fbsRoute->shocker_id(),
+        .byShockerId = fbsRoute->by_shocker_id(),
+      });
+    }
+  }
+
+  shockers.clear();
+  if (auto fbsShockers = config->shockers(); fbsShockers != nullptr) {
+    for (auto fbsShocker : *fbsShockers) {
+      shockers.push_back(RegisteredShocker {
+        .model     = fbsShocker->model(),
+        .shockerId = fbsShocker->rf_id(),
+      });
+    }
+  }
+
+  repeatIntervals.clear();
+  if (auto fbsRepeatIntervals = config->repeat_intervals(); fbsRepeatIntervals != nullptr) {
+    for (auto fbsRepeatInterval : *fbsRepeatIntervals) {
+      repeatIntervals.push_back(RFRepeatInterval {
+        .model       = fbsRepeatInterval->model(),
+        .shockerId   = fbsRepeatInterval->shocker_id(),
+        .byShockerId = fbsRepeatInterval->by_shocker_id(),
+        .intervalMs  = fbsRepeatInterval->interval_ms(),
+      });
+    }
+  }
+
   return true;
 }
 
 flatbuffers::Offset<OpenShock::Serialization::Configuration::RFConfig> RFConfig::ToFlatbuffers(flatbuffers::FlatBufferBuilder& builder, bool withSensitiveData) const
 {
-  return Serialization::Configuration::CreateRFConfig(builder, txPin, keepAliveEnabled);
+  std::vector<int8_t> fbsExtraTxPins;
+  fbsExtraTxPins.reserve(extraTxPins.size());
+
+  for (gpio_num_t pin : extraTxPins) {
+    fbsExtraTxPins.push_back(static_cast<int8_t>(pin));
+  }
+
+  std::vector<Serialization::Configuration::RFRoute> fbsRoutes;
+  fbsRoutes.reserve(routes.size());
+
+  for (const RFRoute& route : routes) {
+    fbsRoutes.emplace_back(route.model, route.transmitter, route.shockerId, route.byShockerId);
+  }
+
+  std::vector<Serialization::Configuration::RegisteredShocker> fbsShockers;
+  fbsShockers.reserve(shockers.size());
+
+  for (const RegisteredShocker& shocker : shockers) {
+    fbsShockers.emplace_back(shocker.model, shocker.shockerId);
+  }
+
+  std::vector<Serialization::Configuration::RFRepeatInterval> fbsRepeatIntervals;
+  fbsRepeatIntervals.reserve(repeatIntervals.size());
+
+  for (const RFRepeatInterval& repeatInterval : repeatIntervals) {
+    fbsRepeatIntervals.emplace_back(repeatInterval.model, repeatInterval.byShockerId, repeatInterval.shockerId, repeatInterval.intervalMs);
+  }
+
+  return Serialization::Configuration::CreateRFConfigDirect(builder, txPin, keepAliveEnabled, &fbsExtraTxPins, &fbsRoutes, static_cast<uint8_t>(queuePolicy), &fbsShockers, &fbsRepeatIntervals);
 }
 
 bool RFConfig::FromJSON(const cJSON* json)
@@ -61,6 +163,101 @@ bool RFConfig::FromJSON(const cJSON* json)
   Internal::Utils::FromJsonGpioNum(txPin, json, "txPin", static_cast<gpio_num_t>(OPENSHOCK_RF_TX_GPIO));
   Internal::Utils::FromJsonBool(keepAliveEnabled, json, "keepAliveEnabled", true);
 
+  queuePolicy                  = RFQueuePolicy::DropOldest;
+  const cJSON* queuePolicyJson = cJSON_GetObjectItemCaseSensitive(json, "queuePolicy");
+  if (cJSON_IsString(queuePolicyJson) != 0 && !RFQueuePolicyFromString(queuePolicyJson->valuestring, queuePolicy)) {
+    OS_LOGW(TAG, "Invalid queue policy, using drop-oldest");
+  }
+
+  extraTxPins.clear();
+  const cJSON* extraTxPinsJson = cJSON_GetObjectItemCaseSensitive(json, "extraTxPins");
+  if (cJSON_IsArray(extraTxPinsJson) != 0) {
+    const cJSON* pinJson = nullptr;
+    cJSON_ArrayForEach(pinJson, extraTxPinsJson)
+    {
+      gpio_num_t pin;
+      if (cJSON_IsNumber(pinJson) == 0 || pinJson->valueint < 0 || !Internal::Utils::FromU8GpioNum(pin, static_cast<uint8_t>(pinJson->valueint))) {
+        OS_LOGW(TAG, "Ignoring invalid extra TX pin");
+        continue;
+      }
+
+      extraTxPins.push_back(pin);
+    }
+  }
+
+  routes.clear();
+  const cJSON* routesJson = cJSON_GetObjectItemCaseSensitive(json, "routes");
+  if (cJSON_IsArray(routesJson) != 0) {
+    const cJSON* routeJson = nullptr;
+    cJSON_ArrayForEach(routeJson, routesJson)
+    {
+      const cJSON* modelJson = cJSON_GetObjectItemCaseSensitive(routeJson, "model");
+
+      RFRoute route {};
+      if (cJSON_IsString(modelJson) == 0 || !ShockerModelTypeFromString(modelJson->valuestring, route.model)) {
+        OS_LOGW(TAG, "Ignoring route with invalid model");
+        continue;
+      }
+
+      if (!Internal::Utils::FromJsonU8(route.transmitter, routeJson, "transmitter", 0)) {
+        OS_LOGW(TAG, "Ignoring route with invalid transmitter");
+        continue;
+      }
+
+      route.byShockerId = Internal::Utils::FromJsonU16(route.shockerId, routeJson, "shockerId", 0);
+
+      routes.push_back(route);
+    }
+  }
+
+  shockers.clear();
+  const cJSON* shockersJson = cJSON_GetObjectItemCaseSensitive(json, "shockers");
+  if (cJSON_IsArray(shockersJson) != 0) {
+    const cJSON* shockerJson = nullptr;
+    cJSON_ArrayForEach(shockerJson, shockersJson)
+    {
+      const cJSON* modelJson = cJSON_GetObjectItemCaseSensitive(shockerJson, "model");
+
+      RegisteredShocker shocker {};
+      if (cJSON_IsString(modelJson) == 0 || !ShockerModelTypeFromString(modelJson->valuestring, shocker.model)) {
+        OS_LOGW(TAG, "Ignoring shocker with invalid model");
+        continue;
+      }
+
+      if (!Internal::Utils::FromJsonU16(shocker.shockerId, shockerJson, "shockerId", 0)) {
+        OS_LOGW(TAG, "Ignoring shocker with invalid id");
+        continue;
+      }
+
+      shockers.push_back(shocker);
+    }
+  }
+
+  repeatIntervals.clear();
+  const cJSON* repeatIntervalsJson = cJSON_GetObjectItemCaseSensitive(json, "repeatIntervals");
+  if (cJSON_IsArray(repeatIntervalsJson) != 0) {
+    const cJSON* repeatIntervalJson = nullptr;
+    cJSON_ArrayForEach(repeatIntervalJson, repeatIntervalsJson)
+    {
+      const cJSON* modelJson = cJSON_GetObjectItemCaseSensitive(repeatIntervalJson, "model");
+
+      RFRepeatInterval repeatInterval {};
+      if (cJSON_IsString(modelJson) == 0 || !ShockerModelTypeFromString(modelJson->valuestring, repeatInterval.model)) {
+        OS_LOGW(TAG, "Ignoring repeat interval with invalid model");
+        continue;
+      }
+
+      if (!Internal::Utils::FromJsonU16(repeatInterval.intervalMs, repeatIntervalJson, "intervalMs", 0) || repeatInterval.intervalMs == 0) {
+        OS_LOGW(TAG, "Ignoring repeat interval with invalid interval");
+        continue;
+      }
+
+      repeatInterval.byShockerId = Internal::Utils::FromJsonU16(repeatInterval.shockerId, repeatIntervalJson, "shockerId", 0);
+
+      repeatIntervals.push_back(repeatInterval);
+    }
+  }
+
   return true;
 }
 
@@ -70,6 +267,52 @@ cJSON* RFConfig::ToJSON(bool withSensitiveData) const
 
   cJSON_AddNumberToObject(root, "txPin", static_cast<int>(txPin));  //-V2564
   cJSON_AddBoolToObject(root, "keepAliveEnabled", keepAliveEnabled);
+  cJSON_AddStringToObject(root, "queuePolicy", RFQueuePolicyToString(queuePolicy));
+
+  cJSON* extraTxPinsJson = cJSON_CreateArray();
+  for (gpio_num_t pin : extraTxPins) {
+    cJSON_AddItemToArray(extraTxPinsJson, cJSON_CreateNumber(static_cast<int>(pin)));  //-V2564
+  }
+  cJSON_AddItemToObject(root, "extraTxPins", extraTxPinsJson);
+
+  cJSON* routesJson = cJSON_CreateArray();
+  for (const RFRoute& route : routes) {
+    cJSON* routeJson = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(routeJson, "model", Serialization::Types::EnumNameShockerModelType(route.model));
+    cJSON_AddNumberToObject(routeJson, "transmitter", route.transmitter);
+    if (route.byShockerId) {
+      cJSON_AddNumberToObject(routeJson, "shockerId", route.shockerId);
+    }
+
+    cJSON_AddItemToArray(routesJson, routeJson);
+  }
+  cJSON_AddItemToObject(root, "routes", routesJson);
+
+  cJSON* shockersJson = cJSON_CreateArray();
+  for (const RegisteredShocker& shocker : shockers) {
+    cJSON* shockerJson = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(shockerJson, "model", Serialization::Types::EnumNameShockerModelType(shocker.model));
+    cJSON_AddNumberToObject(shockerJson, "shockerId", shocker.shockerId);
+
+    cJSON_AddItemToArray(shockersJson, shockerJson);
+  }
+  cJSON_AddItemToObject(root, "shockers", shockersJson);
+
+  cJSON* repeatIntervalsJson = cJSON_CreateArray();
+  for (const RFRepeatInterval& repeatInterval : repeatIntervals) {
+    cJSON* repeatIntervalJson = cJSON_CreateObject();
+
+    cJSON_AddStringToObject(repeatIntervalJson, "model", Serialization::Types::EnumNameShockerModelType(repeatInterval.model));
+    if (repeatInterval.byShockerId) {
+      cJSON_AddNumberToObject(repeatIntervalJson, "shockerId", repeatInterval.shockerId);
+    }
+    cJSON_AddNumberToObject(repeatIntervalJson, "intervalMs", repeatInterval.intervalMs);
+
+    cJSON_AddItemToArray(repeatIntervalsJson, repeatIntervalJson);
+  }
+  cJSON_AddItemToObject(root, "repeatIntervals", repeatIntervalsJson);
 
   return root;
 }
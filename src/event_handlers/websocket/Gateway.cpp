@@ -4,6 +4,7 @@ const char* const TAG = "ServerMessageHandlers";
 
 #include "event_handlers/impl/WSGateway.h"
 
+#include "LatencyTrace.h"
 #include "Logging.h"
 
 #include "serialization/_fbs/GatewayToHubMessage_generated.h"
@@ -30,6 +31,10 @@ static std::array<Handlers::HandlerType, HANDLER_COUNT> s_serverHandlers = []()
   SET_HANDLER(PayloadType::ShockerCommandList, Handlers::HandleShockerCommandList);
   SET_HANDLER(PayloadType::CaptivePortalConfig, Handlers::HandleCaptivePortalConfig);
   SET_HANDLER(PayloadType::OtaInstall, Handlers::HandleOtaInstall);
+  SET_HANDLER(PayloadType::ShockerGroupDefine, Handlers::HandleShockerGroupDefine);
+  SET_HANDLER(PayloadType::ShockerGroupCommand, Handlers::HandleShockerGroupCommand);
+  SET_HANDLER(PayloadType::ShockerWaveform, Handlers::HandleShockerWaveform);
+  SET_HANDLER(PayloadType::KeepAliveEcho, Handlers::HandleKeepAliveEcho);
 
   return handlers;
 }();
@@ -44,7 +49,7 @@ void EventHandlers::WebSocket::HandleGatewayBinary(const uint8_t* data, std::siz
 
   // Validate buffer
   flatbuffers::Verifier::Options verifierOptions {
-    .max_size = 4096,  // TODO: Profile this
+    .max_size = EventHandlers::WebSocket::kMaxGatewayMessageSize,
   };
   flatbuffers::Verifier verifier(data, len, verifierOptions);
   if (!msg->Verify(verifier)) {
@@ -52,6 +57,8 @@ void EventHandlers::WebSocket::HandleGatewayBinary(const uint8_t* data, std::siz
     return;
   }
 
+  LatencyTrace::Mark(LatencyTrace::Stage::Verify);
+
   if (msg->payload_type() < PayloadType::MIN || msg->payload_type() > PayloadType::MAX) {
     Handlers::HandleInvalidMessage(msg);
     return;
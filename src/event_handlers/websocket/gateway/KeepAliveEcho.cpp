@@ -0,0 +1,30 @@
+#include "event_handlers/impl/WSGateway.h"
+
+const char* const TAG = "ServerMessageHandlers";
+
+#include "ClockSync.h"
+#include "Logging.h"
+#include "Time.h"
+
+#include <cstdint>
+
+using namespace OpenShock::MessageHandlers::Server;
+
+void _Private::HandleKeepAliveEcho(const OpenShock::Serialization::Gateway::GatewayToHubMessage* root) {
+  auto msg = root->payload_as_KeepAliveEcho();
+  if (msg == nullptr) {
+    OS_LOGE(TAG, "Payload cannot be parsed as KeepAliveEcho");
+    return;
+  }
+
+  int64_t sentAt      = static_cast<int64_t>(msg->uptime());
+  int64_t gatewayTime = static_cast<int64_t>(msg->gateway_time());
+  int64_t receivedAt  = OpenShock::millis();
+
+  if (!OpenShock::ClockSync::AddSample(sentAt, gatewayTime, receivedAt)) {
+    OS_LOGW(TAG, "Ignoring implausible keep-alive echo (sent at %lld, now %lld)", sentAt, receivedAt);
+    return;
+  }
+
+  OS_LOGV(TAG, "Keep-alive round trip took %lld ms", receivedAt - sentAt);
+}
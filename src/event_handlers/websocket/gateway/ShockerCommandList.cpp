@@ -10,6 +10,9 @@ const char* const TAG = "ServerMessageHandlers";
 
 using namespace OpenShock::MessageHandlers::Server;
 
+// Commands are a vector of fixed-size structs, not tables, so verifying a list is one bounds check and decoding it a linear scan, keep it that way when touching the schema
+static_assert(sizeof(OpenShock::Serialization::Gateway::ShockerCommand) == 8, "ShockerCommand must stay an 8 byte flatbuffers struct");
+
 void _Private::HandleShockerCommandList(const OpenShock::Serialization::Gateway::GatewayToHubMessage* root) {
   auto msg = root->payload_as_ShockerCommandList();
   if (msg == nullptr) {
@@ -23,8 +26,9 @@ void _Private::HandleShockerCommandList(const OpenShock::Serialization::Gateway:
     return;
   }
 
-  OS_LOGV(TAG, "Received command list from API (%u commands)", commands->size());
+  OS_LOGV(TAG, "Received command list from API (%u commands, execute at %llu)", commands->size(), msg->execute_at());
 
+#if OPENSHOCK_LOG_LEVEL >= OPENSHOCK_LOG_LEVEL_VERBOSE
   for (auto command : *commands) {
     uint16_t id                   = command->id();
     uint8_t intensity             = command->intensity();
@@ -36,9 +40,11 @@ void _Private::HandleShockerCommandList(const OpenShock::Serialization::Gateway:
     const char* typeStr  = OpenShock::Serialization::Types::EnumNameShockerCommandType(type);
 
     OS_LOGV(TAG, "   ID %u, Intensity %u, Duration %u, Model %s, Type %s", id, intensity, durationMs, modelStr, typeStr);
+  }
+#endif
 
-    if (!OpenShock::CommandHandler::HandleCommand(model, id, type, intensity, durationMs)) {
-      OS_LOGE(TAG, "Remote command failed/rejected!");
-    }
+  std::size_t accepted = OpenShock::CommandHandler::HandleCommandList(*commands, static_cast<int64_t>(msg->execute_at()));
+  if (accepted != commands->size()) {
+    OS_LOGE(TAG, "Remote command failed/rejected! (%zu of %u commands accepted)", accepted, commands->size());
   }
 }
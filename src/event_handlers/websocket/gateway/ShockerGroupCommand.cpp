@@ -0,0 +1,24 @@
+#include "event_handlers/impl/WSGateway.h"
+
+const char* const TAG = "ServerMessageHandlers";
+
+#include "CommandHandler.h"
+#include "Logging.h"
+
+#include <cstdint>
+
+using namespace OpenShock::MessageHandlers::Server;
+
+void _Private::HandleShockerGroupCommand(const OpenShock::Serialization::Gateway::GatewayToHubMessage* root) {
+  auto msg = root->payload_as_ShockerGroupCommand();
+  if (msg == nullptr) {
+    OS_LOGE(TAG, "Payload cannot be parsed as ShockerGroupCommand");
+    return;
+  }
+
+  OS_LOGV(TAG, "Received group command from API: group %u, intensity %u, duration %u, type %s", msg->group(), msg->intensity(), msg->duration(), OpenShock::Serialization::Types::EnumNameShockerCommandType(msg->type()));
+
+  if (!OpenShock::CommandHandler::HandleGroupCommand(msg->group(), msg->type(), msg->intensity(), msg->duration())) {
+    OS_LOGE(TAG, "Remote group command failed/rejected! (group %u)", msg->group());
+  }
+}
@@ -0,0 +1,40 @@
+#include "event_handlers/impl/WSGateway.h"
+
+const char* const TAG = "ServerMessageHandlers";
+
+#include "Logging.h"
+#include "ShockerGroups.h"
+
+#include <array>
+#include <cstdint>
+
+using namespace OpenShock::MessageHandlers::Server;
+
+void _Private::HandleShockerGroupDefine(const OpenShock::Serialization::Gateway::GatewayToHubMessage* root) {
+  auto msg = root->payload_as_ShockerGroupDefine();
+  if (msg == nullptr) {
+    OS_LOGE(TAG, "Payload cannot be parsed as ShockerGroupDefine");
+    return;
+  }
+
+  std::array<OpenShock::ShockerGroups::Member, OpenShock::ShockerGroups::kMaxMembers> members;
+  std::size_t count = 0;
+
+  if (auto fbsMembers = msg->members(); fbsMembers != nullptr) {
+    if (fbsMembers->size() > members.size()) {
+      OS_LOGE(TAG, "Group %u has too many members (%u, max %zu)", msg->id(), fbsMembers->size(), members.size());
+      return;
+    }
+
+    for (auto fbsMember : *fbsMembers) {
+      members[count++] = {.model = fbsMember->model(), .shockerId = fbsMember->id()};
+    }
+  }
+
+  if (!OpenShock::ShockerGroups::Define(msg->id(), members.data(), count)) {
+    OS_LOGE(TAG, "Failed to define group %u, all %zu group slots are taken", msg->id(), OpenShock::ShockerGroups::kMaxGroups);
+    return;
+  }
+
+  OS_LOGD(TAG, "Group %u defined with %zu members", msg->id(), count);
+}
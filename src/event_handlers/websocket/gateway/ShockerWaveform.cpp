@@ -0,0 +1,33 @@
+#include "event_handlers/impl/WSGateway.h"
+
+const char* const TAG = "ServerMessageHandlers";
+
+#include "CommandHandler.h"
+#include "Logging.h"
+#include "radio/Waveform.h"
+
+#include <cstdint>
+
+using namespace OpenShock::MessageHandlers::Server;
+
+void _Private::HandleShockerWaveform(const OpenShock::Serialization::Gateway::GatewayToHubMessage* root) {
+  auto msg = root->payload_as_ShockerWaveform();
+  if (msg == nullptr) {
+    OS_LOGE(TAG, "Payload cannot be parsed as ShockerWaveform");
+    return;
+  }
+
+  auto encoded = msg->waveform();
+
+  OpenShock::Waveform waveform;
+  if (!OpenShock::Waveform::Parse(encoded->data(), encoded->size(), waveform)) {
+    OS_LOGE(TAG, "Malformed waveform for shocker %u (%u bytes)", msg->id(), encoded->size());
+    return;
+  }
+
+  OS_LOGV(TAG, "Received waveform from API: %u %u, %hhu keyframes over %u ms", msg->model(), msg->id(), waveform.keyframeCount, waveform.DurationMs());
+
+  if (!OpenShock::CommandHandler::HandleWaveform(msg->model(), msg->id(), waveform)) {
+    OS_LOGE(TAG, "Remote waveform failed/rejected! (shocker %u)", msg->id());
+  }
+}
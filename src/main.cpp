@@ -111,7 +111,7 @@ void main_app(void* arg)
   while (true) {
     OpenShock::GatewayConnectionManager::Update();
 
-    vTaskDelay(5);  // 5 ticks update interval
+    OpenShock::GatewayConnectionManager::WaitForActivity();
   }
 }
 
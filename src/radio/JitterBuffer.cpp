@@ -0,0 +1,66 @@
+#include "radio/JitterBuffer.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace OpenShock;
+
+JitterBuffer::JitterBuffer()
+  : m_commands()
+  , m_count(0)
+{
+}
+
+bool JitterBuffer::Push(RFCommand* command)
+{
+  if (m_count >= m_commands.size()) {
+    return false;
+  }
+
+  // Insert after every command that executes at the same time or earlier
+  std::size_t index = m_count;
+  while (index > 0 && m_commands[index - 1]->executeAt > command->executeAt) {
+    m_commands[index] = m_commands[index - 1];
+    --index;
+  }
+
+  m_commands[index] = command;
+  ++m_count;
+
+  return true;
+}
+
+int64_t JitterBuffer::NextRelease() const
+{
+  return m_count == 0 ? std::numeric_limits<int64_t>::max() : m_commands[0]->executeAt;
+}
+
+RFCommand* JitterBuffer::PopDue(int64_t now)
+{
+  if (m_count == 0 || m_commands[0]->executeAt > now) {
+    return nullptr;
+  }
+
+  return removeAt(0);
+}
+
+RFCommand* JitterBuffer::PopShocker(uint16_t shockerId)
+{
+  for (std::size_t i = 0; i < m_count; ++i) {
+    if (m_commands[i]->shockerId == shockerId) {
+      return removeAt(i);
+    }
+  }
+
+  return nullptr;
+}
+
+RFCommand* JitterBuffer::removeAt(std::size_t index)
+{
+  RFCommand* command = m_commands[index];
+
+  std::copy(m_commands.begin() + index + 1, m_commands.begin() + m_count, m_commands.begin() + index);
+  --m_count;
+
+  return command;
+}
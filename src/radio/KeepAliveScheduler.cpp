@@ -0,0 +1,133 @@
+#include "radio/KeepAliveScheduler.h"
+
+#include <limits>
+
+using namespace OpenShock;
+
+KeepAliveScheduler::KeepAliveScheduler(int64_t interval, int64_t stagger)
+  : m_interval(interval)
+  , m_stagger(stagger)
+  , m_heap()
+  , m_positions()
+{
+}
+
+void KeepAliveScheduler::Touch(ShockerModelType model, uint16_t shockerId, int64_t activity)
+{
+  int64_t deadline = deadlineFor(shockerId, activity);
+
+  auto it = m_positions.find(shockerId);
+  if (it != m_positions.end()) {
+    Entry& entry        = m_heap[it->second];
+    entry.shocker.model = model;
+
+    // Activity reported out of order must not push the keep-alive back
+    if (deadline > entry.deadline) {
+      update(it->second, deadline);
+    }
+    return;
+  }
+
+  std::size_t index = m_heap.size();
+  m_heap.push_back(Entry {
+    .deadline = deadline,
+    .shocker  = {.model = model, .shockerId = shockerId},
+  });
+  m_positions[shockerId] = index;
+
+  siftUp(index);
+}
+
+int64_t KeepAliveScheduler::NextDeadline() const
+{
+  if (m_heap.empty()) {
+    return std::numeric_limits<int64_t>::max();
+  }
+
+  return m_heap.front().deadline;
+}
+
+std::size_t KeepAliveScheduler::TakeDue(int64_t now, Shocker* out, std::size_t maxCount)
+{
+  std::size_t count = 0;
+  while (count < maxCount && !m_heap.empty() && m_heap.front().deadline <= now) {
+    out[count++] = m_heap.front().shocker;
+
+    update(0, deadlineFor(m_heap.front().shocker.shockerId, now));
+  }
+
+  return count;
+}
+
+int64_t KeepAliveScheduler::deadlineFor(uint16_t shockerId, int64_t activity) const
+{
+  if (m_stagger <= 0) {
+    return activity + m_interval;
+  }
+
+  // Fibonacci hashing spreads neighbouring shocker IDs over the whole stagger window
+  uint32_t hash = (static_cast<uint32_t>(shockerId) * 2'654'435'761U) >> 16;
+
+  return activity + m_interval - static_cast<int64_t>(hash % static_cast<uint32_t>(m_stagger));
+}
+
+void KeepAliveScheduler::update(std::size_t index, int64_t deadline)
+{
+  int64_t previous       = m_heap[index].deadline;
+  m_heap[index].deadline = deadline;
+
+  if (deadline < previous) {
+    siftUp(index);
+  } else {
+    siftDown(index);
+  }
+}
+
+void KeepAliveScheduler::place(std::size_t index, const Entry& entry)
+{
+  m_heap[index]                        = entry;
+  m_positions[entry.shocker.shockerId] = index;
+}
+
+void KeepAliveScheduler::siftUp(std::size_t index)
+{
+  Entry entry = m_heap[index];
+
+  while (index > 0) {
+    std::size_t parent = (index - 1) / 2;
+    if (m_heap[parent].deadline <= entry.deadline) {
+      break;
+    }
+
+    place(index, m_heap[parent]);
+    index = parent;
+  }
+
+  place(index, entry);
+}
+
+void KeepAliveScheduler::siftDown(std::size_t index)
+{
+  std::size_t count = m_heap.size();
+  Entry entry       = m_heap[index];
+
+  while (true) {
+    std::size_t child = index * 2 + 1;
+    if (child >= count) {
+      break;
+    }
+
+    if (child + 1 < count && m_heap[child + 1].deadline < m_heap[child].deadline) {
+      ++child;
+    }
+
+    if (entry.deadline <= m_heap[child].deadline) {
+      break;
+    }
+
+    place(index, m_heap[child]);
+    index = child;
+  }
+
+  place(index, entry);
+}
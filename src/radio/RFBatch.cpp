@@ -0,0 +1,40 @@
+#include "radio/RFBatch.h"
+
+using namespace OpenShock;
+
+void RFBatch::Append(RFCommand* command)
+{
+  command->next = nullptr;
+
+  if (tail == nullptr) {
+    head = command;
+  } else {
+    tail->next = command;
+  }
+  tail = command;
+  ++size;
+}
+
+RFBatch RFBatch::RemoveShocker(uint16_t shockerId)
+{
+  RFBatch removed = {};
+
+  RFCommand* cmd = head;
+  head           = nullptr;
+  tail           = nullptr;
+  size           = 0;
+
+  while (cmd != nullptr) {
+    RFCommand* next = cmd->next;
+
+    if (cmd->shockerId == shockerId) {
+      removed.Append(cmd);
+    } else {
+      Append(cmd);
+    }
+
+    cmd = next;
+  }
+
+  return removed;
+}
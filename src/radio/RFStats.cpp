@@ -0,0 +1,243 @@
+#include "radio/RFStats.h"
+
+#include "Time.h"
+
+#include <algorithm>
+
+using namespace OpenShock;
+
+static uint32_t nowMs()
+{
+  return static_cast<uint32_t>(OpenShock::millis());
+}
+
+static void writeU8(std::vector<uint8_t>& out, uint8_t value)
+{
+  out.push_back(value);
+}
+
+static void writeU16(std::vector<uint8_t>& out, uint16_t value)
+{
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void writeU32(std::vector<uint8_t>& out, uint32_t value)
+{
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+  out.push_back(static_cast<uint8_t>(value >> 16));
+  out.push_back(static_cast<uint8_t>(value >> 24));
+}
+
+RFStats::RFStats()
+  : m_resetAtMs(nowMs())
+  , m_frames(0)
+  , m_airTimeUs(0)
+  , m_commands(0)
+  , m_queueWaitUs(0)
+  , m_queueWaitMaxUs(0)
+  , m_overwrites(0)
+  , m_drops(0)
+  , m_stops(0)
+  , m_stopLatencyMaxUs(0)
+  , m_stopLatency()
+  , m_shockers()
+{
+}
+
+void RFStats::CountFrame(uint16_t shockerId, uint32_t airTimeUs, uint32_t frames)
+{
+  airTimeUs *= frames;
+
+  m_frames.fetch_add(frames, std::memory_order_relaxed);
+  m_airTimeUs.fetch_add(airTimeUs, std::memory_order_relaxed);
+
+  ShockerSlot* slot = slotFor(shockerId);
+  if (slot != nullptr) {
+    slot->frames.fetch_add(frames, std::memory_order_relaxed);
+    slot->airTimeUs.fetch_add(airTimeUs, std::memory_order_relaxed);
+  }
+}
+
+void RFStats::CountCommand(uint32_t queueWaitUs)
+{
+  m_commands.fetch_add(1, std::memory_order_relaxed);
+  m_queueWaitUs.fetch_add(queueWaitUs, std::memory_order_relaxed);
+
+  uint32_t max = m_queueWaitMaxUs.load(std::memory_order_relaxed);
+  while (queueWaitUs > max && !m_queueWaitMaxUs.compare_exchange_weak(max, queueWaitUs, std::memory_order_relaxed)) { }
+}
+
+void RFStats::CountOverwrite(uint16_t shockerId)
+{
+  m_overwrites.fetch_add(1, std::memory_order_relaxed);
+
+  ShockerSlot* slot = slotFor(shockerId);
+  if (slot != nullptr) {
+    slot->overwrites.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void RFStats::CountDrop(uint16_t shockerId)
+{
+  m_drops.fetch_add(1, std::memory_order_relaxed);
+
+  ShockerSlot* slot = slotFor(shockerId);
+  if (slot != nullptr) {
+    slot->drops.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void RFStats::CountStop(uint32_t latencyUs)
+{
+  m_stops.fetch_add(1, std::memory_order_relaxed);
+
+  std::size_t bucket = std::upper_bound(kStopLatencyBoundsUs.begin(), kStopLatencyBoundsUs.end(), latencyUs) - kStopLatencyBoundsUs.begin();
+  m_stopLatency[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  uint32_t max = m_stopLatencyMaxUs.load(std::memory_order_relaxed);
+  while (latencyUs > max && !m_stopLatencyMaxUs.compare_exchange_weak(max, latencyUs, std::memory_order_relaxed)) { }
+}
+
+RFStats::Totals RFStats::GetTotals() const
+{
+  Totals totals {
+    .elapsedMs        = nowMs() - m_resetAtMs.load(std::memory_order_relaxed),
+    .frames           = m_frames.load(std::memory_order_relaxed),
+    .airTimeUs        = m_airTimeUs.load(std::memory_order_relaxed),
+    .commands         = m_commands.load(std::memory_order_relaxed),
+    .queueWaitUs      = m_queueWaitUs.load(std::memory_order_relaxed),
+    .queueWaitMaxUs   = m_queueWaitMaxUs.load(std::memory_order_relaxed),
+    .overwrites       = m_overwrites.load(std::memory_order_relaxed),
+    .drops            = m_drops.load(std::memory_order_relaxed),
+    .stops            = m_stops.load(std::memory_order_relaxed),
+    .stopLatencyMaxUs = m_stopLatencyMaxUs.load(std::memory_order_relaxed),
+    .stopLatency      = {},
+  };
+
+  for (std::size_t i = 0; i < kStopLatencyBuckets; ++i) {
+    totals.stopLatency[i] = m_stopLatency[i].load(std::memory_order_relaxed);
+  }
+
+  return totals;
+}
+
+std::size_t RFStats::GetShockers(Shocker* out, std::size_t maxCount) const
+{
+  std::size_t count = 0;
+  for (const ShockerSlot& slot : m_shockers) {
+    if (count >= maxCount) {
+      break;
+    }
+
+    uint32_t key = slot.key.load(std::memory_order_acquire);
+    if (key == 0) {
+      break;  // Slots are claimed in order, the rest is free
+    }
+
+    out[count++] = Shocker {
+      .shockerId  = static_cast<uint16_t>(key - 1),
+      .frames     = slot.frames.load(std::memory_order_relaxed),
+      .airTimeUs  = slot.airTimeUs.load(std::memory_order_relaxed),
+      .overwrites = slot.overwrites.load(std::memory_order_relaxed),
+      .drops      = slot.drops.load(std::memory_order_relaxed),
+    };
+  }
+
+  return count;
+}
+
+void RFStats::GetSnapshot(Snapshot& out) const
+{
+  out.totals       = GetTotals();
+  out.shockerCount = static_cast<uint8_t>(GetShockers(out.shockers.data(), out.shockers.size()));
+}
+
+void RFStats::Reset()
+{
+  m_frames.store(0, std::memory_order_relaxed);
+  m_airTimeUs.store(0, std::memory_order_relaxed);
+  m_commands.store(0, std::memory_order_relaxed);
+  m_queueWaitUs.store(0, std::memory_order_relaxed);
+  m_queueWaitMaxUs.store(0, std::memory_order_relaxed);
+  m_overwrites.store(0, std::memory_order_relaxed);
+  m_drops.store(0, std::memory_order_relaxed);
+  m_stops.store(0, std::memory_order_relaxed);
+  m_stopLatencyMaxUs.store(0, std::memory_order_relaxed);
+  for (std::atomic<uint32_t>& bucket : m_stopLatency) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+
+  // Keep the shocker slots claimed, shockers that were seen once are likely to be seen again
+  for (ShockerSlot& slot : m_shockers) {
+    slot.frames.store(0, std::memory_order_relaxed);
+    slot.airTimeUs.store(0, std::memory_order_relaxed);
+    slot.overwrites.store(0, std::memory_order_relaxed);
+    slot.drops.store(0, std::memory_order_relaxed);
+  }
+
+  m_resetAtMs.store(nowMs(), std::memory_order_relaxed);
+}
+
+void RFStats::Serialize(const Snapshot* snapshots, std::size_t count, std::vector<uint8_t>& out)
+{
+  out.clear();
+  out.reserve(2 + count * (43 + kStopLatencyBuckets * 4 + kMaxShockers * 18));
+
+  writeU8(out, kSnapshotVersion);
+  writeU8(out, static_cast<uint8_t>(count));
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const Snapshot& snapshot = snapshots[i];
+    const Totals& totals     = snapshot.totals;
+
+    writeU8(out, snapshot.transmitter);
+    writeU8(out, static_cast<uint8_t>(snapshot.txPin));
+    writeU32(out, totals.elapsedMs);
+    writeU32(out, totals.frames);
+    writeU32(out, totals.airTimeUs);
+    writeU32(out, totals.commands);
+    writeU32(out, totals.queueWaitUs);
+    writeU32(out, totals.queueWaitMaxUs);
+    writeU32(out, totals.overwrites);
+    writeU32(out, totals.drops);
+    writeU32(out, totals.stops);
+    writeU32(out, totals.stopLatencyMaxUs);
+    for (uint32_t bucket : totals.stopLatency) {
+      writeU32(out, bucket);
+    }
+    writeU8(out, snapshot.shockerCount);
+
+    for (std::size_t j = 0; j < snapshot.shockerCount; ++j) {
+      const Shocker& shocker = snapshot.shockers[j];
+
+      writeU16(out, shocker.shockerId);
+      writeU32(out, shocker.frames);
+      writeU32(out, shocker.airTimeUs);
+      writeU32(out, shocker.overwrites);
+      writeU32(out, shocker.drops);
+    }
+  }
+}
+
+RFStats::ShockerSlot* RFStats::slotFor(uint16_t shockerId)
+{
+  uint32_t key = static_cast<uint32_t>(shockerId) + 1;
+
+  for (ShockerSlot& slot : m_shockers) {
+    uint32_t current = slot.key.load(std::memory_order_acquire);
+    if (current == key) {
+      return &slot;
+    }
+
+    if (current == 0) {
+      // Claim the free slot, another task might beat us to it with the same or a different shocker
+      if (slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel) || current == key) {
+        return &slot;
+      }
+    }
+  }
+
+  return nullptr;  // Table is full, only the totals are counted
+}
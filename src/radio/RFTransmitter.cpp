@@ -6,35 +6,57 @@ const char* const TAG = "RFTransmitter";
 
 #include "EStopManager.h"
 
+#include "LatencyTrace.h"
 #include "Logging.h"
 #include "radio/rmt/MainEncoder.h"
+#include "radio/rmt/SequenceCache.h"
+#include "SlabPool.h"
 #include "Time.h"
 #include "util/FnProxy.h"
 #include "util/TaskUtils.h"
 
 #include <freertos/queue.h>
 
-const UBaseType_t RFTRANSMITTER_QUEUE_SIZE   = 64;
-const BaseType_t RFTRANSMITTER_TASK_PRIORITY = 1;
-const uint32_t RFTRANSMITTER_TASK_STACK_SIZE = 4096;  // PROFILED: 1.4KB stack usage
-const float RFTRANSMITTER_TICKRATE_NS        = 1000;
-const int64_t TRANSMIT_END_DURATION          = 300;
+#include <algorithm>
+#include <array>
+
+const UBaseType_t RFTRANSMITTER_QUEUE_SIZE         = 32;  // Every queued batch holds at least one command of the transmitter's 32 slot pool, a deeper queue could never fill
+const UBaseType_t RFTRANSMITTER_STOP_QUEUE_SIZE    = 8;
+const std::size_t RFTRANSMITTER_WAVEFORM_POOL_SIZE = 16;  // 16 * ~100 bytes, one per shocker playing a waveform
+const BaseType_t RFTRANSMITTER_TASK_PRIORITY       = 1;
+const BaseType_t RFTRANSMITTER_STOP_TASK_PRIORITY  = 5;  // Same as the E-Stop checker, held only until pending stops are on air
+const uint32_t RFTRANSMITTER_TASK_STACK_SIZE       = 4096;  // PROFILED: 1.4KB stack usage
+const float RFTRANSMITTER_TICKRATE_NS              = 1000;
+const int64_t RFTRANSMITTER_TX_DONE_MARGIN_US      = 200;  // Slack between the computed end of a frame and starting the next one
+const int64_t RFTRANSMITTER_BURST_MAX_US          = 150'000;  // Bounds how long a new command or stop waits behind a burst, 2 passes of the longest frame
+const std::size_t RFTRANSMITTER_BURST_MAX_PASSES   = 4;
+const rmt_data_t RFTRANSMITTER_BURST_GAP           = {100, 0, 100, 0};  // Low for TX_DONE_MARGIN_US between the passes of a burst
 
 using namespace OpenShock;
 
-struct command_t {
-  int64_t until;
-  std::vector<rmt_data_t> sequence;
-  std::vector<rmt_data_t> zeroSequence;
-  uint16_t shockerId;
-  bool overwrite;
-};
+static OpenShock::SlabPool<Waveform, RFTRANSMITTER_WAVEFORM_POOL_SIZE> s_waveformPool;
+
+static std::atomic<OpenShock::RFQueuePolicy> s_queuePolicy = {OpenShock::RFQueuePolicy::DropOldest};
+
+static_assert(RFTransmitter::kCommandPoolSize == RFTRANSMITTER_QUEUE_SIZE, "The command queue is sized to the command pool");
+static_assert(RFTransmitter::kStopPoolSize == RFTRANSMITTER_STOP_QUEUE_SIZE, "A full stop lane of untracked shockers must fit the stop pool");
 
 RFTransmitter::RFTransmitter(gpio_num_t gpioPin)
   : m_txPin(gpioPin)
   , m_rmtHandle(nullptr)
   , m_queueHandle(nullptr)
+  , m_stopQueueHandle(nullptr)
   , m_taskHandle(nullptr)
+  , m_txDoneTimer(nullptr)
+  , m_scheduler()
+  , m_jitterBuffer()
+  , m_stats()
+  , m_commandPool()
+  , m_stopPool()
+  , m_sendMutex()
+  , m_rejected(0)
+  , m_dropped(0)
+  , m_coalesced(0)
 {
   OS_LOGD(TAG, "[pin-%hhi] Creating RFTransmitter", m_txPin);
 
@@ -48,16 +70,38 @@ RFTransmitter::RFTransmitter(gpio_num_t gpioPin)
   float realTick = rmtSetTick(m_rmtHandle, RFTRANSMITTER_TICKRATE_NS);
   OS_LOGD(TAG, "[pin-%hhi] real tick set to: %fns", m_txPin, realTick);
 
-  m_queueHandle = xQueueCreate(RFTRANSMITTER_QUEUE_SIZE, sizeof(command_t*));
+  m_queueHandle = xQueueCreate(RFTRANSMITTER_QUEUE_SIZE, sizeof(RFCommand*));
   if (m_queueHandle == nullptr) {
     OS_LOGE(TAG, "[pin-%hhi] Failed to create queue", m_txPin);
     destroy();
     return;
   }
 
+  m_stopQueueHandle = xQueueCreate(RFTRANSMITTER_STOP_QUEUE_SIZE, sizeof(StopRequest));
+  if (m_stopQueueHandle == nullptr) {
+    OS_LOGE(TAG, "[pin-%hhi] Failed to create stop queue", m_txPin);
+    destroy();
+    return;
+  }
+
   char name[32];
   snprintf(name, sizeof(name), "RFTransmitter-%u", m_txPin);
 
+  esp_timer_create_args_t timerArgs = {
+    .callback              = &Util::FnProxy<&RFTransmitter::TransmitDone>,
+    .arg                   = this,
+    .dispatch_method       = ESP_TIMER_TASK,
+    .name                  = "rf_tx_done",
+    .skip_unhandled_events = true,
+  };
+
+  if (esp_timer_create(&timerArgs, &m_txDoneTimer) != ESP_OK) {
+    OS_LOGE(TAG, "[pin-%hhi] Failed to create transmit completion timer", m_txPin);
+    m_txDoneTimer = nullptr;
+    destroy();
+    return;
+  }
+
   if (TaskUtils::TaskCreateExpensive(&Util::FnProxy<&RFTransmitter::TransmitTask>, name, RFTRANSMITTER_TASK_STACK_SIZE, this, RFTRANSMITTER_TASK_PRIORITY, &m_taskHandle) != pdPASS) {
     OS_LOGE(TAG, "[pin-%hhi] Failed to create task", m_txPin);
     destroy();
@@ -70,28 +114,185 @@ RFTransmitter::~RFTransmitter()
   destroy();
 }
 
-bool RFTransmitter::SendCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, bool overwriteExisting)
+bool RFTransmitter::SendCommand(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, bool overwriteExisting, uint16_t minRepeatIntervalMs)
+{
+  Batch batch = {};
+  if (!AddToBatch(batch, model, shockerId, type, intensity, durationMs, OpenShock::millis(), overwriteExisting, minRepeatIntervalMs)) {
+    return false;
+  }
+
+  return SendBatch(batch);
+}
+
+bool RFTransmitter::AddToBatch(Batch& batch, ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, uint16_t durationMs, int64_t now, bool overwriteExisting, uint16_t minRepeatIntervalMs)
 {
   if (m_queueHandle == nullptr) {
     OS_LOGE(TAG, "[pin-%hhi] Queue is null", m_txPin);
     return false;
   }
 
-  command_t* cmd = new command_t {.until = OpenShock::millis() + durationMs, .sequence = Rmt::GetSequence(model, shockerId, type, intensity), .zeroSequence = Rmt::GetZeroSequence(model, shockerId), .shockerId = shockerId, .overwrite = overwriteExisting};
+  RFCommand* cmd = m_commandPool.Acquire();
 
-  // We will use nullptr commands to end the task, if we got a nullptr here, we are out of memory... :(
+  // We will use nullptr commands to end the task, if we got a nullptr here, we are out of command slots... :(
   if (cmd == nullptr) {
-    OS_LOGE(TAG, "[pin-%hhi] Failed to allocate command", m_txPin);
+    OS_LOGE(TAG, "[pin-%hhi] Command pool exhausted", m_txPin);
+    m_stats.CountDrop(shockerId);
+    return false;
+  }
+
+  cmd->until               = now + durationMs;
+  cmd->executeAt           = now;
+  cmd->shockerId           = shockerId;
+  cmd->minRepeatIntervalMs = minRepeatIntervalMs;
+  cmd->overwrite           = overwriteExisting;
+  cmd->receivedAtUs        = LatencyTrace::Origin();
+  cmd->waveform            = nullptr;
+  cmd->model               = model;
+  Rmt::SequenceCache::GetSequence(model, shockerId, type, intensity, cmd->sequence);
+  Rmt::SequenceCache::GetZeroSequence(model, shockerId, cmd->zeroSequence);
+
+  batch.Append(cmd);
+
+  return true;
+}
+
+bool RFTransmitter::SendBatch(Batch& batch)
+{
+  if (batch.head == nullptr) {
+    return true;
+  }
+
+  RFCommand* head = batch.head;
+
+  int64_t nowUs = OpenShock::micros();
+  for (RFCommand* cmd = head; cmd != nullptr; cmd = cmd->next) {
+    cmd->queuedAtUs = nowUs;
+  }
+
+  // Waiting for a slot would stall the gateway task behind the radio, a full queue is resolved right away instead
+  bool queued = false;
+  if (m_queueHandle != nullptr) {
+    ScopedLock lock__(&m_sendMutex);
+
+    queued = xQueueSend(m_queueHandle, &head, 0) == pdTRUE || (makeRoom(head) && xQueueSend(m_queueHandle, &head, 0) == pdTRUE);
+  }
+
+  if (!queued) {
+    OS_LOGW(TAG, "[pin-%hhi] Command queue full, rejected %zu command(s)", m_txPin, batch.size);
+    for (RFCommand* cmd = head; cmd != nullptr; cmd = cmd->next) {
+      m_stats.CountDrop(cmd->shockerId);
+    }
+    m_rejected.fetch_add(static_cast<uint32_t>(batch.size), std::memory_order_relaxed);
+    ReleaseBatch(batch);
+    return false;
+  }
+
+  batch = {};
+
+  // Wake the transmit task so it can pick up the commands while the current frame is on air
+  xTaskNotifyGive(m_taskHandle);
+
+  return true;
+}
+
+void RFTransmitter::GetQueueStatus(RFQueueStatus& out) const
+{
+  out.depth     = m_queueHandle != nullptr ? static_cast<uint8_t>(uxQueueMessagesWaiting(m_queueHandle)) : 0;
+  out.capacity  = static_cast<uint8_t>(RFTRANSMITTER_QUEUE_SIZE);
+  out.policy    = s_queuePolicy.load(std::memory_order_relaxed);
+  out.rejected  = m_rejected.load(std::memory_order_relaxed);
+  out.dropped   = m_dropped.load(std::memory_order_relaxed);
+  out.coalesced = m_coalesced.load(std::memory_order_relaxed);
+}
+
+void RFTransmitter::SetQueuePolicy(RFQueuePolicy policy)
+{
+  s_queuePolicy.store(policy, std::memory_order_relaxed);
+}
+
+RFQueuePolicy RFTransmitter::GetQueuePolicy()
+{
+  return s_queuePolicy.load(std::memory_order_relaxed);
+}
+
+void RFTransmitter::releaseCommand(RFCommand* cmd)
+{
+  if (cmd->waveform != nullptr) {
+    s_waveformPool.Release(cmd->waveform);
+  }
+
+  if (m_stopPool.Owns(cmd)) {
+    m_stopPool.Release(cmd);
+  } else {
+    m_commandPool.Release(cmd);
+  }
+}
+
+void RFTransmitter::ReleaseBatch(Batch& batch)
+{
+  RFCommand* cmd = batch.head;
+  while (cmd != nullptr) {
+    RFCommand* next = cmd->next;
+    releaseCommand(cmd);
+    cmd = next;
+  }
+
+  batch = {};
+}
+
+bool RFTransmitter::SendWaveform(ShockerModelType model, uint16_t shockerId, const Waveform& waveform)
+{
+  ShockerCommandType type;
+  uint8_t intensity;
+  if (!waveform.Sample(0, type, intensity)) {
+    OS_LOGE(TAG, "[pin-%hhi] Waveform is empty", m_txPin);
     return false;
   }
 
-  // Add the command to the queue, wait max 10 ms (Adjust this)
-  if (xQueueSend(m_queueHandle, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
-    OS_LOGE(TAG, "[pin-%hhi] Failed to send command to queue", m_txPin);
-    delete cmd;
+  Waveform* pattern = s_waveformPool.Acquire();
+  if (pattern == nullptr) {
+    OS_LOGE(TAG, "[pin-%hhi] Waveform pool exhausted", m_txPin);
+    m_stats.CountDrop(shockerId);
     return false;
   }
 
+  *pattern = waveform;
+
+  int64_t now = OpenShock::millis();
+
+  Batch batch = {};
+  if (!AddToBatch(batch, model, shockerId, type, intensity, 0, now)) {
+    s_waveformPool.Release(pattern);
+    return false;
+  }
+
+  // The first frame is encoded from the start of the waveform, every frame after it is resampled by the transmit task
+  batch.head->until         = now + waveform.DurationMs();
+  batch.head->waveform      = pattern;
+  batch.head->waveformStart = now;
+
+  return SendBatch(batch);
+}
+
+bool RFTransmitter::SendStop(ShockerModelType model, uint16_t shockerId)
+{
+  if (m_stopQueueHandle == nullptr) {
+    OS_LOGE(TAG, "[pin-%hhi] Stop queue is null", m_txPin);
+    return false;
+  }
+
+  StopRequest stop = {.model = model, .shockerId = shockerId, .queuedAtUs = OpenShock::micros()};
+
+  // Never blocks the caller, the stop lane only fills up if the task is stuck, then waiting would not help either
+  if (xQueueSend(m_stopQueueHandle, &stop, 0) != pdTRUE) {
+    OS_LOGE(TAG, "[pin-%hhi] Stop queue full, rejected stop", m_txPin);
+    m_stats.CountDrop(shockerId);
+    m_rejected.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  xTaskNotifyGive(m_taskHandle);
+
   return true;
 }
 
@@ -103,9 +304,10 @@ void RFTransmitter::ClearPendingCommands()
 
   OS_LOGI(TAG, "[pin-%hhi] Clearing pending commands", m_txPin);
 
-  command_t* command;
+  RFCommand* command;
   while (xQueueReceive(m_queueHandle, &command, 0) == pdPASS) {
-    delete command;
+    Batch batch = {.head = command, .tail = nullptr, .size = 0};
+    ReleaseBatch(batch);
   }
 }
 
@@ -115,12 +317,13 @@ void RFTransmitter::destroy()
     OS_LOGD(TAG, "[pin-%hhi] Stopping task", m_txPin);
 
     // Wait for the task to stop
-    command_t* cmd = nullptr;
+    RFCommand* cmd = nullptr;
     while (eTaskGetState(m_taskHandle) != eDeleted) {
       vTaskDelay(pdMS_TO_TICKS(10));
 
       // Send nullptr to stop the task gracefully
       xQueueSend(m_queueHandle, &cmd, pdMS_TO_TICKS(10));
+      xTaskNotifyGive(m_taskHandle);
     }
 
     OS_LOGD(TAG, "[pin-%hhi] Task stopped", m_txPin);
@@ -130,30 +333,289 @@ void RFTransmitter::destroy()
 
     m_taskHandle = nullptr;
   }
+  if (m_txDoneTimer != nullptr) {
+    esp_timer_stop(m_txDoneTimer);
+    esp_timer_delete(m_txDoneTimer);
+    m_txDoneTimer = nullptr;
+  }
   if (m_queueHandle != nullptr) {
     vQueueDelete(m_queueHandle);
     m_queueHandle = nullptr;
   }
+  if (m_stopQueueHandle != nullptr) {
+    vQueueDelete(m_stopQueueHandle);
+    m_stopQueueHandle = nullptr;
+  }
   if (m_rmtHandle != nullptr) {
     rmtDeinit(m_rmtHandle);
     m_rmtHandle = nullptr;
   }
 }
 
+static bool containsShocker(const uint16_t* shockerIds, std::size_t count, uint16_t shockerId)
+{
+  return std::find(shockerIds, shockerIds + count, shockerId) != shockerIds + count;
+}
+
+// Must be called with m_sendMutex held, the transmit task only takes batches out meanwhile so freed slots stay free
+bool RFTransmitter::makeRoom(const RFCommand* incoming)
+{
+  // Everything queued is taken out and put back in order, the transmit task just finds the queue empty in between
+  std::array<RFCommand*, RFTRANSMITTER_QUEUE_SIZE> queued;
+  std::size_t count = 0;
+  while (count < queued.size() && xQueueReceive(m_queueHandle, &queued[count], 0) == pdTRUE) {
+    ++count;
+  }
+
+  RFQueuePolicy policy = s_queuePolicy.load(std::memory_order_relaxed);
+  int64_t now          = OpenShock::millis();
+
+  // Shockers with a newer command that takes over right away, older commands for them would be overwritten the moment they reach the scheduler.
+  // A held command might start before the one replacing it, so only commands that start right away are coalesced.
+  std::array<uint16_t, TransmitScheduler::kMaxShockers> superseding;
+  std::size_t supersedingCount = 0;
+
+  auto collectSuperseding = [&](const RFCommand* cmd) {
+    for (; cmd != nullptr && supersedingCount < superseding.size(); cmd = cmd->next) {
+      if (cmd->overwrite && cmd->executeAt <= now && !containsShocker(superseding.data(), supersedingCount, cmd->shockerId)) {
+        superseding[supersedingCount++] = cmd->shockerId;
+      }
+    }
+  };
+
+  // The incoming batch might still be rejected, then the commands it would replace have to stay
+  if (policy == RFQueuePolicy::DropOldest) {
+    collectSuperseding(incoming);
+  }
+
+  std::array<bool, RFTRANSMITTER_QUEUE_SIZE> removed = {};
+  std::size_t remaining                              = count;
+
+  for (std::size_t i = count; i-- > 0;) {
+    if (queued[i] == nullptr) {
+      continue;  // Stop signal from destroy()
+    }
+
+    RFCommand** link = &queued[i];
+    while (*link != nullptr) {
+      RFCommand* cmd = *link;
+      if (cmd->executeAt > now || !containsShocker(superseding.data(), supersedingCount, cmd->shockerId)) {
+        link = &cmd->next;
+        continue;
+      }
+
+      *link = cmd->next;
+      m_stats.CountOverwrite(cmd->shockerId);
+      m_coalesced.fetch_add(1, std::memory_order_relaxed);
+      releaseCommand(cmd);
+    }
+
+    if (queued[i] == nullptr) {
+      removed[i] = true;
+      --remaining;
+      continue;
+    }
+
+    collectSuperseding(queued[i]);
+  }
+
+  if (remaining == queued.size() && policy == RFQueuePolicy::DropOldest) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (queued[i] == nullptr) {
+        continue;
+      }
+
+      RFCommand* cmd = queued[i];
+      while (cmd != nullptr) {
+        RFCommand* next = cmd->next;
+        m_stats.CountDrop(cmd->shockerId);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        releaseCommand(cmd);
+        cmd = next;
+      }
+
+      removed[i] = true;
+      --remaining;
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (removed[i]) {
+      continue;
+    }
+
+    if (xQueueSend(m_queueHandle, &queued[i], 0) != pdTRUE) {
+      OS_LOGE(TAG, "[pin-%hhi] Failed to put queued commands back, dropping them", m_txPin);
+      for (RFCommand* cmd = queued[i]; cmd != nullptr;) {
+        RFCommand* next = cmd->next;
+        m_stats.CountDrop(cmd->shockerId);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        releaseCommand(cmd);
+        cmd = next;
+      }
+    }
+  }
+
+  return remaining < queued.size();
+}
+
+void RFTransmitter::submitCommand(RFCommand* cmd, int64_t now)
+{
+  // Release whichever command got rejected or replaced
+  RFCommand* released = m_scheduler.Submit(cmd, now);
+  if (released == cmd) {
+    // Commands that may not overwrite (keep-alives) are expected to be rejected while the shocker is busy
+    if (cmd->overwrite) {
+      m_stats.CountDrop(cmd->shockerId);
+    }
+  } else if (released != nullptr) {
+    m_stats.CountOverwrite(cmd->shockerId);
+  }
+
+  if (released != nullptr) {
+    releaseCommand(released);
+  }
+}
+
+void RFTransmitter::sampleWaveform(const RFCommand& cmd, int64_t at, Rmt::Sequence& out)
+{
+  ShockerCommandType type;
+  uint8_t intensity;
+  if (!cmd.waveform->Sample(at - cmd.waveformStart, type, intensity)) {
+    return;  // Playback is over, the command expires on this frame
+  }
+
+  // Encoded directly, a ramp would otherwise cycle every intensity through the sequence cache
+  if (!Rmt::GetSequence(cmd.model, cmd.shockerId, type, intensity, out)) {
+    OS_LOGE(TAG, "[pin-%hhi] Failed to encode waveform frame", m_txPin);
+    out = cmd.sequence;
+  }
+}
+
+bool RFTransmitter::applyStop(const StopRequest& stop, int64_t now)
+{
+  if (m_scheduler.Stop(stop.shockerId, now)) {
+    return true;
+  }
+
+  // Nothing active for this shocker, still send its zero sequence in case it is running on a command we no longer track
+  RFCommand* cmd = m_stopPool.Acquire();
+  if (cmd == nullptr) {
+    cmd = m_commandPool.Acquire();
+  }
+  if (cmd == nullptr) {
+    OS_LOGE(TAG, "[pin-%hhi] Command pool exhausted, can't send stop", m_txPin);
+    m_stats.CountDrop(stop.shockerId);
+    return false;
+  }
+
+  cmd->until               = now - 1;
+  cmd->executeAt           = now;
+  cmd->shockerId           = stop.shockerId;
+  cmd->minRepeatIntervalMs = 0;
+  cmd->overwrite           = true;
+  cmd->queuedAtUs          = stop.queuedAtUs;
+  cmd->receivedAtUs        = 0;
+  cmd->waveform            = nullptr;
+  cmd->model               = stop.model;
+  cmd->next                = nullptr;
+  Rmt::SequenceCache::GetZeroSequence(stop.model, stop.shockerId, cmd->zeroSequence);
+  cmd->sequence = cmd->zeroSequence;
+
+  if (m_scheduler.Submit(cmd, now) != nullptr) {
+    OS_LOGE(TAG, "[pin-%hhi] Scheduler full, can't send stop", m_txPin);
+    releaseCommand(cmd);
+    m_stats.CountDrop(stop.shockerId);
+    return false;
+  }
+
+  return true;
+}
+
 void RFTransmitter::TransmitTask()
 {
   OS_LOGD(TAG, "[pin-%hhi] RMT loop running on core %d", m_txPin, xPortGetCoreID());
 
-  std::vector<command_t*> commands;
+  // Frame N is on air from one buffer while frame N+1 is prepared in the other
+  std::array<Rmt::Sequence, 2> buffers;
+  std::array<uint16_t, 2> bufferShockerIds = {};
+  std::array<bool, 2> bufferIsZero          = {};
+  std::size_t onAirIndex                    = 0;
+  bool prepared                             = false;
+  int64_t airEndUs                          = 0;
+
+  // A command running on its own goes out as a burst of passes in one write, the next write still only happens once the whole burst is done
+  std::array<rmt_data_t, (Rmt::kMaxSequenceLength + 1) * RFTRANSMITTER_BURST_MAX_PASSES> burstBuffer;
+
+  // Stops whose first zero frame has not gone on air yet, for latency accounting
+  std::array<StopRequest, RFTRANSMITTER_STOP_QUEUE_SIZE> pendingStops;
+  std::size_t pendingStopCount = 0;
+
+  // Latest stop per shocker, commands queued before it are purged even when they reach the task later, e.g. after a sender put them back
+  std::array<StopRequest, RFTRANSMITTER_STOP_QUEUE_SIZE> recentStops;
+  std::size_t recentStopCount = 0;
+  std::size_t nextRecentStop  = 0;
+
   while (true) {
+    // Stops are applied before anything else, commands that were queued before them are purged below
+    StopRequest stop;
+    while (xQueueReceive(m_stopQueueHandle, &stop, 0) == pdTRUE) {
+      std::size_t slot = 0;
+      while (slot < recentStopCount && recentStops[slot].shockerId != stop.shockerId) {
+        ++slot;
+      }
+      if (slot == recentStopCount) {
+        if (recentStopCount < recentStops.size()) {
+          ++recentStopCount;
+        } else {
+          slot           = nextRecentStop;
+          nextRecentStop = (nextRecentStop + 1) % recentStops.size();
+        }
+      }
+      recentStops[slot] = stop;
+
+      // Held commands were all queued before the stop
+      RFCommand* held;
+      while ((held = m_jitterBuffer.PopShocker(stop.shockerId)) != nullptr) {
+        m_stats.CountOverwrite(held->shockerId);
+        releaseCommand(held);
+      }
+
+      if (!applyStop(stop, OpenShock::millis())) {
+        continue;
+      }
+
+      // Repeated stops for the same shocker are measured from the first one
+      bool pending = false;
+      for (std::size_t i = 0; i < pendingStopCount; ++i) {
+        pending |= pendingStops[i].shockerId == stop.shockerId;
+      }
+
+      if (!pending && pendingStopCount < pendingStops.size()) {
+        pendingStops[pendingStopCount++] = stop;
+      }
+
+      // The prepared frame is not the zero frame, pick again
+      prepared = false;
+    }
+
+    // Run ahead of other work until the zero frames are on air, dropped back below once they are
+    if (pendingStopCount != 0 && uxTaskPriorityGet(nullptr) != RFTRANSMITTER_STOP_TASK_PRIORITY) {
+      vTaskPrioritySet(nullptr, RFTRANSMITTER_STOP_TASK_PRIORITY);
+    }
+
     // Receive commands
-    command_t* cmd = nullptr;
-    while (xQueueReceive(m_queueHandle, &cmd, commands.empty() ? portMAX_DELAY : 0) == pdTRUE) {
+    RFCommand* cmd = nullptr;
+    while (xQueueReceive(m_queueHandle, &cmd, 0) == pdTRUE) {
       if (cmd == nullptr) {
         OS_LOGD(TAG, "[pin-%hhi] Received nullptr (stop command), cleaning up...", m_txPin);
 
-        for (auto it = commands.begin(); it != commands.end(); ++it) {
-          delete *it;
+        while ((cmd = m_scheduler.PopFinished(OpenShock::millis(), true)) != nullptr) {
+          releaseCommand(cmd);
+        }
+        while ((cmd = m_jitterBuffer.PopDue(INT64_MAX)) != nullptr) {
+          releaseCommand(cmd);
         }
 
         OS_LOGD(TAG, "[pin-%hhi] Cleanup done, stopping task", m_txPin);
@@ -162,71 +624,212 @@ void RFTransmitter::TransmitTask()
         return;
       }
 
-      // Replace the command if it already exists
-      for (auto it = commands.begin(); it != commands.end(); ++it) {
-        const command_t* existingCmd = *it;
+      // Every command of a batch is submitted before the next frame is picked, so they start on the same cycle
+      int64_t now   = OpenShock::millis();
+      int64_t nowUs = OpenShock::micros();
+      while (cmd != nullptr) {
+        RFCommand* next = cmd->next;
+
+        m_stats.CountCommand(static_cast<uint32_t>(nowUs - cmd->queuedAtUs));
+
+        if (cmd->receivedAtUs != 0) {
+          LatencyTrace::Record(LatencyTrace::Stage::Dequeue, static_cast<uint32_t>(nowUs - cmd->queuedAtUs));
+          cmd->dequeuedAtUs = nowUs;
+        }
 
-        if (existingCmd->shockerId == cmd->shockerId) {
-          // Only replace the command if it should be overwritten
-          if (existingCmd->overwrite) {
-            delete *it;
-            *it = cmd;
-          } else {
-            delete cmd;
+        // Purge commands a stop was sent after, only commands sent after the stop may take over again
+        bool stopped = false;
+        for (std::size_t i = 0; i < recentStopCount; ++i) {
+          if (recentStops[i].shockerId == cmd->shockerId && recentStops[i].queuedAtUs >= cmd->queuedAtUs) {
+            stopped = true;
+            break;
           }
+        }
+
+        if (stopped) {
+          m_stats.CountOverwrite(cmd->shockerId);
+          releaseCommand(cmd);
+          cmd = next;
+          continue;
+        }
 
-          cmd = nullptr;
+        // Commands for later wait for their time, executing early is still better than dropping them
+        if (cmd->executeAt > now) {
+          if (m_jitterBuffer.Push(cmd)) {
+            cmd = next;
+            continue;
+          }
 
-          break;
+          OS_LOGW(TAG, "[pin-%hhi] Jitter buffer full, executing command early", m_txPin);
         }
-      }
 
-      // If the command was not replaced, add it to the queue
-      if (cmd != nullptr) {
-        commands.push_back(cmd);
+        submitCommand(cmd, now);
+
+        cmd = next;
       }
+
+      // The prepared frame might be stale now, pick again
+      prepared = false;
     }
 
     if (OpenShock::EStopManager::IsEStopped()) {
-      int64_t whenEStoppedTime = EStopManager::LastEStopped();
-
-      for (auto it = commands.begin(); it != commands.end(); ++it) {
-        cmd = *it;
+      if (m_scheduler.ExpireAll(EStopManager::LastEStopped())) {
+        prepared = false;
+      }
 
-        cmd->until = whenEStoppedTime;
+      // Held commands would start after the E-Stop
+      while ((cmd = m_jitterBuffer.PopDue(INT64_MAX)) != nullptr) {
+        m_stats.CountDrop(cmd->shockerId);
+        releaseCommand(cmd);
       }
     }
 
-    // Send queued commands
-    for (auto it = commands.begin(); it != commands.end();) {
-      cmd = *it;
+    int64_t nowUs = OpenShock::micros();
+    bool onAir    = nowUs < airEndUs;
+
+    // Frames are picked for the moment they will actually start
+    int64_t at = (onAir ? airEndUs : nowUs) / 1000;
 
-      bool expired = cmd->until < OpenShock::millis();
-      bool empty   = cmd->sequence.empty();
+    // Held commands take over once the frame being picked starts at or after their execution time
+    while ((cmd = m_jitterBuffer.PopDue(at)) != nullptr) {
+      submitCommand(cmd, at);
+      prepared = false;
+    }
 
-      // Remove expired or empty commands, else send the command.
-      // After sending/receiving a command, move to the next one.
-      if (expired || empty) {
-        // If the command is not empty, send the zero sequence to stop the shocker
-        if (!empty) {
-          rmtWriteBlocking(m_rmtHandle, cmd->zeroSequence.data(), cmd->zeroSequence.size());
+    // Remove commands that are empty or done sending their zero sequence
+    while ((cmd = m_scheduler.PopFinished(at)) != nullptr) {
+      releaseCommand(cmd);
+    }
+
+    int64_t nextWakeup = at;
+    if (!prepared) {
+      TransmitScheduler::Frame frame;
+      if (m_scheduler.Next(at, frame, nextWakeup)) {
+        buffers[onAirIndex ^ 1] = *frame.sequence;
+
+        // Waveforms are sampled for the moment the frame starts
+        if (!frame.isZero) {
+          RFCommand* active = m_scheduler.Find(frame.shockerId);
+          if (active != nullptr && active->waveform != nullptr) {
+            sampleWaveform(*active, at, buffers[onAirIndex ^ 1]);
+          }
         }
 
-        if (cmd->until + TRANSMIT_END_DURATION < OpenShock::millis()) {
-          // Remove the command and move to the next one
-          it = commands.erase(it);
-          delete cmd;
-        } else {
-          // Move to the next command
-          ++it;
+        bufferShockerIds[onAirIndex ^ 1] = frame.shockerId;
+        bufferIsZero[onAirIndex ^ 1]     = frame.isZero;
+        prepared                         = true;
+      }
+    }
+
+    if (prepared && !onAir) {
+      onAirIndex ^= 1;
+      prepared = false;
+
+      Rmt::Sequence& sequence = buffers[onAirIndex];
+
+      int64_t frameTimeUs = static_cast<int64_t>(sequence.airTime() * RFTRANSMITTER_TICKRATE_NS / 1000.0f);
+      int64_t airTimeUs   = frameTimeUs + RFTRANSMITTER_TX_DONE_MARGIN_US;
+
+      // A command that runs on its own for a while is sent as a burst of passes, with the margin as a low gap between them. Nothing else is waiting
+      // for the channel, anything arriving meanwhile goes out once the burst is done, which keeps it bounded to a short burst.
+      const RFCommand* active = bufferIsZero[onAirIndex] ? nullptr : m_scheduler.Find(bufferShockerIds[onAirIndex]);
+      int64_t passes          = 1;
+      if (active != nullptr && m_scheduler.size() == 1 && m_jitterBuffer.empty() && pendingStopCount == 0 && active->waveform == nullptr && active->minRepeatIntervalMs == 0) {
+        passes = std::min<int64_t>({(active->until - at) * 1000 / airTimeUs, RFTRANSMITTER_BURST_MAX_US / airTimeUs, static_cast<int64_t>(RFTRANSMITTER_BURST_MAX_PASSES)});
+        passes = std::max<int64_t>(passes, 1);
+      }
+
+      bool written;
+      if (passes > 1) {
+        auto end = burstBuffer.begin();
+        for (int64_t pass = 0; pass < passes; ++pass) {
+          if (pass != 0) {
+            *end++ = RFTRANSMITTER_BURST_GAP;
+          }
+          end = std::copy(sequence.pulses.begin(), sequence.pulses.begin() + sequence.size(), end);
         }
+
+        written = rmtWrite(m_rmtHandle, burstBuffer.data(), end - burstBuffer.begin());
       } else {
-        // Send the command
-        rmtWriteBlocking(m_rmtHandle, cmd->sequence.data(), cmd->sequence.size());
+        written = rmtWrite(m_rmtHandle, sequence.data(), sequence.size());
+      }
+
+      // On failure keep pacing as if the frame went out, so a broken channel doesn't spin the task
+      if (!written) {
+        OS_LOGE(TAG, "[pin-%hhi] Failed to start transmission", m_txPin);
+        passes = 1;
+      }
+
+      m_stats.CountFrame(bufferShockerIds[onAirIndex], static_cast<uint32_t>(frameTimeUs), static_cast<uint32_t>(passes));
+      if (passes > 1) {
+        m_scheduler.CountRepeats(bufferShockerIds[onAirIndex], at + (passes - 1) * airTimeUs / 1000, static_cast<uint32_t>(passes - 1));
+      }
+
+      // The first frame of a traced command ends its trace, the prepared frame always belongs to the shocker's active command
+      if (!bufferIsZero[onAirIndex]) {
+        RFCommand* traced = m_scheduler.Find(bufferShockerIds[onAirIndex]);
+        if (traced != nullptr && traced->receivedAtUs != 0) {
+          int64_t emittedUs = OpenShock::micros();
+          LatencyTrace::Record(LatencyTrace::Stage::Emit, static_cast<uint32_t>(emittedUs - traced->dequeuedAtUs));
+          LatencyTrace::Record(LatencyTrace::Stage::Total, static_cast<uint32_t>(emittedUs - traced->receivedAtUs));
+          traced->receivedAtUs = 0;
+        }
+      }
+
+      // A stop is done once its first zero frame is on air, a newer command taking over first voids the measurement
+      for (std::size_t i = 0; i < pendingStopCount; ++i) {
+        if (pendingStops[i].shockerId != bufferShockerIds[onAirIndex]) {
+          continue;
+        }
+
+        if (bufferIsZero[onAirIndex]) {
+          m_stats.CountStop(static_cast<uint32_t>(OpenShock::micros() - pendingStops[i].queuedAtUs));
+        }
+
+        pendingStops[i] = pendingStops[--pendingStopCount];
+        break;
+      }
 
-        // Move to the next command
-        ++it;
+      // The previous completion might still be pending if we got woken up just before it fired
+      esp_timer_stop(m_txDoneTimer);
+
+      // A burst ends with its last pass, the margin after it is the same as after a single frame
+      int64_t burstUs = passes * airTimeUs;
+      airEndUs        = OpenShock::micros() + burstUs;
+      esp_timer_start_once(m_txDoneTimer, burstUs);
+
+      // Go prepare the next frame while this one is on air
+      continue;
+    }
+
+    // Nothing left to transmit means no zero frame is coming for the pending stops
+    if (m_scheduler.empty()) {
+      pendingStopCount = 0;
+    }
+
+    nextWakeup = std::min(nextWakeup, m_jitterBuffer.NextRelease());
+
+    if (pendingStopCount == 0 && uxTaskPriorityGet(nullptr) != RFTRANSMITTER_TASK_PRIORITY) {
+      vTaskPrioritySet(nullptr, RFTRANSMITTER_TASK_PRIORITY);
+
+      // A stop might have arrived while dropping back, handle it right away
+      if (uxQueueMessagesWaiting(m_stopQueueHandle) != 0) {
+        continue;
       }
     }
+
+    TickType_t wait;
+    if (onAir || (m_scheduler.empty() && m_jitterBuffer.empty())) {
+      wait = portMAX_DELAY;  // Woken up by the completion timer or a new command
+    } else {
+      wait = pdMS_TO_TICKS(std::max<int64_t>(nextWakeup - at, 1));
+    }
+
+    ulTaskNotifyTake(pdTRUE, wait);
   }
 }
+
+void RFTransmitter::TransmitDone()
+{
+  xTaskNotifyGive(m_taskHandle);
+}
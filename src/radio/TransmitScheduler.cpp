@@ -0,0 +1,247 @@
+#include "radio/TransmitScheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+const int64_t TRANSMIT_END_DURATION = 300;   // How long the zero sequence is sent after a command expires
+const int64_t FRAME_RATE_WINDOW     = 1000;  // Window over which the achieved frame rate is measured
+const int64_t NEVER_SENT            = std::numeric_limits<int64_t>::min();
+const int64_t NO_WAKEUP             = std::numeric_limits<int64_t>::max();
+
+using namespace OpenShock;
+
+TransmitScheduler::TransmitScheduler()
+  : m_entries()
+  , m_rates()
+  , m_count(0)
+{
+}
+
+RFCommand* TransmitScheduler::Submit(RFCommand* command, int64_t now)
+{
+  std::size_t count = m_count;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    Entry& entry = m_entries[i];
+    if (entry.command->shockerId != command->shockerId) {
+      continue;
+    }
+
+    // Commands that may not overwrite (keep-alives) never replace an active command
+    if (!command->overwrite) {
+      return command;
+    }
+
+    RFCommand* replaced = entry.command;
+    entry.command       = command;
+    entry.sentZero      = false;
+
+    return replaced;
+  }
+
+  if (count >= kMaxShockers) {
+    return command;
+  }
+
+  m_entries[count] = Entry {
+    .command      = command,
+    .lastSent     = NEVER_SENT,
+    .windowStart  = now,
+    .windowFrames = 0,
+    .sentZero     = false,
+  };
+  m_rates[count] = static_cast<uint32_t>(command->shockerId) << 16;
+  m_count        = count + 1;
+
+  return nullptr;
+}
+
+bool TransmitScheduler::Next(int64_t now, Frame& frame, int64_t& nextWakeup)
+{
+  std::size_t count = m_count;
+
+  std::size_t best  = count;
+  int64_t bestDue   = NO_WAKEUP;
+  bool bestIsZero   = false;
+  bool bestIsUrgent = false;
+  int64_t earliest  = NO_WAKEUP;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const Entry& entry   = m_entries[i];
+    const RFCommand* cmd = entry.command;
+
+    bool expired = cmd->until < now;
+
+    int64_t due;
+    if (expired && !entry.sentZero) {
+      due = cmd->until;  // The first zero frame goes out as soon as the command expires
+    } else if (entry.lastSent == NEVER_SENT) {
+      due = NEVER_SENT;  // Fresh commands go out right away
+    } else {
+      due = entry.lastSent + cmd->minRepeatIntervalMs;
+    }
+
+    if (due > now) {
+      earliest = std::min(earliest, due);
+
+      // A running command needs attention the moment it expires, an expired one when it is due for removal
+      if (expired) {
+        earliest = std::min(earliest, cmd->until + TRANSMIT_END_DURATION + 1);
+      } else {
+        earliest = std::min(earliest, cmd->until + 1);
+      }
+      continue;
+    }
+
+    // The first zero frame of an expired command stops the shocker and goes first, the rest of the end phase shares the channel like any other frame
+    bool urgent = expired && !entry.sentZero;
+
+    if (best == count || (urgent && !bestIsUrgent) || (urgent == bestIsUrgent && due < bestDue)) {
+      best         = i;
+      bestDue      = due;
+      bestIsZero   = expired;
+      bestIsUrgent = urgent;
+    }
+  }
+
+  if (best == count) {
+    nextWakeup = earliest;
+    return false;
+  }
+
+  Entry& entry = m_entries[best];
+
+  frame.sequence  = bestIsZero ? &entry.command->zeroSequence : &entry.command->sequence;
+  frame.shockerId = entry.command->shockerId;
+  frame.isZero    = bestIsZero;
+
+  entry.lastSent = now;
+  if (bestIsZero) {
+    entry.sentZero = true;
+  }
+
+  countFrame(best, now);
+
+  nextWakeup = now;
+
+  return true;
+}
+
+void TransmitScheduler::CountRepeats(uint16_t shockerId, int64_t now, uint32_t frames)
+{
+  std::size_t count = m_count;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (m_entries[i].command->shockerId == shockerId) {
+      m_entries[i].lastSent = now;
+      countFrame(i, now, frames);
+      return;
+    }
+  }
+}
+
+RFCommand* TransmitScheduler::Find(uint16_t shockerId)
+{
+  std::size_t count = m_count;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (m_entries[i].command->shockerId == shockerId) {
+      return m_entries[i].command;
+    }
+  }
+
+  return nullptr;
+}
+
+bool TransmitScheduler::Stop(uint16_t shockerId, int64_t now)
+{
+  std::size_t count = m_count;
+  for (std::size_t i = 0; i < count; ++i) {
+    Entry& entry = m_entries[i];
+    if (entry.command->shockerId != shockerId) {
+      continue;
+    }
+
+    // Expired but no zero frame sent yet makes it the most urgent frame there is
+    entry.command->until = now - 1;
+    entry.sentZero       = false;
+
+    return true;
+  }
+
+  return false;
+}
+
+bool TransmitScheduler::ExpireAll(int64_t until)
+{
+  bool changed = false;
+
+  std::size_t count = m_count;
+  for (std::size_t i = 0; i < count; ++i) {
+    RFCommand* cmd = m_entries[i].command;
+
+    if (cmd->until > until) {
+      cmd->until = until;
+      changed    = true;
+    }
+  }
+
+  return changed;
+}
+
+RFCommand* TransmitScheduler::PopFinished(int64_t now, bool force)
+{
+  std::size_t count = m_count;
+  for (std::size_t i = 0; i < count; ++i) {
+    RFCommand* cmd = m_entries[i].command;
+
+    if (force || cmd->sequence.empty() || cmd->until + TRANSMIT_END_DURATION < now) {
+      removeAt(i);
+      return cmd;
+    }
+  }
+
+  return nullptr;
+}
+
+std::size_t TransmitScheduler::GetFrameRates(FrameRate* out, std::size_t maxCount) const
+{
+  std::size_t count = std::min<std::size_t>(m_count, maxCount);
+  for (std::size_t i = 0; i < count; ++i) {
+    uint32_t packed = m_rates[i].load(std::memory_order_relaxed);
+
+    out[i] = FrameRate {
+      .shockerId       = static_cast<uint16_t>(packed >> 16),
+      .framesPerSecond = static_cast<float>(packed & 0xFFFF) / 100.0f,
+    };
+  }
+
+  return count;
+}
+
+void TransmitScheduler::removeAt(std::size_t index)
+{
+  std::size_t last = m_count - 1;
+  if (index != last) {
+    m_entries[index] = m_entries[last];
+    m_rates[index].store(m_rates[last].load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  m_count = last;
+}
+
+void TransmitScheduler::countFrame(std::size_t index, int64_t now, uint32_t frames)
+{
+  Entry& entry = m_entries[index];
+
+  entry.windowFrames += frames;
+
+  int64_t elapsed = now - entry.windowStart;
+  if (elapsed < FRAME_RATE_WINDOW) {
+    return;
+  }
+
+  uint32_t centiFps = static_cast<uint32_t>(std::min<int64_t>((static_cast<int64_t>(entry.windowFrames) * 100'000) / elapsed, 0xFFFF));
+  m_rates[index].store((static_cast<uint32_t>(entry.command->shockerId) << 16) | centiFps, std::memory_order_relaxed);
+
+  entry.windowStart  = now;
+  entry.windowFrames = 0;
+}
@@ -0,0 +1,116 @@
+#include "radio/Waveform.h"
+
+using namespace OpenShock;
+
+const uint8_t WAVEFORM_RAMP_FLAG = 0x80;
+
+static uint16_t readU16(const uint8_t* data)
+{
+  return static_cast<uint16_t>(data[0]) | (static_cast<uint16_t>(data[1]) << 8);
+}
+
+static void writeU16(uint8_t* data, uint16_t value)
+{
+  data[0] = static_cast<uint8_t>(value);
+  data[1] = static_cast<uint8_t>(value >> 8);
+}
+
+bool Waveform::Sample(int64_t elapsedMs, ShockerCommandType& type, uint8_t& intensity) const
+{
+  if (keyframeCount == 0 || periodMs == 0 || elapsedMs < 0 || elapsedMs >= static_cast<int64_t>(DurationMs())) {
+    return false;
+  }
+
+  uint16_t t = static_cast<uint16_t>(elapsedMs % periodMs);
+
+  std::size_t index = 0;
+  while (index + 1 < keyframeCount && keyframes[index + 1].offsetMs <= t) {
+    ++index;
+  }
+
+  const Keyframe& current = keyframes[index];
+
+  type      = current.type;
+  intensity = current.intensity;
+
+  if (!current.ramp) {
+    return true;
+  }
+
+  // The last keyframe ramps towards the first one at the end of the period
+  bool wraps          = index + 1 == keyframeCount;
+  const Keyframe& to  = wraps ? keyframes[0] : keyframes[index + 1];
+  uint32_t spanMs     = (wraps ? periodMs : to.offsetMs) - current.offsetMs;
+  uint32_t progressMs = t - current.offsetMs;
+
+  int32_t delta = static_cast<int32_t>(to.intensity) - static_cast<int32_t>(current.intensity);
+  intensity     = static_cast<uint8_t>(static_cast<int32_t>(current.intensity) + delta * static_cast<int32_t>(progressMs) / static_cast<int32_t>(spanMs));
+
+  return true;
+}
+
+bool Waveform::Parse(const uint8_t* data, std::size_t length, Waveform& out)
+{
+  if (length < kHeaderSize || data[0] != kVersion) {
+    return false;
+  }
+
+  uint8_t count     = data[1];
+  uint16_t periodMs = readU16(data + 2);
+  uint8_t repeats   = data[4];
+
+  if (count == 0 || count > kMaxKeyframes || periodMs == 0 || repeats == 0 || length != kHeaderSize + count * kKeyframeSize) {
+    return false;
+  }
+
+  const uint8_t* cursor = data + kHeaderSize;
+  for (std::size_t i = 0; i < count; ++i, cursor += kKeyframeSize) {
+    uint16_t offsetMs = readU16(cursor);
+    uint8_t rawType   = cursor[2] & ~WAVEFORM_RAMP_FLAG;
+
+    // Keyframes start the period and stay inside it in order, a stop has no place in a pattern
+    if ((i == 0 && offsetMs != 0) || (i != 0 && offsetMs <= out.keyframes[i - 1].offsetMs) || offsetMs >= periodMs) {
+      return false;
+    }
+    if (rawType == static_cast<uint8_t>(ShockerCommandType::Stop) || rawType > static_cast<uint8_t>(ShockerCommandType::MAX)) {
+      return false;
+    }
+
+    out.keyframes[i] = Keyframe {
+      .offsetMs  = offsetMs,
+      .type      = static_cast<ShockerCommandType>(rawType),
+      .intensity = cursor[3],
+      .ramp      = (cursor[2] & WAVEFORM_RAMP_FLAG) != 0,
+    };
+  }
+
+  out.keyframeCount = count;
+  out.periodMs      = periodMs;
+  out.repeats       = repeats;
+
+  return true;
+}
+
+std::size_t Waveform::Serialize(uint8_t* data, std::size_t length) const
+{
+  std::size_t size = kHeaderSize + keyframeCount * kKeyframeSize;
+  if (length < size) {
+    return 0;
+  }
+
+  data[0] = kVersion;
+  data[1] = keyframeCount;
+  writeU16(data + 2, periodMs);
+  data[4] = repeats;
+
+  uint8_t* cursor = data + kHeaderSize;
+  for (std::size_t i = 0; i < keyframeCount; ++i, cursor += kKeyframeSize) {
+    const Keyframe& keyframe = keyframes[i];
+
+    writeU16(cursor, keyframe.offsetMs);
+    cursor[2] = static_cast<uint8_t>(keyframe.type) | (keyframe.ramp ? WAVEFORM_RAMP_FLAG : 0);
+    cursor[3] = keyframe.intensity;
+  }
+
+  return size;
+}
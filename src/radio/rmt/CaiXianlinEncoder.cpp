@@ -1,58 +1,21 @@
 #include "radio/rmt/CaiXianlinEncoder.h"
 
-#include "radio/rmt/internal/Shared.h"
-
-#include "Checksum.h"
-
-// This is the encoder for the CaiXianlin shocker.
-//
-// It is based on the following documentation:
-// https://wiki.openshock.org/hardware/shockers/caixianlin/#rf-specification
-
-const rmt_data_t kRmtPreamble = {1400, 1, 800, 0};
-const rmt_data_t kRmtOne      = {800, 1, 300, 0};
-const rmt_data_t kRmtZero     = {300, 1, 800, 0};
+// Golden vectors for the CaiXianlin protocol, these are evaluated at compile time and must never change without a matching hardware test.
 
 using namespace OpenShock;
 
-std::vector<rmt_data_t> Rmt::CaiXianlinEncoder::GetSequence(uint16_t transmitterId, uint8_t channelId, ShockerCommandType type, uint8_t intensity) {
-  // Intensity must be between 0 and 99
-  intensity = std::min(intensity, static_cast<uint8_t>(99));
-
-  uint8_t typeVal = 0;
-  switch (type) {
-  case ShockerCommandType::Shock:
-    typeVal = 0x01;
-    break;
-  case ShockerCommandType::Vibrate:
-    typeVal = 0x02;
-    break;
-  case ShockerCommandType::Sound:
-    typeVal = 0x03;
-    intensity = 0; // Sound intensity must be 0 for some shockers, otherwise it wont work, or they soft lock until restarted
-    break;
-  default:
-    return {}; // Invalid type
-  }
-
-  // Payload layout: [transmitterId:16][channelId:4][type:4][intensity:8]
-  uint32_t payload = (static_cast<uint32_t>(transmitterId & 0xFFFF) << 16) | (static_cast<uint32_t>(channelId & 0xF) << 12) | (static_cast<uint32_t>(typeVal) << 8) | static_cast<uint32_t>(intensity & 0xFF);
-
-  // Calculate the checksum of the payload
-  uint8_t checksum = Checksum::Sum8(payload);
-
-  // Add the checksum to the payload
-  uint64_t data = (static_cast<uint64_t>(payload) << 8) | static_cast<uint64_t>(checksum);
+using CaiXianlin = Rmt::CaiXianlinEncoder::Protocol<0>;
 
-  // Shift the data left by 3 bits to add the postamble (3 bits of 0)
-  data <<= 3;
+static_assert(Rmt::Internal::FrameLength<CaiXianlin> == 44, "CaiXianlin frames are 44 symbols long");
 
-  std::vector<rmt_data_t> pulses;
-  pulses.reserve(44);
+static_assert(CaiXianlin::Payload(0x1234, ShockerCommandType::Shock, 50) == 0x12'34'01'32'79ULL, "CaiXianlin shock payload changed");
+static_assert(CaiXianlin::Payload(0xABCD, ShockerCommandType::Vibrate, 255) == 0xAB'CD'02'63'DDULL, "CaiXianlin intensity must be capped at 99");
+static_assert(CaiXianlin::Payload(0xFFFF, ShockerCommandType::Sound, 80) == 0xFF'FF'03'00'01ULL, "CaiXianlin sound intensity must be 0");
+static_assert(Rmt::CaiXianlinEncoder::Protocol<5>::Payload(0x0001, ShockerCommandType::Vibrate, 0) == 0x00'01'52'00'53ULL, "CaiXianlin channel payload changed");
+static_assert(CaiXianlin::Payload(0x1234, ShockerCommandType::Stop, 50) == Rmt::Internal::kInvalidPayload, "CaiXianlin can't encode stop");
 
-  // Generate the sequence
-  pulses.push_back(kRmtPreamble);
-  Internal::EncodeBits<43>(pulses, data, kRmtOne, kRmtZero);
+static_assert(Rmt::Internal::FrameMatches<CaiXianlin>(Rmt::Internal::BuildFrame<CaiXianlin>(CaiXianlin::Payload(0x1234, ShockerCommandType::Shock, 50)), 0x12'34'01'32'79ULL), "CaiXianlin shock frame changed");
 
-  return pulses;
-}
+static_assert(Rmt::Internal::FrameDecodesTo<CaiXianlin>(Rmt::Internal::BuildFrame<CaiXianlin>(0xAB'CD'02'63'DDULL), 0xABCD, ShockerCommandType::Vibrate, 99), "CaiXianlin vibrate frame must decode");
+static_assert(!Rmt::Internal::FrameDecodesTo<CaiXianlin>(Rmt::Internal::BuildFrame<CaiXianlin>(0xAB'CD'02'63'DCULL), 0xABCD, ShockerCommandType::Vibrate, 99), "CaiXianlin frames with a broken checksum must not decode");
+static_assert(!Rmt::Internal::FrameDecodesTo<CaiXianlin>(Rmt::Internal::BuildFrame<CaiXianlin>(0x00'01'52'00'53ULL), 0x0001, ShockerCommandType::Vibrate, 0), "CaiXianlin frames for another channel must not decode");
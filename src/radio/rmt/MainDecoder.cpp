@@ -0,0 +1,27 @@
+#include "radio/rmt/MainDecoder.h"
+
+#include "radio/rmt/CaiXianlinEncoder.h"
+#include "radio/rmt/Petrainer998DREncoder.h"
+#include "radio/rmt/PetrainerEncoder.h"
+
+using namespace OpenShock;
+
+template<typename Protocol>
+static bool decodeAs(ShockerModelType model, const rmt_data_t* pulses, std::size_t length, Rmt::DecodedCommand& out)
+{
+  if (!Rmt::Internal::Decode<Protocol>(pulses, length, out.shockerId, out.type, out.intensity)) {
+    return false;
+  }
+
+  out.model = model;
+
+  return true;
+}
+
+bool Rmt::Decode(const rmt_data_t* pulses, std::size_t length, DecodedCommand& out)
+{
+  // Frame lengths differ between the models (44, 42 and 43 symbols), so at most one of these gets past the length check
+  return decodeAs<CaiXianlinEncoder::Protocol<>>(ShockerModelType::CaiXianlin, pulses, length, out)
+      || decodeAs<PetrainerEncoder::Protocol>(ShockerModelType::Petrainer, pulses, length, out)
+      || decodeAs<Petrainer998DREncoder::Protocol>(ShockerModelType::Petrainer998DR, pulses, length, out);
+}
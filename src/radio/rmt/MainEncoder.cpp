@@ -7,49 +7,19 @@ const char* const TAG = "RmtMainEncoder";
 #include "radio/rmt/Petrainer998DREncoder.h"
 #include "radio/rmt/PetrainerEncoder.h"
 
-#include <unordered_map>
-
 using namespace OpenShock;
 
-std::vector<rmt_data_t> Rmt::GetSequence(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity) {
+bool Rmt::GetSequence(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Sequence& out) {
   switch (model) {
     case ShockerModelType::Petrainer:
-      return Rmt::PetrainerEncoder::GetSequence(shockerId, type, intensity);
+      return Rmt::PetrainerEncoder::GetSequence(shockerId, type, intensity, out);
     case ShockerModelType::Petrainer998DR:
-      return Rmt::Petrainer998DREncoder::GetSequence(shockerId, type, intensity);
+      return Rmt::Petrainer998DREncoder::GetSequence(shockerId, type, intensity, out);
     case ShockerModelType::CaiXianlin:
-      return Rmt::CaiXianlinEncoder::GetSequence(shockerId, 0, type, intensity);
+      return Rmt::CaiXianlinEncoder::GetSequence(shockerId, type, intensity, out);
     default:
       OS_LOGE(TAG, "Unknown shocker model: %u", model);
-      return {};
+      out.clear();
+      return false;
   }
 }
-/*
-std::shared_ptr<std::vector<rmt_data_t>> Rmt::GetZeroSequence(ShockerModelType model, uint16_t shockerId) {
-  static std::unordered_map<uint16_t, std::shared_ptr<std::vector<rmt_data_t>>> _sequences;
-
-  auto it = _sequences.find(shockerId);
-  if (it != _sequences.end()) return it->second; // FIXME: This is not thread-safe, and does not check if model is the same, causing a protocol mismatch
-
-  std::shared_ptr<std::vector<rmt_data_t>> sequence;
-  switch (model) {
-    case ShockerModelType::Petrainer:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::PetrainerEncoder::GetSequence(shockerId, ShockerCommandType::Vibrate, 0));
-      break;
-    case ShockerModelType::Petrainer998DR:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::Petrainer998DREncoder::GetSequence(shockerId, ShockerCommandType::Vibrate, 0));
-      break;
-    case ShockerModelType::CaiXianlin:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::CaiXianlinEncoder::GetSequence(shockerId, 0, ShockerCommandType::Vibrate, 0));
-      break;
-    default:
-      OS_LOGE(TAG, "Unknown shocker model: %u", model);
-      sequence = nullptr;
-      break;
-  }
-
-  _sequences[shockerId] = sequence;
-
-  return sequence;
-}
-*/
@@ -1,57 +1,18 @@
 #include "radio/rmt/Petrainer998DREncoder.h"
 
-#include "radio/rmt/internal/Shared.h"
-
-const rmt_data_t kRmtPreamble  = {1500, 1, 750, 0};
-const rmt_data_t kRmtOne       = {750, 1, 250, 0};
-const rmt_data_t kRmtZero      = {250, 1, 750, 0};
-const rmt_data_t kRmtPostamble = {1500, 0, 1500, 0};  // Some subvariants expect a quiet period between commands
+// Golden vectors for the Petrainer 998DR protocol, these are evaluated at compile time and must never change without a matching hardware test.
 
 using namespace OpenShock;
 
-std::vector<rmt_data_t> Rmt::Petrainer998DREncoder::GetSequence(uint16_t shockerId, ShockerCommandType type, uint8_t intensity)
-{
-  // Intensity must be between 0 and 100
-  intensity = std::min(intensity, static_cast<uint8_t>(100));
-
-  int typeShift = 0;
-  switch (type) {
-    case ShockerCommandType::Shock:
-      typeShift = 0;
-      break;
-    case ShockerCommandType::Vibrate:
-      typeShift = 1;
-      break;
-    case ShockerCommandType::Sound:
-      typeShift = 2;
-      break;
-    // case ShockerCommandType::Light:
-    //   nShift = 3;
-    //   break;
-    default:
-      return {};  // Invalid type
-  }
-
-  uint8_t typeVal    = 0b0001 << typeShift;
-  uint8_t typeInvert = ~(0b1000 >> typeShift);
-
-  // TODO: Channel argument?
-  uint8_t channel       = 0b1000;  // Can be [1000] or [1111], 4 bits wide
-  uint8_t channelInvert = 0b1110;  // Can be [1110] or [0000], 4 bits wide
+using Petrainer998DR = Rmt::Petrainer998DREncoder::Protocol;
 
-  // TODO: Below ShockerID is 17 bits wide, and intensity is 7 bits wide. This is weird as ShockerID has 1 more bit and intensity has 1 less bit than 8 bit alignment. This needs investigation.
-  // Payload layout: [channel:4][typeVal:4][shockerID:17][intensity:7][typeInvert:4][channelInvert:4] (40 bits)
-  uint64_t data
-    = (static_cast<uint64_t>(channel & 0b1111) << 36 | static_cast<uint64_t>(typeVal & 0b1111) << 32 | static_cast<uint64_t>(shockerId & 0x1FFFF) << 15 | static_cast<uint64_t>(intensity & 0x7F) << 8 | static_cast<uint64_t>(typeInvert & 0b1111) << 4 | static_cast<uint64_t>(channelInvert & 0b1111));
+static_assert(Rmt::Internal::FrameLength<Petrainer998DR> == 43, "Petrainer 998DR frames are 43 symbols long");
 
-  std::vector<rmt_data_t> pulses;
-  pulses.reserve(43);
+static_assert(Petrainer998DR::Payload(0x1234, ShockerCommandType::Shock, 50) == 0x81'09'1A'32'7EULL, "Petrainer 998DR shock payload changed");
+static_assert(Petrainer998DR::Payload(0xABCD, ShockerCommandType::Vibrate, 255) == 0x82'55'E6'E4'BEULL, "Petrainer 998DR intensity must be capped at 100");
+static_assert(Petrainer998DR::Payload(0x1234, ShockerCommandType::Stop, 50) == Rmt::Internal::kInvalidPayload, "Petrainer 998DR can't encode stop");
 
-  // Generate the sequence
-  pulses.push_back(kRmtPreamble);
-  Internal::EncodeBits<40>(pulses, data, kRmtOne, kRmtZero);
-  pulses.push_back(kRmtZero);  // Idk why this is here, the decoded protocol has it
-  pulses.push_back(kRmtPostamble);
+static_assert(Rmt::Internal::FrameMatches<Petrainer998DR>(Rmt::Internal::BuildFrame<Petrainer998DR>(Petrainer998DR::Payload(0x1234, ShockerCommandType::Shock, 50)), 0x81'09'1A'32'7EULL), "Petrainer 998DR shock frame changed");
 
-  return pulses;
-}
+static_assert(Rmt::Internal::FrameDecodesTo<Petrainer998DR>(Rmt::Internal::BuildFrame<Petrainer998DR>(0x82'55'E6'E4'BEULL), 0xABCD, ShockerCommandType::Vibrate, 100), "Petrainer 998DR vibrate frame must decode");
+static_assert(!Rmt::Internal::FrameDecodesTo<Petrainer998DR>(Rmt::Internal::BuildFrame<Petrainer998DR>(0x82'55'E6'E4'BFULL), 0xABCD, ShockerCommandType::Vibrate, 100), "Petrainer 998DR frames with a broken channel invert must not decode");
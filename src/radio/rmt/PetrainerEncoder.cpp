@@ -1,49 +1,19 @@
 #include "radio/rmt/PetrainerEncoder.h"
 
-#include "radio/rmt/internal/Shared.h"
-
-const rmt_data_t kRmtPreamble  = {750, 1, 750, 0};
-const rmt_data_t kRmtOne       = {200, 1, 1500, 0};
-const rmt_data_t kRmtZero      = {200, 1, 750, 0};
-const rmt_data_t kRmtPostamble = {200, 1, 7000, 0};
+// Golden vectors for the Petrainer protocol, these are evaluated at compile time and must never change without a matching hardware test.
 
 using namespace OpenShock;
 
-std::vector<rmt_data_t> Rmt::PetrainerEncoder::GetSequence(uint16_t shockerId, ShockerCommandType type, uint8_t intensity) {
-  // Intensity must be between 0 and 100
-  intensity = std::min(intensity, static_cast<uint8_t>(100));
-
-  uint8_t nShift = 0;
-  switch (type) {
-  case ShockerCommandType::Shock:
-    nShift = 0;
-    break;
-  case ShockerCommandType::Vibrate:
-    nShift = 1;
-    break;
-  case ShockerCommandType::Sound:
-    nShift = 2;
-    break;
-  default:
-    return {}; // Invalid type
-  }
-
-  // Type is 0x80 | (0x01 << nShift)
-  uint8_t typeVal = (0x80 | (0x01 << nShift)) & 0xFF;
-
-  // TypeSum is NOT(0x01 | (0x80 >> nShift))
-  uint8_t typeSum = (~(0x01 | (0x80 >> nShift))) & 0xFF;
+using Petrainer = Rmt::PetrainerEncoder::Protocol;
 
-  // Payload layout: [methodBit:8][shockerId:16][intensity:8][methodChecksum:8]
-  uint64_t data = (static_cast<uint64_t>(typeVal) << 32) | (static_cast<uint64_t>(shockerId) << 16) | (static_cast<uint64_t>(intensity) << 8) | static_cast<uint64_t>(typeSum);
+static_assert(Rmt::Internal::FrameLength<Petrainer> == 42, "Petrainer frames are 42 symbols long");
 
-  std::vector<rmt_data_t> pulses;
-  pulses.reserve(42);
+static_assert(Petrainer::Payload(0x1234, ShockerCommandType::Shock, 50) == 0x81'12'34'32'7EULL, "Petrainer shock payload changed");
+static_assert(Petrainer::Payload(0xABCD, ShockerCommandType::Vibrate, 255) == 0x82'AB'CD'64'BEULL, "Petrainer intensity must be capped at 100");
+static_assert(Petrainer::Payload(0x0001, ShockerCommandType::Sound, 0) == 0x84'00'01'00'DEULL, "Petrainer sound payload changed");
+static_assert(Petrainer::Payload(0x1234, ShockerCommandType::Stop, 50) == Rmt::Internal::kInvalidPayload, "Petrainer can't encode stop");
 
-  // Generate the sequence
-  pulses.push_back(kRmtPreamble);
-  Internal::EncodeBits<40>(pulses, data, kRmtOne, kRmtZero);
-  pulses.push_back(kRmtPostamble);
+static_assert(Rmt::Internal::FrameMatches<Petrainer>(Rmt::Internal::BuildFrame<Petrainer>(Petrainer::Payload(0xABCD, ShockerCommandType::Vibrate, 255)), 0x82'AB'CD'64'BEULL), "Petrainer vibrate frame changed");
 
-  return pulses;
-}
+static_assert(Rmt::Internal::FrameDecodesTo<Petrainer>(Rmt::Internal::BuildFrame<Petrainer>(0x84'00'01'00'DEULL), 0x0001, ShockerCommandType::Sound, 0), "Petrainer sound frame must decode");
+static_assert(!Rmt::Internal::FrameDecodesTo<Petrainer>(Rmt::Internal::BuildFrame<Petrainer>(0x84'00'01'00'DFULL), 0x0001, ShockerCommandType::Sound, 0), "Petrainer frames with a broken type checksum must not decode");
@@ -0,0 +1,188 @@
+#include <freertos/FreeRTOS.h>
+
+#include "radio/rmt/SequenceCache.h"
+
+#include "radio/rmt/MainEncoder.h"
+#include "SimpleMutex.h"
+
+#include <array>
+
+const std::size_t SEQUENCE_CACHE_CAPACITY = 32;  // 32 * ~184 bytes = ~5.9KB
+
+using namespace OpenShock;
+
+struct CacheEntry {
+  uint32_t lastUsed;
+  Rmt::Sequence sequence;
+};
+
+static OpenShock::SimpleMutex s_cacheMutex = {};
+
+// Keys are kept apart from the entries so that a lookup only scans a small contiguous array
+static std::array<uint64_t, SEQUENCE_CACHE_CAPACITY> s_cacheKeys      = {};
+static std::array<CacheEntry, SEQUENCE_CACHE_CAPACITY> s_cacheEntries = {};
+static std::size_t s_cacheSize                                        = 0;
+static uint32_t s_cacheUseCounter                                     = 0;
+static Rmt::SequenceCache::Stats s_cacheStats                         = {};
+
+// Pinned sequences live apart from the LRU entries so a burst of commands can't evict them
+static std::array<uint64_t, Rmt::SequenceCache::kMaxPinned> s_pinnedKeys           = {};
+static std::array<Rmt::Sequence, Rmt::SequenceCache::kMaxPinned> s_pinnedSequences = {};
+static std::size_t s_pinnedSize                                                    = 0;
+
+static constexpr uint64_t makeKey(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity)
+{
+  return (static_cast<uint64_t>(model) << 32) | (static_cast<uint64_t>(shockerId) << 16) | (static_cast<uint64_t>(type) << 8) | static_cast<uint64_t>(intensity);
+}
+
+static CacheEntry* findEntry(uint64_t key)
+{
+  for (std::size_t i = 0; i < s_cacheSize; ++i) {
+    if (s_cacheKeys[i] == key) {
+      return &s_cacheEntries[i];
+    }
+  }
+
+  return nullptr;
+}
+
+static const Rmt::Sequence* findPinned(uint64_t key)
+{
+  for (std::size_t i = 0; i < s_pinnedSize; ++i) {
+    if (s_pinnedKeys[i] == key) {
+      return &s_pinnedSequences[i];
+    }
+  }
+
+  return nullptr;
+}
+
+static CacheEntry& claimEntry(uint64_t key)
+{
+  std::size_t index = s_cacheSize;
+
+  if (index < SEQUENCE_CACHE_CAPACITY) {
+    ++s_cacheSize;
+  } else {
+    // Evict the least recently used entry
+    index = 0;
+    for (std::size_t i = 1; i < SEQUENCE_CACHE_CAPACITY; ++i) {
+      if (s_cacheEntries[i].lastUsed < s_cacheEntries[index].lastUsed) {
+        index = i;
+      }
+    }
+
+    ++s_cacheStats.evictions;
+  }
+
+  s_cacheKeys[index] = key;
+
+  return s_cacheEntries[index];
+}
+
+bool Rmt::SequenceCache::GetSequence(ShockerModelType model, uint16_t shockerId, ShockerCommandType type, uint8_t intensity, Rmt::Sequence& out)
+{
+  uint64_t key = makeKey(model, shockerId, type, intensity);
+
+  {
+    ScopedLock lock__(&s_cacheMutex);
+
+    const Rmt::Sequence* pinned = findPinned(key);
+    if (pinned != nullptr) {
+      ++s_cacheStats.hits;
+
+      out = *pinned;
+
+      return true;
+    }
+
+    CacheEntry* entry = findEntry(key);
+    if (entry != nullptr) {
+      entry->lastUsed = ++s_cacheUseCounter;
+      ++s_cacheStats.hits;
+
+      out = entry->sequence;
+
+      return true;
+    }
+
+    ++s_cacheStats.misses;
+  }
+
+  // Encode outside of the lock, this is the expensive part
+  if (!Rmt::GetSequence(model, shockerId, type, intensity, out)) {
+    return false;
+  }
+
+  ScopedLock lock__(&s_cacheMutex);
+
+  // Another task might have inserted the same sequence while we were encoding
+  if (findEntry(key) != nullptr) {
+    return true;
+  }
+
+  CacheEntry& entry = claimEntry(key);
+  entry.lastUsed    = ++s_cacheUseCounter;
+  entry.sequence    = out;
+
+  return true;
+}
+
+std::size_t Rmt::SequenceCache::SetPinned(const PinnedShocker* shockers, std::size_t count)
+{
+  if (count > kMaxPinned) {
+    count = kMaxPinned;
+  }
+
+  {
+    ScopedLock lock__(&s_cacheMutex);
+    s_pinnedSize = 0;
+  }
+
+  // Encode one at a time outside of the lock, a whole table of sequences is too big for the caller's stack
+  std::size_t pinned = 0;
+  Rmt::Sequence sequence;
+  for (std::size_t i = 0; i < count; ++i) {
+    const PinnedShocker& shocker = shockers[i];
+    if (!Rmt::GetZeroSequence(shocker.model, shocker.shockerId, sequence)) {
+      continue;
+    }
+
+    uint64_t key = makeKey(shocker.model, shocker.shockerId, ShockerCommandType::Vibrate, 0);
+
+    ScopedLock lock__(&s_cacheMutex);
+
+    if (findPinned(key) != nullptr || s_pinnedSize >= kMaxPinned) {
+      continue;
+    }
+
+    s_pinnedKeys[s_pinnedSize]      = key;
+    s_pinnedSequences[s_pinnedSize] = sequence;
+    ++s_pinnedSize;
+    ++pinned;
+  }
+
+  return pinned;
+}
+
+Rmt::SequenceCache::Stats Rmt::SequenceCache::GetStats()
+{
+  ScopedLock lock__(&s_cacheMutex);
+
+  Stats stats    = s_cacheStats;
+  stats.entries  = static_cast<uint8_t>(s_cacheSize);
+  stats.capacity = static_cast<uint8_t>(SEQUENCE_CACHE_CAPACITY);
+  stats.pinned   = static_cast<uint8_t>(s_pinnedSize);
+
+  return stats;
+}
+
+void Rmt::SequenceCache::Clear()
+{
+  ScopedLock lock__(&s_cacheMutex);
+
+  s_cacheSize       = 0;
+  s_pinnedSize      = 0;
+  s_cacheUseCounter = 0;
+  s_cacheStats      = {};
+}
@@ -0,0 +1,59 @@
+#include "serial/command_handlers/common.h"
+
+#include "CommandHandler.h"
+#include "config/Config.h"
+#include "radio/RFQueuePolicy.h"
+#include "util/StringUtils.h"
+
+#include <array>
+#include <string>
+
+void _handleRfQueueCommand(std::string_view arg, bool isAutomated)
+{
+  if (arg.empty()) {
+    OpenShock::RFQueuePolicy policy;
+    if (!OpenShock::Config::GetRFConfigQueuePolicy(policy)) {
+      SERPR_ERROR("Failed to get RF queue policy from config");
+      return;
+    }
+
+    SERPR_RESPONSE("RFQueuePolicy|%s", OpenShock::RFQueuePolicyToString(policy));
+
+    std::array<OpenShock::RFQueueStatus, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> statuses;
+    std::size_t count = OpenShock::CommandHandler::GetRfQueueStatus(statuses.data(), statuses.size());
+
+    for (std::size_t i = 0; i < count; ++i) {
+      const OpenShock::RFQueueStatus& status = statuses[i];
+
+      SERPR_RESPONSE("RFQueue|%hhu|%hhu/%hhu queued|%u rejected|%u dropped|%u coalesced", status.transmitter, status.depth, status.capacity, status.rejected, status.dropped, status.coalesced);
+    }
+    return;
+  }
+
+  std::string policyStr(OpenShock::StringTrim(arg));
+
+  OpenShock::RFQueuePolicy policy;
+  if (!OpenShock::RFQueuePolicyFromString(policyStr.c_str(), policy)) {
+    SERPR_ERROR("Invalid argument (must be drop-oldest or reject-new)");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::SetRfQueuePolicy(policy)) {
+    SERPR_ERROR("Failed to save config");
+    return;
+  }
+
+  SERPR_SUCCESS("Saved config");
+}
+
+OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfQueueHandler()
+{
+  auto group = OpenShock::Serial::CommandGroup("rfqueue"sv);
+
+  auto& getCommand = group.addCommand("Get the policy for full transmitter queues, and queue fill and admission counters per transmitter"sv, _handleRfQueueCommand);
+
+  auto& setCommand = group.addCommand("Set the policy for full transmitter queues"sv, _handleRfQueueCommand);
+  setCommand.addArgument("policy"sv, "must be drop-oldest or reject-new"sv, "drop-oldest"sv);
+
+  return group;
+}
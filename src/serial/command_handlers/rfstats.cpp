@@ -0,0 +1,162 @@
+#include "serial/command_handlers/common.h"
+
+#include "CommandHandler.h"
+#include "LatencyTrace.h"
+#include "radio/RFStats.h"
+#include "util/Base64Utils.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+static std::size_t _getSnapshots(std::array<OpenShock::RFStats::Snapshot, OPENSHOCK_RF_TX_MAX_TRANSMITTERS>& snapshots)
+{
+  return OpenShock::CommandHandler::GetRfStats(snapshots.data(), snapshots.size());
+}
+
+void _handleRfStatsCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (rfstats command should not have any arguments)");
+    return;
+  }
+
+  std::array<OpenShock::RFStats::Snapshot, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> snapshots;
+  std::size_t count = _getSnapshots(snapshots);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const OpenShock::RFStats::Snapshot& snapshot = snapshots[i];
+    const OpenShock::RFStats::Totals& totals     = snapshot.totals;
+
+    float dutyCycle    = totals.elapsedMs == 0 ? 0.0f : static_cast<float>(totals.airTimeUs) / (static_cast<float>(totals.elapsedMs) * 10.0f);
+    uint32_t avgWaitUs = totals.commands == 0 ? 0 : totals.queueWaitUs / totals.commands;
+
+    SERPR_RESPONSE(
+      "RFStats|Transmitter|%hhu|pin %hhi|%u ms|%u frames|%u us air|%.2f %% duty|%u commands|%u us avg wait|%u us max wait|%u overwrites|%u drops",
+      snapshot.transmitter,
+      snapshot.txPin,
+      totals.elapsedMs,
+      totals.frames,
+      totals.airTimeUs,
+      dutyCycle,
+      totals.commands,
+      avgWaitUs,
+      totals.queueWaitMaxUs,
+      totals.overwrites,
+      totals.drops
+    );
+
+    // Stop latency distribution, "<1000:4,<2000:1,...,>=100000:0"
+    std::string histogram;
+    for (std::size_t j = 0; j < OpenShock::RFStats::kStopLatencyBuckets; ++j) {
+      if (j != 0) {
+        histogram.push_back(',');
+      }
+
+      if (j < OpenShock::RFStats::kStopLatencyBoundsUs.size()) {
+        histogram.push_back('<');
+        histogram.append(std::to_string(OpenShock::RFStats::kStopLatencyBoundsUs[j]));
+      } else {
+        histogram.append(">=");
+        histogram.append(std::to_string(OpenShock::RFStats::kStopLatencyBoundsUs.back()));
+      }
+      histogram.push_back(':');
+      histogram.append(std::to_string(totals.stopLatency[j]));
+    }
+
+    SERPR_RESPONSE("RFStats|StopLatency|%hhu|%u stops|%u us max|%s", snapshot.transmitter, totals.stops, totals.stopLatencyMaxUs, histogram.c_str());
+
+    for (std::size_t j = 0; j < snapshot.shockerCount; ++j) {
+      const OpenShock::RFStats::Shocker& shocker = snapshot.shockers[j];
+
+      SERPR_RESPONSE("RFStats|Shocker|%hhu|%hu|%u frames|%u us air|%u overwrites|%u drops", snapshot.transmitter, shocker.shockerId, shocker.frames, shocker.airTimeUs, shocker.overwrites, shocker.drops);
+    }
+  }
+}
+
+void _handleRfStatsBinaryCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (binary command should not have any arguments)");
+    return;
+  }
+
+  std::array<OpenShock::RFStats::Snapshot, OPENSHOCK_RF_TX_MAX_TRANSMITTERS> snapshots;
+  std::size_t count = _getSnapshots(snapshots);
+
+  std::vector<uint8_t> buffer;
+  OpenShock::RFStats::Serialize(snapshots.data(), count, buffer);
+
+  std::string base64;
+  if (!OpenShock::Base64Utils::Encode(buffer.data(), buffer.size(), base64)) {
+    SERPR_ERROR("Failed to encode RF stats to base64");
+    return;
+  }
+
+  SERPR_RESPONSE("RFStatsRaw|%s", base64.c_str());
+}
+
+void _handleRfStatsLatencyCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (latency command should not have any arguments)");
+    return;
+  }
+
+  for (std::size_t i = 0; i < OpenShock::LatencyTrace::kStageCount; ++i) {
+    OpenShock::LatencyTrace::Stage stage = static_cast<OpenShock::LatencyTrace::Stage>(i);
+
+    OpenShock::LatencyTrace::StageStats stats;
+    OpenShock::LatencyTrace::GetStats(stage, stats);
+
+    // Bucket counts, "<128:4,<256:1,...,>=131072:0"
+    std::string histogram;
+    for (std::size_t j = 0; j < OpenShock::LatencyTrace::kBucketCount; ++j) {
+      if (j != 0) {
+        histogram.push_back(',');
+      }
+
+      if (j + 1 < OpenShock::LatencyTrace::kBucketCount) {
+        histogram.push_back('<');
+        histogram.append(std::to_string(OpenShock::LatencyTrace::BucketUpperBoundUs(j)));
+      } else {
+        histogram.append(">=");
+        histogram.append(std::to_string(OpenShock::LatencyTrace::BucketUpperBoundUs(j - 1)));
+      }
+      histogram.push_back(':');
+      histogram.append(std::to_string(stats.buckets[j]));
+    }
+
+    uint32_t avgUs = stats.count == 0 ? 0 : stats.sumUs / stats.count;
+
+    SERPR_RESPONSE("RFLatency|%s|%u samples|%u us avg|%u us max|%s", OpenShock::LatencyTrace::StageName(stage), stats.count, avgUs, stats.maxUs, histogram.c_str());
+  }
+}
+
+void _handleRfStatsResetCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (reset command should not have any arguments)");
+    return;
+  }
+
+  OpenShock::CommandHandler::ResetRfStats();
+  OpenShock::LatencyTrace::Reset();
+
+  SERPR_SUCCESS("RF stats reset");
+}
+
+OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfStatsHandler()
+{
+  auto group = OpenShock::Serial::CommandGroup("rfstats"sv);
+
+  auto& getCommand = group.addCommand("Get air-time, queueing, overwrite, drop and stop latency counters per transmitter and shocker"sv, _handleRfStatsCommand);
+
+  auto& binaryCommand = group.addCommand("binary"sv, "Get the same counters as a compact base64 encoded little endian snapshot"sv, _handleRfStatsBinaryCommand);
+
+  auto& latencyCommand = group.addCommand("latency"sv, "Get the gateway command latency per stage, from WebSocket frame to first RF frame on air"sv, _handleRfStatsLatencyCommand);
+
+  auto& resetCommand = group.addCommand("reset"sv, "Reset all counters and latency histograms"sv, _handleRfStatsResetCommand);
+
+  return group;
+}
@@ -25,7 +25,7 @@ void _handleRFTransmitCommand(std::string_view arg, bool isAutomated)
     return;
   }
 
-  if (!OpenShock::CommandHandler::HandleCommand(cmd.model, cmd.id, cmd.command, cmd.intensity, cmd.durationMs)) {
+  if (!OpenShock::CommandHandler::HandleCommand(cmd.model, cmd.id, cmd.command, cmd.intensity, cmd.durationMs, cmd.executeAtMs)) {
     SERPR_ERROR("Failed to send command");
     return;
   }
@@ -33,6 +33,36 @@ void _handleRFTransmitCommand(std::string_view arg, bool isAutomated)
   SERPR_SUCCESS("Command sent");
 }
 
+void _handleRFTransmitWaveformCommand(std::string_view arg, bool isAutomated)
+{
+  if (arg.empty()) {
+    SERPR_ERROR("No waveform");
+    return;
+  }
+  cJSON* root = cJSON_ParseWithLength(arg.data(), arg.length());
+  if (root == nullptr) {
+    SERPR_ERROR("Failed to parse JSON: %s", cJSON_GetErrorPtr());
+    return;
+  }
+
+  OpenShock::Serialization::JsonSerial::ShockerWaveform cmd;
+  bool parsed = OpenShock::Serialization::JsonSerial::ParseShockerWaveform(root, cmd);
+
+  cJSON_Delete(root);
+
+  if (!parsed) {
+    SERPR_ERROR("Failed to parse shocker waveform");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::HandleWaveform(cmd.model, cmd.id, cmd.waveform)) {
+    SERPR_ERROR("Failed to send waveform");
+    return;
+  }
+
+  SERPR_SUCCESS("Waveform sent");
+}
+
 OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfTransmitHandler()
 {
   auto group = OpenShock::Serial::CommandGroup("rftransmit"sv);
@@ -46,7 +76,18 @@ OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfTransmitHa
      "id         (number) ID of the shocker                       (0-65535)"sv,
      "type       (string) Type of the command                     (\"shock\", \"vibrate\", \"sound\", \"stop\")"sv,
      "intensity  (number) Intensity of the command                (0-255)"sv,
-     "durationMs (number) Duration of the command in milliseconds (0-65535)"sv}
+     "durationMs (number) Duration of the command in milliseconds (0-65535)"sv,
+     "executeAtMs (number, optional) Gateway time to start the command at, needs a synced gateway clock"sv}
+  );
+
+  auto& waveformCmd = group.addCommand("waveform"sv, "Play an intensity waveform, interpolated on the hub"sv, _handleRFTransmitWaveformCommand);
+  waveformCmd.addArgument(
+    "json"sv,
+    "must be a JSON object with the following fields:"sv,
+    "{\"model\":\"caixianlin\",\"id\":12345,\"waveform\":\"AQLQBwEAAIIAsAQCZA==\"}"sv,
+    {"model    (string) Model of the shocker                     (\"caixianlin\", \"petrainer\", \"petrainer998dr\")"sv,
+     "id       (number) ID of the shocker                        (0-65535)"sv,
+     "waveform (string) Base64 encoded waveform, see radio/Waveform.h"sv}
   );
 
   return group;
@@ -4,6 +4,9 @@
 #include "config/Config.h"
 #include "Convert.h"
 #include "SetGPIOResultCode.h"
+#include "util/StringUtils.h"
+
+#include <string>
 
 void _handleRfTxPinCommand(std::string_view arg, bool isAutomated)
 {
@@ -22,6 +25,7 @@ void _handleRfTxPinCommand(std::string_view arg, bool isAutomated)
 
   if (!OpenShock::Convert::ToGpioNum(arg, txPin)) {
     SERPR_ERROR("Invalid argument (number invalid or out of range)");
+    return;
   }
 
   OpenShock::SetGPIOResultCode result = OpenShock::CommandHandler::SetRfTxPin(txPin);
@@ -45,6 +49,210 @@ void _handleRfTxPinCommand(std::string_view arg, bool isAutomated)
   }
 }
 
+void _handleRfTxPinListCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (list command should not have any arguments)");
+    return;
+  }
+
+  std::vector<gpio_num_t> txPins = OpenShock::CommandHandler::GetRfTxPins();
+
+  std::string list;
+  for (std::size_t i = 0; i < txPins.size(); ++i) {
+    if (i != 0) {
+      list.push_back(',');
+    }
+
+    list.append(std::to_string(static_cast<int>(txPins[i])));
+  }
+
+  SERPR_RESPONSE("RmtPins|%s", list.c_str());
+}
+
+void _handleRfTxPinAddCommand(std::string_view arg, bool isAutomated)
+{
+  gpio_num_t txPin;
+  if (!OpenShock::Convert::ToGpioNum(OpenShock::StringTrim(arg), txPin)) {
+    SERPR_ERROR("Invalid argument (number invalid or out of range)");
+    return;
+  }
+
+  switch (OpenShock::CommandHandler::AddRfTxPin(txPin)) {
+    case OpenShock::SetGPIOResultCode::InvalidPin:
+      SERPR_ERROR("Invalid argument (invalid pin or pin already in use)");
+      break;
+
+    case OpenShock::SetGPIOResultCode::Success:
+      SERPR_SUCCESS("Saved config");
+      break;
+
+    default:
+      SERPR_ERROR("Failed to add RF transmitter (limit is %d)", OPENSHOCK_RF_TX_MAX_TRANSMITTERS);
+      break;
+  }
+}
+
+void _handleRfTxPinRemoveCommand(std::string_view arg, bool isAutomated)
+{
+  uint8_t transmitter;
+  if (!OpenShock::Convert::ToUint8(OpenShock::StringTrim(arg), transmitter)) {
+    SERPR_ERROR("Invalid argument (number invalid or out of range)");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::RemoveRfTxPin(transmitter)) {
+    SERPR_ERROR("Failed to remove RF transmitter (the primary transmitter can't be removed)");
+    return;
+  }
+
+  SERPR_SUCCESS("Saved config");
+}
+
+static bool _parseRouteTarget(std::string_view arg, OpenShock::ShockerModelType& model, bool& byShockerId, uint16_t& shockerId)
+{
+  std::vector<std::string_view> parts = OpenShock::StringSplit(arg, ':');
+  if (parts.empty() || parts.size() > 2) {
+    return false;
+  }
+
+  std::string modelStr(OpenShock::StringTrim(parts[0]));
+  if (!OpenShock::ShockerModelTypeFromString(modelStr.c_str(), model, true)) {
+    return false;
+  }
+
+  byShockerId = parts.size() == 2;
+  shockerId   = 0;
+
+  return !byShockerId || OpenShock::Convert::ToUint16(OpenShock::StringTrim(parts[1]), shockerId);
+}
+
+void _handleRfTxPinRoutesCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (routes command should not have any arguments)");
+    return;
+  }
+
+  std::vector<OpenShock::Config::RFRoute> routes = OpenShock::CommandHandler::GetRfRoutes();
+
+  std::string list;
+  for (const auto& route : routes) {
+    if (!list.empty()) {
+      list.push_back(',');
+    }
+
+    list.append(OpenShock::Serialization::Types::EnumNameShockerModelType(route.model));
+    if (route.byShockerId) {
+      list.push_back(':');
+      list.append(std::to_string(route.shockerId));
+    }
+    list.push_back('>');
+    list.append(std::to_string(route.transmitter));
+  }
+
+  SERPR_RESPONSE("RmtRoutes|%s", list.c_str());
+}
+
+void _handleRfTxPinRouteCommand(std::string_view arg, bool isAutomated)
+{
+  std::vector<std::string_view> parts = OpenShock::StringSplitWhiteSpace(OpenShock::StringTrim(arg));
+  if (parts.size() != 2) {
+    SERPR_ERROR("Invalid argument count");
+    return;
+  }
+
+  OpenShock::Config::RFRoute route {};
+  if (!_parseRouteTarget(parts[0], route.model, route.byShockerId, route.shockerId)) {
+    SERPR_ERROR("Invalid argument (target must be <model> or <model>:<shockerId>)");
+    return;
+  }
+
+  if (!OpenShock::Convert::ToUint8(parts[1], route.transmitter)) {
+    SERPR_ERROR("Invalid argument (transmitter must be a number)");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::SetRfRoute(route)) {
+    SERPR_ERROR("Failed to set route (transmitter does not exist?)");
+    return;
+  }
+
+  SERPR_SUCCESS("Saved config");
+}
+
+void _handleRfTxPinUnrouteCommand(std::string_view arg, bool isAutomated)
+{
+  OpenShock::ShockerModelType model;
+  bool byShockerId;
+  uint16_t shockerId;
+  if (!_parseRouteTarget(OpenShock::StringTrim(arg), model, byShockerId, shockerId)) {
+    SERPR_ERROR("Invalid argument (target must be <model> or <model>:<shockerId>)");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::RemoveRfRoute(model, byShockerId, shockerId)) {
+    SERPR_ERROR("Failed to remove route (no such route?)");
+    return;
+  }
+
+  SERPR_SUCCESS("Saved config");
+}
+
+void _handleRfTxPinRepeatsCommand(std::string_view arg, bool isAutomated)
+{
+  if (!arg.empty()) {
+    SERPR_ERROR("Invalid command (repeats command should not have any arguments)");
+    return;
+  }
+
+  std::vector<OpenShock::Config::RFRepeatInterval> repeatIntervals = OpenShock::CommandHandler::GetRfRepeatIntervals();
+
+  std::string list;
+  for (const auto& repeatInterval : repeatIntervals) {
+    if (!list.empty()) {
+      list.push_back(',');
+    }
+
+    list.append(OpenShock::Serialization::Types::EnumNameShockerModelType(repeatInterval.model));
+    if (repeatInterval.byShockerId) {
+      list.push_back(':');
+      list.append(std::to_string(repeatInterval.shockerId));
+    }
+    list.push_back('=');
+    list.append(std::to_string(repeatInterval.intervalMs));
+  }
+
+  SERPR_RESPONSE("RmtRepeatIntervals|%s", list.c_str());
+}
+
+void _handleRfTxPinRepeatCommand(std::string_view arg, bool isAutomated)
+{
+  std::vector<std::string_view> parts = OpenShock::StringSplitWhiteSpace(OpenShock::StringTrim(arg));
+  if (parts.size() != 2) {
+    SERPR_ERROR("Invalid argument count");
+    return;
+  }
+
+  OpenShock::Config::RFRepeatInterval repeatInterval {};
+  if (!_parseRouteTarget(parts[0], repeatInterval.model, repeatInterval.byShockerId, repeatInterval.shockerId)) {
+    SERPR_ERROR("Invalid argument (target must be <model> or <model>:<shockerId>)");
+    return;
+  }
+
+  if (!OpenShock::Convert::ToUint16(parts[1], repeatInterval.intervalMs)) {
+    SERPR_ERROR("Invalid argument (interval must be a number of milliseconds)");
+    return;
+  }
+
+  if (!OpenShock::CommandHandler::SetRfRepeatInterval(repeatInterval)) {
+    SERPR_ERROR("Failed to save repeat interval");
+    return;
+  }
+
+  SERPR_SUCCESS("Saved config");
+}
+
 OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfTxPinHandler()
 {
   auto group = OpenShock::Serial::CommandGroup("rftxpin"sv);
@@ -54,5 +262,28 @@ OpenShock::Serial::CommandGroup OpenShock::Serial::CommandHandlers::RfTxPinHandl
   auto& setCommand = group.addCommand("Set the GPIO pin used for the radio transmitter"sv, _handleRfTxPinCommand);
   setCommand.addArgument("pin"sv, "must be a number"sv, "15"sv);
 
+  auto& listCommand = group.addCommand("list"sv, "List the GPIO pins of all radio transmitters, in transmitter order"sv, _handleRfTxPinListCommand);
+
+  auto& addCommand = group.addCommand("add"sv, "Add an extra radio transmitter"sv, _handleRfTxPinAddCommand);
+  addCommand.addArgument("pin"sv, "must be a number"sv, "4"sv);
+
+  auto& removeCommand = group.addCommand("remove"sv, "Remove an extra radio transmitter, routes to it fall back to the primary transmitter"sv, _handleRfTxPinRemoveCommand);
+  removeCommand.addArgument("transmitter"sv, "must be a number greater than 0"sv, "1"sv);
+
+  auto& routesCommand = group.addCommand("routes"sv, "List the shocker to transmitter routes"sv, _handleRfTxPinRoutesCommand);
+
+  auto& routeCommand = group.addCommand("route"sv, "Route a shocker model, or a single shocker, to a transmitter"sv, _handleRfTxPinRouteCommand);
+  routeCommand.addArgument("target"sv, "<model> or <model>:<shockerId>"sv, "caixianlin:1234"sv);
+  routeCommand.addArgument("transmitter"sv, "must be a number"sv, "1"sv);
+
+  auto& unrouteCommand = group.addCommand("unroute"sv, "Remove a route"sv, _handleRfTxPinUnrouteCommand);
+  unrouteCommand.addArgument("target"sv, "<model> or <model>:<shockerId>"sv, "caixianlin:1234"sv);
+
+  auto& repeatsCommand = group.addCommand("repeats"sv, "List the minimum repeat intervals of shockers"sv, _handleRfTxPinRepeatsCommand);
+
+  auto& repeatCommand = group.addCommand("repeat"sv, "Set the minimum time between two frames for a shocker model, or a single shocker, 0 removes it"sv, _handleRfTxPinRepeatCommand);
+  repeatCommand.addArgument("target"sv, "<model> or <model>:<shockerId>"sv, "caixianlin:1234"sv);
+  repeatCommand.addArgument("intervalMs"sv, "must be a number"sv, "200"sv);
+
   return group;
 }
@@ -1,6 +1,10 @@
 #include "serial/command_handlers/common.h"
 
+#include "CommandHandler.h"
 #include "FormatHelpers.h"
+#include "GatewayConnectionManager.h"
+#include "radio/rmt/SequenceCache.h"
+#include "serialization/BuilderPool.h"
 #include "Time.h"
 #include "wifi/WiFiManager.h"
 #include "wifi/WiFiNetwork.h"
@@ -20,6 +24,34 @@ void _handleDebugInfoCommand(std::string_view arg, bool isAutomated) {
   const int64_t days    = hours / 24;
   SERPR_RESPONSE("RTOSInfo|Uptime|%llid %llih %llim %llis", days, hours % 24, minutes % 60, seconds % 60);
 
+  OpenShock::Rmt::SequenceCache::Stats cacheStats = OpenShock::Rmt::SequenceCache::GetStats();
+  SERPR_RESPONSE("RFInfo|SequenceCache|%u/%u entries, %u pinned, %u hits, %u misses, %u evictions", cacheStats.entries, cacheStats.capacity, cacheStats.pinned, cacheStats.hits, cacheStats.misses, cacheStats.evictions);
+
+  OpenShock::TransmitScheduler::FrameRate frameRates[OpenShock::TransmitScheduler::kMaxShockers];
+  std::size_t frameRateCount = OpenShock::CommandHandler::GetFrameRates(frameRates, OpenShock::TransmitScheduler::kMaxShockers);
+  for (std::size_t i = 0; i < frameRateCount; ++i) {
+    SERPR_RESPONSE("RFInfo|FrameRate|%hu|%.2f fps", frameRates[i].shockerId, frameRates[i].framesPerSecond);
+  }
+
+  OpenShock::OutboundQueueStats outboxStats = OpenShock::GatewayConnectionManager::GetOutboxStats();
+  SERPR_RESPONSE("GatewayInfo|Outbox|%u pushed, %u sent, %u coalesced, %u rejected, %u failed", outboxStats.pushed, outboxStats.sent, outboxStats.coalesced, outboxStats.rejected, outboxStats.failed);
+
+  using namespace OpenShock::Serialization;
+
+  BuilderPool::Stats poolStats = BuilderPool::GetStats();
+  SERPR_RESPONSE("SerializationInfo|BuilderPool|%u leases, %u task hits, %u fallbacks, %u released", poolStats.leases, poolStats.taskHits, poolStats.fallbacks, poolStats.released);
+  for (std::size_t i = 0; i < BuilderPool::kKindCount; ++i) {
+    BuilderPool::MessageKind kind = static_cast<BuilderPool::MessageKind>(i);
+
+    BuilderPool::KindStats kindStats;
+    BuilderPool::GetKindStats(kind, kindStats);
+    if (kindStats.count == 0) {
+      continue;
+    }
+
+    SERPR_RESPONSE("SerializationInfo|%s|%u messages, %u bytes high-water, %u bytes initial", BuilderPool::MessageKindName(kind), kindStats.count, kindStats.highWater, BuilderPool::InitialSize(kind));
+  }
+
   OpenShock::WiFiNetwork network;
   bool connected = OpenShock::WiFiManager::GetConnectedNetwork(network);
   SERPR_RESPONSE("WiFiInfo|Connected|%s", connected ? "true" : "false");
@@ -0,0 +1,197 @@
+#include "serialization/BuilderPool.h"
+
+#include <array>
+#include <atomic>
+
+using namespace OpenShock::Serialization;
+
+namespace {
+  struct Slot {
+    std::atomic<bool> inUse;
+    bool hasBuffer;  // The builder holds a buffer from an earlier message, only touched by the lease holding the slot
+    flatbuffers::FlatBufferBuilder builder;
+  };
+
+  struct KindCounters {
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> highWater;
+  };
+}  // namespace
+
+// Not brace initialized, the builder's default constructor is explicit
+static std::array<Slot, BuilderPool::kSlotCount> s_slots;
+static std::array<KindCounters, BuilderPool::kKindCount> s_kinds = {};
+static std::atomic<uint32_t> s_leases                            = 0;
+static std::atomic<uint32_t> s_taskHits                          = 0;
+static std::atomic<uint32_t> s_fallbacks                         = 0;
+static std::atomic<uint32_t> s_released                          = 0;
+
+// Slot the calling task used last, kSlotCount if it has none yet
+static thread_local std::size_t s_taskSlot = BuilderPool::kSlotCount;
+
+static bool tryClaim(std::size_t slot)
+{
+  bool expected = false;
+  return s_slots[slot].inUse.compare_exchange_strong(expected, true, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+static std::size_t claimSlot()
+{
+  std::size_t preferred = s_taskSlot;
+  if (preferred < BuilderPool::kSlotCount && tryClaim(preferred)) {
+    s_taskHits.fetch_add(1, std::memory_order_relaxed);
+    return preferred;
+  }
+
+  for (std::size_t i = 0; i < BuilderPool::kSlotCount; ++i) {
+    if (i != preferred && tryClaim(i)) {
+      s_taskSlot = i;
+      return i;
+    }
+  }
+
+  return BuilderPool::kSlotCount;
+}
+
+BuilderPool::Lease::Lease(MessageKind kind)
+  : m_kind(kind)
+  , m_slot(claimSlot())
+  , m_builder(nullptr)
+  , m_fallback()
+{
+  s_leases.fetch_add(1, std::memory_order_relaxed);
+
+  if (m_slot == kSlotCount) {
+    s_fallbacks.fetch_add(1, std::memory_order_relaxed);
+    m_builder = &m_fallback.emplace(InitialSize(kind));
+    return;
+  }
+
+  Slot& slot = s_slots[m_slot];
+  if (!slot.hasBuffer) {
+    // Builders allocate lazily, so a fresh one costs nothing until the message is built
+    slot.builder = flatbuffers::FlatBufferBuilder(InitialSize(kind));
+  }
+
+  m_builder = &slot.builder;
+}
+
+BuilderPool::Lease::~Lease()
+{
+  uint32_t size = m_builder->GetSize();
+  if (size > 0) {
+    KindCounters& counters = s_kinds[static_cast<std::size_t>(m_kind)];
+
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t highWater = counters.highWater.load(std::memory_order_relaxed);
+    while (size > highWater && !counters.highWater.compare_exchange_weak(highWater, size, std::memory_order_relaxed)) { }
+  }
+
+  if (m_slot == kSlotCount) {
+    return;
+  }
+
+  Slot& slot = s_slots[m_slot];
+  if (size > kRetainSize) {
+    slot.builder.Reset();
+    slot.hasBuffer = false;
+    s_released.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    slot.builder.Clear();
+    slot.hasBuffer = slot.hasBuffer || size > 0;
+  }
+
+  slot.inUse.store(false, std::memory_order_release);
+}
+
+const char* BuilderPool::MessageKindName(MessageKind kind)
+{
+  switch (kind) {
+    case MessageKind::GatewayKeepAlive:
+      return "GatewayKeepAlive";
+    case MessageKind::GatewayBootStatus:
+      return "GatewayBootStatus";
+    case MessageKind::GatewayOtaInstallStarted:
+      return "GatewayOtaInstallStarted";
+    case MessageKind::GatewayOtaInstallProgress:
+      return "GatewayOtaInstallProgress";
+    case MessageKind::GatewayOtaInstallFailed:
+      return "GatewayOtaInstallFailed";
+    case MessageKind::GatewayRfQueueStatus:
+      return "GatewayRfQueueStatus";
+    case MessageKind::GatewayLatencyReport:
+      return "GatewayLatencyReport";
+    case MessageKind::LocalError:
+      return "LocalError";
+    case MessageKind::LocalReady:
+      return "LocalReady";
+    case MessageKind::LocalWiFiScanStatusChanged:
+      return "LocalWiFiScanStatusChanged";
+    case MessageKind::LocalWiFiNetwork:
+      return "LocalWiFiNetwork";
+    case MessageKind::LocalWiFiNetworks:
+      return "LocalWiFiNetworks";
+    default:
+      return "Unknown";
+  }
+}
+
+uint32_t BuilderPool::InitialSize(MessageKind kind)
+{
+  uint32_t highWater = s_kinds[static_cast<std::size_t>(kind)].highWater.load(std::memory_order_relaxed);
+  if (highWater == 0) {
+    return kDefaultInitialSize;
+  }
+
+  uint32_t size = kMinInitialSize;
+  while (size < highWater && size < kMaxLearnedInitialSize) {
+    size <<= 1;
+  }
+
+  return size;
+}
+
+void BuilderPool::GetKindStats(MessageKind kind, KindStats& out)
+{
+  const KindCounters& counters = s_kinds[static_cast<std::size_t>(kind)];
+
+  out.count     = counters.count.load(std::memory_order_relaxed);
+  out.highWater = counters.highWater.load(std::memory_order_relaxed);
+}
+
+BuilderPool::Stats BuilderPool::GetStats()
+{
+  return Stats {
+    .leases    = s_leases.load(std::memory_order_relaxed),
+    .taskHits  = s_taskHits.load(std::memory_order_relaxed),
+    .fallbacks = s_fallbacks.load(std::memory_order_relaxed),
+    .released  = s_released.load(std::memory_order_relaxed),
+  };
+}
+
+void BuilderPool::Reset()
+{
+  for (std::size_t i = 0; i < kSlotCount; ++i) {
+    if (!tryClaim(i)) {
+      continue;
+    }
+
+    Slot& slot = s_slots[i];
+
+    slot.builder.Reset();
+    slot.hasBuffer = false;
+
+    slot.inUse.store(false, std::memory_order_release);
+  }
+
+  for (KindCounters& counters : s_kinds) {
+    counters.count.store(0, std::memory_order_relaxed);
+    counters.highWater.store(0, std::memory_order_relaxed);
+  }
+
+  s_leases.store(0, std::memory_order_relaxed);
+  s_taskHits.store(0, std::memory_order_relaxed);
+  s_fallbacks.store(0, std::memory_order_relaxed);
+  s_released.store(0, std::memory_order_relaxed);
+}
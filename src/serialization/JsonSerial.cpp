@@ -3,6 +3,10 @@
 const char* const TAG = "JsonSerial";
 
 #include "Logging.h"
+#include "util/Base64Utils.h"
+
+#include <array>
+#include <cstring>
 
 using namespace OpenShock::Serialization;
 
@@ -89,13 +93,89 @@ bool JsonSerial::ParseShockerCommand(const cJSON* root, JsonSerial::ShockerComma
   }
   uint16_t durationMsU16 = static_cast<uint16_t>(durationMs->valueint);
 
+  // Optional, gateway time to start the command at
+  int64_t executeAtMsI64 = 0;
+
+  const cJSON* executeAtMs = cJSON_GetObjectItemCaseSensitive(root, "executeAtMs");
+  if (executeAtMs != nullptr) {
+    if (cJSON_IsNumber(executeAtMs) == 0) {
+      OS_LOGE(TAG, "value at 'executeAtMs' is not a number");
+      return false;
+    }
+    if (executeAtMs->valuedouble < 0) {
+      OS_LOGE(TAG, "value at 'executeAtMs' is negative");
+      return false;
+    }
+    executeAtMsI64 = static_cast<int64_t>(executeAtMs->valuedouble);
+  }
+
   out = {
-    .model      = modelType,
-    .id         = idU16,
-    .command    = commandType,
-    .intensity  = intensityU8,
-    .durationMs = durationMsU16,
+    .model       = modelType,
+    .id          = idU16,
+    .command     = commandType,
+    .intensity   = intensityU8,
+    .durationMs  = durationMsU16,
+    .executeAtMs = executeAtMsI64,
   };
 
   return true;
 }
+
+bool JsonSerial::ParseShockerWaveform(const cJSON* root, JsonSerial::ShockerWaveform& out) {
+  if (cJSON_IsObject(root) == 0) {
+    OS_LOGE(TAG, "not an object");
+    return false;
+  }
+
+  const cJSON* model = cJSON_GetObjectItemCaseSensitive(root, "model");
+  if (model == nullptr) {
+    OS_LOGE(TAG, "missing 'model' field");
+    return false;
+  }
+  if (cJSON_IsString(model) == 0) {
+    OS_LOGE(TAG, "value at 'model' is not a string");
+    return false;
+  }
+  ShockerModelType modelType;
+  if (!ShockerModelTypeFromString(model->valuestring, modelType)) {
+    OS_LOGE(TAG, "value at 'model' is not a valid shocker model (caixianlin, petrainer, petrainer998dr)");
+    return false;
+  }
+
+  const cJSON* id = cJSON_GetObjectItemCaseSensitive(root, "id");
+  if (id == nullptr) {
+    OS_LOGE(TAG, "missing 'id' field");
+    return false;
+  }
+  if (cJSON_IsNumber(id) == 0) {
+    OS_LOGE(TAG, "value at 'id' is not a number");
+    return false;
+  }
+  int idInt = id->valueint;
+  if (idInt < 0 || idInt > UINT16_MAX) {
+    OS_LOGE(TAG, "value at 'id' is out of range (0-65535)");
+    return false;
+  }
+
+  const cJSON* waveform = cJSON_GetObjectItemCaseSensitive(root, "waveform");
+  if (waveform == nullptr) {
+    OS_LOGE(TAG, "missing 'waveform' field");
+    return false;
+  }
+  if (cJSON_IsString(waveform) == 0) {
+    OS_LOGE(TAG, "value at 'waveform' is not a string");
+    return false;
+  }
+
+  std::array<uint8_t, Waveform::kMaxEncodedSize> buffer;
+  std::size_t length = Base64Utils::Decode(waveform->valuestring, strlen(waveform->valuestring), buffer.data(), buffer.size());
+  if (length == 0 || !Waveform::Parse(buffer.data(), length, out.waveform)) {
+    OS_LOGE(TAG, "value at 'waveform' is not a valid base64 encoded waveform");
+    return false;
+  }
+
+  out.model = modelType;
+  out.id    = static_cast<uint16_t>(idInt);
+
+  return true;
+}
@@ -3,13 +3,19 @@
 const char* const TAG = "WSGateway";
 
 #include "config/Config.h"
+#include "LatencyTrace.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 #include "Time.h"
 
+#include <algorithm>
+#include <array>
+
 using namespace OpenShock::Serialization;
 
 bool Gateway::SerializeKeepAliveMessage(Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayKeepAlive);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   int64_t uptime = OpenShock::millis();
   if (uptime < 0) {
@@ -30,7 +36,8 @@ bool Gateway::SerializeKeepAliveMessage(Common::SerializationCallbackFn callback
 }
 
 bool Gateway::SerializeBootStatusMessage(int32_t updateId, OpenShock::FirmwareBootType bootType, const OpenShock::SemVer& version, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayBootStatus);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto fbsVersion = Types::CreateSemVerDirect(builder, version.major, version.minor, version.patch, version.prerelease.data(), version.build.data());
 
@@ -46,7 +53,8 @@ bool Gateway::SerializeBootStatusMessage(int32_t updateId, OpenShock::FirmwareBo
 }
 
 bool Gateway::SerializeOtaInstallStartedMessage(int32_t updateId, const OpenShock::SemVer& version, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayOtaInstallStarted);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto versionOffset = Types::CreateSemVerDirect(builder, version.major, version.minor, version.patch, version.prerelease.data(), version.build.data());
 
@@ -62,7 +70,8 @@ bool Gateway::SerializeOtaInstallStartedMessage(int32_t updateId, const OpenShoc
 }
 
 bool Gateway::SerializeOtaInstallProgressMessage(int32_t updateId, Gateway::OtaInstallProgressTask task, float progress, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(64);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayOtaInstallProgress);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto otaInstallProgressOffset = Gateway::CreateOtaInstallProgress(builder, updateId, task, progress);
 
@@ -76,7 +85,8 @@ bool Gateway::SerializeOtaInstallProgressMessage(int32_t updateId, Gateway::OtaI
 }
 
 bool Gateway::SerializeOtaInstallFailedMessage(int32_t updateId, std::string_view message, bool fatal, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayOtaInstallFailed);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto messageOffset = builder.CreateString(message.data(), message.size());
 
@@ -90,3 +100,49 @@ bool Gateway::SerializeOtaInstallFailedMessage(int32_t updateId, std::string_vie
 
   return callback(span.data(), span.size());
 }
+
+bool Gateway::SerializeRfQueueStatusMessage(const OpenShock::RFQueueStatus& status, Common::SerializationCallbackFn callback) {
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayRfQueueStatus);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
+
+  bool rejectNew = status.policy == OpenShock::RFQueuePolicy::RejectNew;
+
+  auto rfQueueStatusOffset = Gateway::CreateRfQueueStatus(builder, status.transmitter, status.depth, status.capacity, rejectNew, status.rejected, status.dropped, status.coalesced);
+
+  auto msg = Gateway::CreateHubToGatewayMessage(builder, Gateway::HubToGatewayMessagePayload::RfQueueStatus, rfQueueStatusOffset.Union());
+
+  Gateway::FinishHubToGatewayMessageBuffer(builder, msg);
+
+  auto span = builder.GetBufferSpan();
+
+  return callback(span.data(), span.size());
+}
+
+bool Gateway::SerializeLatencyReportMessage(Common::SerializationCallbackFn callback) {
+  BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayLatencyReport);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
+
+  std::array<Gateway::LatencyStageStats, OpenShock::LatencyTrace::kStageCount> stages;
+  std::array<uint32_t, OpenShock::LatencyTrace::kStageCount * OpenShock::LatencyTrace::kBucketCount> buckets;
+
+  for (std::size_t i = 0; i < stages.size(); ++i) {
+    OpenShock::LatencyTrace::StageStats stats;
+    OpenShock::LatencyTrace::GetStats(static_cast<OpenShock::LatencyTrace::Stage>(i), stats);
+
+    stages[i] = Gateway::LatencyStageStats(static_cast<uint8_t>(i), stats.count, stats.sumUs, stats.maxUs);
+    std::copy(stats.buckets.begin(), stats.buckets.end(), buckets.begin() + i * OpenShock::LatencyTrace::kBucketCount);
+  }
+
+  auto stagesOffset  = builder.CreateVectorOfStructs(stages.data(), stages.size());
+  auto bucketsOffset = builder.CreateVector(buckets.data(), buckets.size());
+
+  auto latencyReportOffset = Gateway::CreateLatencyReport(builder, stagesOffset, bucketsOffset);
+
+  auto msg = Gateway::CreateHubToGatewayMessage(builder, Gateway::HubToGatewayMessagePayload::LatencyReport, latencyReportOffset.Union());
+
+  Gateway::FinishHubToGatewayMessageBuffer(builder, msg);
+
+  auto span = builder.GetBufferSpan();
+
+  return callback(span.data(), span.size());
+}
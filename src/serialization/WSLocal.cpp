@@ -5,6 +5,7 @@ const char* const TAG = "WSLocal";
 #include "Chipset.h"
 #include "config/Config.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 #include "util/HexUtils.h"
 #include "wifi/WiFiNetwork.h"
 
@@ -47,7 +48,8 @@ flatbuffers::Offset<OpenShock::Serialization::Types::WifiNetwork> _createWiFiNet
 }
 
 bool Local::SerializeErrorMessage(const char* message, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::LocalError);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto wrapperOffset = Local::CreateErrorMessage(builder, builder.CreateString(message));
 
@@ -63,7 +65,8 @@ bool Local::SerializeErrorMessage(const char* message, Common::SerializationCall
 }
 
 bool Local::SerializeReadyMessage(const WiFiNetwork* connectedNetwork, bool accountLinked, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);
+  BuilderPool::Lease lease(BuilderPool::MessageKind::LocalReady);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   flatbuffers::Offset<Serialization::Types::WifiNetwork> fbsNetwork = 0;
 
@@ -97,7 +100,8 @@ bool Local::SerializeReadyMessage(const WiFiNetwork* connectedNetwork, bool acco
 }
 
 bool Local::SerializeWiFiScanStatusChangedEvent(OpenShock::WiFiScanStatus status, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(32);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::LocalWiFiScanStatusChanged);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto scanStatusOffset = Serialization::Local::CreateWifiScanStatusMessage(builder, status);
 
@@ -111,7 +115,8 @@ bool Local::SerializeWiFiScanStatusChangedEvent(OpenShock::WiFiScanStatus status
 }
 
 bool Local::SerializeWiFiNetworkEvent(Types::WifiNetworkEventType eventType, const WiFiNetwork& network, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::LocalWiFiNetwork);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   auto networkOffset = _createWiFiNetwork(builder, network);
 
@@ -127,7 +132,8 @@ bool Local::SerializeWiFiNetworkEvent(Types::WifiNetworkEventType eventType, con
 }
 
 bool Local::SerializeWiFiNetworksEvent(Types::WifiNetworkEventType eventType, const std::vector<WiFiNetwork>& networks, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease(BuilderPool::MessageKind::LocalWiFiNetworks);
+  flatbuffers::FlatBufferBuilder& builder = lease.Get();
 
   std::vector<flatbuffers::Offset<Serialization::Types::WifiNetwork>> fbsNetworks;
   fbsNetworks.reserve(networks.size());
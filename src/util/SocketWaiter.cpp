@@ -0,0 +1,123 @@
+#include "util/SocketWaiter.h"
+
+const char* const TAG = "SocketWaiter";
+
+#include "Logging.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <lwip/sockets.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+using namespace OpenShock::Util;
+
+const uint32_t SELECT_ERROR_BACKOFF_MS = 10;  // A socket closed by another task fails the select until its owner notices, don't spin on it
+
+SocketWaiter::SocketWaiter()
+  : m_wakeFd(-1)
+  , m_wakePending(false)
+{
+}
+
+SocketWaiter::~SocketWaiter()
+{
+  if (m_wakeFd >= 0) {
+    close(m_wakeFd);
+  }
+}
+
+bool SocketWaiter::Init()
+{
+  if (m_wakeFd >= 0) {
+    return true;
+  }
+
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    OS_LOGE(TAG, "Failed to create wake socket: %d", errno);
+    return false;
+  }
+
+  sockaddr_in addr     = {};
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port        = 0;
+  socklen_t addrLen    = sizeof(addr);
+
+  // Bound to an ephemeral loopback port and connected to itself, so nothing else can wake us
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+    OS_LOGE(TAG, "Failed to set up wake socket: %d", errno);
+    close(fd);
+    return false;
+  }
+
+  m_wakeFd = fd;
+
+  return true;
+}
+
+void SocketWaiter::Wake()
+{
+  if (m_wakeFd < 0 || m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  uint8_t byte = 0;
+  if (send(m_wakeFd, &byte, 1, MSG_DONTWAIT) != 1) {
+    m_wakePending.store(false, std::memory_order_release);  // Nothing in flight, the next wake tries again
+  }
+}
+
+bool SocketWaiter::Wait(const int* fds, std::size_t count, uint32_t timeoutMs)
+{
+  fd_set readFds;
+  FD_ZERO(&readFds);
+
+  int maxFd = -1;
+  auto add  = [&readFds, &maxFd](int fd) {
+    if (fd < 0 || fd >= FD_SETSIZE) {
+      return;
+    }
+
+    FD_SET(fd, &readFds);
+    maxFd = std::max(maxFd, fd);
+  };
+
+  add(m_wakeFd);
+  for (std::size_t i = 0; i < count; ++i) {
+    add(fds[i]);
+  }
+
+  if (maxFd < 0) {
+    vTaskDelay(pdMS_TO_TICKS(timeoutMs));
+    return false;
+  }
+
+  timeval timeout;
+  timeout.tv_sec  = timeoutMs / 1000;
+  timeout.tv_usec = (timeoutMs % 1000) * 1000;
+
+  int ready = select(maxFd + 1, &readFds, nullptr, nullptr, &timeout);
+  if (ready < 0) {
+    OS_LOGV(TAG, "select failed: %d", errno);
+    vTaskDelay(pdMS_TO_TICKS(std::min(timeoutMs, SELECT_ERROR_BACKOFF_MS)));
+    return true;
+  }
+
+  if (ready == 0) {
+    return false;
+  }
+
+  if (m_wakeFd >= 0 && FD_ISSET(m_wakeFd, &readFds)) {
+    // Cleared before draining, a racing Wake either sends a byte the next Wait sees, or its byte is drained here and the caller picks up its work once we return
+    m_wakePending.store(false, std::memory_order_release);
+
+    uint8_t buffer[8];
+    while (recv(m_wakeFd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0) { }
+  }
+
+  return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// Counts heap allocations made by the test binary by replacing the global operator new, include it from exactly one file per test suite
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace OpenShock::Test {
+  inline std::atomic<std::size_t> g_allocations = 0;
+
+  /// @brief Number of heap allocations made since the program started
+  inline std::size_t Allocations()
+  {
+    return g_allocations.load(std::memory_order_relaxed);
+  }
+}  // namespace OpenShock::Test
+
+void* operator new(std::size_t size)
+{
+  OpenShock::Test::g_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+// Host stand-in for the arduino-esp32 RMT HAL
+//
+// Besides the symbol layout used by the encoders it provides a virtual RMT backend: every pulse train written to a channel is captured together with the
+// esp_timer time it was written at, see OpenShock::Test::VirtualRmt. Nothing is transmitted, and writes never fail unless a test asks them to.
+
+#include <esp_timer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+typedef struct {
+  union {
+    struct {
+      uint32_t duration0 : 15;
+      uint32_t level0    : 1;
+      uint32_t duration1 : 15;
+      uint32_t level1    : 1;
+    };
+    uint32_t val;
+  };
+} rmt_data_t;
+
+typedef enum {
+  RMT_MEM_64  = 1,
+  RMT_MEM_128 = 2,
+  RMT_MEM_192 = 3,
+  RMT_MEM_256 = 4,
+  RMT_MEM_320 = 5,
+  RMT_MEM_384 = 6,
+  RMT_MEM_448 = 7,
+  RMT_MEM_512 = 8,
+} rmt_reserve_memsize_t;
+
+#define RMT_TX_MODE true
+#define RMT_RX_MODE false
+
+struct rmt_obj_t {
+  int pin;
+  float tickNs;
+};
+
+namespace OpenShock::Test::VirtualRmt {
+  struct Capture {
+    int pin;
+    int64_t atUs;  // esp_timer time the pulse train was written at
+    float tickNs;
+    std::vector<rmt_data_t> pulses;
+    bool loop;  // Written with rmtLoop, repeats until the next write
+
+    /// @brief Time the pulse train takes on air, for a loop the time of one pass
+    inline int64_t airTimeUs() const
+    {
+      uint64_t ticks = 0;
+      for (const rmt_data_t& pulse : pulses) {
+        ticks += pulse.duration0 + pulse.duration1;
+      }
+
+      return static_cast<int64_t>(ticks * tickNs / 1000.0f);
+    }
+  };
+
+  inline std::mutex g_mutex;
+  inline std::vector<Capture> g_captures;
+  inline bool g_failWrites = false;
+
+  /// @brief Moves every capture recorded so far out of the backend
+  inline std::vector<Capture> TakeCaptures()
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    std::vector<Capture> captures;
+    captures.swap(g_captures);
+
+    return captures;
+  }
+
+  inline void SetFailWrites(bool fail)
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_failWrites = fail;
+  }
+}  // namespace OpenShock::Test::VirtualRmt
+
+inline rmt_obj_t* rmtInit(int pin, bool tx_not_rx, rmt_reserve_memsize_t memsize)
+{
+  (void)memsize;
+
+  if (pin < 0 || !tx_not_rx) {
+    return nullptr;
+  }
+
+  return new rmt_obj_t {.pin = pin, .tickNs = 1000.0f};
+}
+
+inline float rmtSetTick(rmt_obj_t* rmt, float tick)
+{
+  rmt->tickNs = tick;
+  return tick;
+}
+
+inline bool rmtWrite(rmt_obj_t* rmt, rmt_data_t* data, size_t size)
+{
+  using namespace OpenShock::Test::VirtualRmt;
+
+  std::lock_guard<std::mutex> lock(g_mutex);
+  if (rmt == nullptr || g_failWrites) {
+    return false;
+  }
+
+  g_captures.push_back(Capture {
+    .pin    = rmt->pin,
+    .atUs   = esp_timer_get_time(),
+    .tickNs = rmt->tickNs,
+    .pulses = std::vector<rmt_data_t>(data, data + size),
+    .loop   = false,
+  });
+
+  return true;
+}
+
+inline bool rmtLoop(rmt_obj_t* rmt, rmt_data_t* data, size_t size)
+{
+  if (!rmtWrite(rmt, data, size)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(OpenShock::Test::VirtualRmt::g_mutex);
+  OpenShock::Test::VirtualRmt::g_captures.back().loop = true;
+
+  return true;
+}
+
+/// @brief Like rmtWrite, but also lets the virtual clock (if enabled) run until the pulse train is done
+inline bool rmtWriteBlocking(rmt_obj_t* rmt, rmt_data_t* data, size_t size)
+{
+  if (!rmtWrite(rmt, data, size)) {
+    return false;
+  }
+
+  if (OpenShock::Test::VirtualClock::g_enabled.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(OpenShock::Test::VirtualRmt::g_mutex);
+    OpenShock::Test::VirtualClock::Advance(OpenShock::Test::VirtualRmt::g_captures.back().airTimeUs());
+  }
+
+  return true;
+}
+
+inline bool rmtDeinit(rmt_obj_t* rmt)
+{
+  delete rmt;
+  return true;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+// Host stand-in, pulled in by Logging.h but nothing from it is used on the host
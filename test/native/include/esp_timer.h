@@ -0,0 +1,40 @@
+#pragma once
+
+// Host stand-in for esp_timer, only the clock is needed
+//
+// Runs on the host steady clock, unless a test switches to the virtual clock to simulate time (see OpenShock::Test::VirtualClock).
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace OpenShock::Test::VirtualClock {
+  inline std::atomic<bool> g_enabled  = false;
+  inline std::atomic<int64_t> g_nowUs = 0;
+
+  /// @brief Makes esp_timer_get_time return nowUs until Disable is called
+  inline void Set(int64_t nowUs)
+  {
+    g_nowUs.store(nowUs, std::memory_order_relaxed);
+    g_enabled.store(true, std::memory_order_relaxed);
+  }
+
+  inline void Advance(int64_t us)
+  {
+    g_nowUs.fetch_add(us, std::memory_order_relaxed);
+  }
+
+  inline void Disable()
+  {
+    g_enabled.store(false, std::memory_order_relaxed);
+  }
+}  // namespace OpenShock::Test::VirtualClock
+
+inline int64_t esp_timer_get_time()
+{
+  if (OpenShock::Test::VirtualClock::g_enabled.load(std::memory_order_relaxed)) {
+    return OpenShock::Test::VirtualClock::g_nowUs.load(std::memory_order_relaxed);
+  }
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
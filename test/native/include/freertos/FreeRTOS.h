@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS types used by the code built in the native environment
+
+#include <cstdint>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS  ((TickType_t)1)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
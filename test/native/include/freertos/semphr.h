@@ -0,0 +1,36 @@
+#pragma once
+
+// Host stand-in for FreeRTOS mutexes, backed by std::timed_mutex (1 tick = 1 ms)
+
+#include "freertos/FreeRTOS.h"
+
+#include <chrono>
+#include <mutex>
+
+typedef std::timed_mutex* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+  return new std::timed_mutex();
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t mutex)
+{
+  delete mutex;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t xTicksToWait)
+{
+  if (xTicksToWait == portMAX_DELAY) {
+    mutex->lock();
+    return pdTRUE;
+  }
+
+  return mutex->try_lock_for(std::chrono::milliseconds(xTicksToWait)) ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+  mutex->unlock();
+  return pdTRUE;
+}
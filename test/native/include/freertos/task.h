@@ -0,0 +1,13 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS task calls used by the code built in the native environment (1 tick = 1 ms)
+
+#include "freertos/FreeRTOS.h"
+
+#include <chrono>
+#include <thread>
+
+inline void vTaskDelay(TickType_t xTicksToDelay)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+// Host stand-in, lwIP's BSD socket API matches the POSIX one
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
@@ -0,0 +1,130 @@
+#include <unity.h>
+
+#include "serialization/BuilderPool.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace OpenShock::Serialization;
+
+static uint32_t buildMessage(flatbuffers::FlatBufferBuilder& builder, std::size_t payloadSize)
+{
+  std::vector<uint8_t> payload(payloadSize, 0xA5);
+  builder.Finish(builder.CreateVector(payload));
+
+  return builder.GetSize();
+}
+
+void setUp()
+{
+  BuilderPool::Reset();
+}
+
+void tearDown() { }
+
+void test_task_gets_its_buffer_back()
+{
+  const uint8_t* first;
+  {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayKeepAlive);
+    buildMessage(lease.Get(), 100);
+    first = lease.Get().GetBufferPointer();
+  }
+
+  // Same slot and same buffer, cleared but not freed
+  for (int i = 0; i < 3; ++i) {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::GatewayKeepAlive);
+    TEST_ASSERT_EQUAL_UINT32(0, lease.Get().GetSize());
+    buildMessage(lease.Get(), 100);
+    TEST_ASSERT_EQUAL_PTR(first, lease.Get().GetBufferPointer());
+  }
+
+  BuilderPool::Stats stats = BuilderPool::GetStats();
+  TEST_ASSERT_EQUAL_UINT32(4, stats.leases);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(3, stats.taskHits);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.fallbacks);
+}
+
+void test_high_water_and_learned_initial_size()
+{
+  TEST_ASSERT_EQUAL_UINT32(BuilderPool::kDefaultInitialSize, BuilderPool::InitialSize(BuilderPool::MessageKind::LocalWiFiNetworks));
+
+  uint32_t largest;
+  {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::LocalWiFiNetworks);
+    largest = buildMessage(lease.Get(), 700);
+  }
+  {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::LocalWiFiNetworks);
+    buildMessage(lease.Get(), 40);
+  }
+
+  BuilderPool::KindStats kindStats;
+  BuilderPool::GetKindStats(BuilderPool::MessageKind::LocalWiFiNetworks, kindStats);
+  TEST_ASSERT_EQUAL_UINT32(2, kindStats.count);
+  TEST_ASSERT_EQUAL_UINT32(largest, kindStats.highWater);
+
+  uint32_t initialSize = BuilderPool::InitialSize(BuilderPool::MessageKind::LocalWiFiNetworks);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(largest, initialSize);
+  TEST_ASSERT_LESS_THAN_UINT32(largest * 2, initialSize);
+  TEST_ASSERT_EQUAL_UINT32(0, initialSize & (initialSize - 1));
+
+  // Other kinds learn separately
+  BuilderPool::GetKindStats(BuilderPool::MessageKind::GatewayKeepAlive, kindStats);
+  TEST_ASSERT_EQUAL_UINT32(0, kindStats.count);
+  TEST_ASSERT_EQUAL_UINT32(0, kindStats.highWater);
+}
+
+void test_exhausted_pool_falls_back()
+{
+  std::array<std::unique_ptr<BuilderPool::Lease>, BuilderPool::kSlotCount> held;
+  for (auto& lease : held) {
+    lease = std::make_unique<BuilderPool::Lease>(BuilderPool::MessageKind::LocalError);
+  }
+
+  {
+    BuilderPool::Lease nested(BuilderPool::MessageKind::LocalError);
+    for (auto& lease : held) {
+      TEST_ASSERT_NOT_EQUAL(&lease->Get(), &nested.Get());
+    }
+    buildMessage(nested.Get(), 16);
+  }
+
+  BuilderPool::Stats stats = BuilderPool::GetStats();
+  TEST_ASSERT_EQUAL_UINT32(BuilderPool::kSlotCount + 1, stats.leases);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.fallbacks);
+
+  // A fallback still teaches the kind its size
+  BuilderPool::KindStats kindStats;
+  BuilderPool::GetKindStats(BuilderPool::MessageKind::LocalError, kindStats);
+  TEST_ASSERT_EQUAL_UINT32(1, kindStats.count);
+}
+
+void test_big_message_gives_buffer_back()
+{
+  {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::LocalReady);
+    TEST_ASSERT_GREATER_THAN_UINT32(BuilderPool::kRetainSize, buildMessage(lease.Get(), BuilderPool::kRetainSize + 512));
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, BuilderPool::GetStats().released);
+
+  {
+    BuilderPool::Lease lease(BuilderPool::MessageKind::LocalReady);
+    buildMessage(lease.Get(), 128);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, BuilderPool::GetStats().released);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_task_gets_its_buffer_back);
+  RUN_TEST(test_high_water_and_learned_initial_size);
+  RUN_TEST(test_exhausted_pool_falls_back);
+  RUN_TEST(test_big_message_gives_buffer_back);
+
+  return UNITY_END();
+}
@@ -0,0 +1,100 @@
+#include <unity.h>
+
+#include "ClockSync.h"
+
+#include <cstdint>
+
+using namespace OpenShock;
+
+void setUp()
+{
+  ClockSync::Reset();
+}
+
+void tearDown() { }
+
+void test_not_synced_without_samples()
+{
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_FALSE(ClockSync::GetEstimate(1000, estimate));
+
+  int64_t local;
+  TEST_ASSERT_FALSE(ClockSync::ToLocalTime(5000, 1000, local));
+}
+
+void test_offset_from_round_trip_midpoint()
+{
+  // Sent at 1000, answered at gateway time 50'010, received at 1020: the gateway answered around 1010
+  TEST_ASSERT_TRUE(ClockSync::AddSample(1000, 50'010, 1020));
+
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_TRUE(ClockSync::GetEstimate(1020, estimate));
+  TEST_ASSERT_EQUAL_INT64(49'000, estimate.offsetMs);
+  TEST_ASSERT_EQUAL_INT64(20, estimate.rttMs);
+  TEST_ASSERT_EQUAL_UINT8(1, estimate.sampleCount);
+
+  int64_t local;
+  TEST_ASSERT_TRUE(ClockSync::ToLocalTime(50'500, 1020, local));
+  TEST_ASSERT_EQUAL_INT64(1500, local);
+}
+
+void test_shortest_round_trip_wins()
+{
+  // The slow sample spent more time on the way back, its offset is skewed
+  TEST_ASSERT_TRUE(ClockSync::AddSample(1000, 50'005, 1200));
+  TEST_ASSERT_TRUE(ClockSync::AddSample(16'000, 65'002, 16'004));
+  TEST_ASSERT_TRUE(ClockSync::AddSample(31'000, 80'030, 31'090));
+
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_TRUE(ClockSync::GetEstimate(31'090, estimate));
+  TEST_ASSERT_EQUAL_INT64(49'000, estimate.offsetMs);
+  TEST_ASSERT_EQUAL_INT64(4, estimate.rttMs);
+  TEST_ASSERT_EQUAL_UINT8(3, estimate.sampleCount);
+}
+
+void test_old_samples_expire()
+{
+  TEST_ASSERT_TRUE(ClockSync::AddSample(1000, 50'001, 1002));
+
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_TRUE(ClockSync::GetEstimate(1002 + ClockSync::kMaxSampleAgeMs, estimate));
+  TEST_ASSERT_FALSE(ClockSync::GetEstimate(1003 + ClockSync::kMaxSampleAgeMs, estimate));
+}
+
+void test_rejects_implausible_samples()
+{
+  TEST_ASSERT_FALSE(ClockSync::AddSample(1000, 50'000, 999));
+  TEST_ASSERT_FALSE(ClockSync::AddSample(1000, 0, 1010));
+
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_FALSE(ClockSync::GetEstimate(1010, estimate));
+}
+
+void test_window_keeps_recent_samples()
+{
+  // A very good sample falls out of the window once enough newer ones came in
+  TEST_ASSERT_TRUE(ClockSync::AddSample(0, 49'000, 0));
+  for (std::size_t i = 1; i <= ClockSync::kSampleCount; ++i) {
+    int64_t sentAt = i * 15'000;
+    TEST_ASSERT_TRUE(ClockSync::AddSample(sentAt, sentAt + 49'010, sentAt + 20));
+  }
+
+  ClockSync::Estimate estimate;
+  TEST_ASSERT_TRUE(ClockSync::GetEstimate(ClockSync::kSampleCount * 15'000 + 20, estimate));
+  TEST_ASSERT_EQUAL_INT64(20, estimate.rttMs);
+  TEST_ASSERT_EQUAL_UINT8(ClockSync::kSampleCount, estimate.sampleCount);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_not_synced_without_samples);
+  RUN_TEST(test_offset_from_round_trip_midpoint);
+  RUN_TEST(test_shortest_round_trip_wins);
+  RUN_TEST(test_old_samples_expire);
+  RUN_TEST(test_rejects_implausible_samples);
+  RUN_TEST(test_window_keeps_recent_samples);
+
+  return UNITY_END();
+}
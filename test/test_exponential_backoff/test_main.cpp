@@ -0,0 +1,57 @@
+#include <unity.h>
+
+#include "util/ExponentialBackoff.h"
+
+#include <cstdint>
+
+using namespace OpenShock::Util;
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_delays_double_up_to_the_cap()
+{
+  ExponentialBackoff backoff(1000, 60'000);
+
+  const uint32_t expected[] = {1000, 2000, 4000, 8000, 16'000, 32'000, 60'000, 60'000};
+  for (uint32_t ceiling : expected) {
+    TEST_ASSERT_EQUAL_UINT32(ceiling, backoff.ceilingMs());
+
+    // Half of the delay is fixed, the other half is jitter
+    ExponentialBackoff low  = backoff;
+    ExponentialBackoff high = backoff;
+    TEST_ASSERT_EQUAL_UINT32(ceiling - ceiling / 2, low.Fail(0));
+    TEST_ASSERT_EQUAL_UINT32(ceiling, high.Fail(ceiling / 2));
+
+    uint32_t delay = backoff.Fail(0xDEADBEEF);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ceiling - ceiling / 2, delay);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(ceiling, delay);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(8, backoff.failures());
+}
+
+void test_reset_starts_over()
+{
+  ExponentialBackoff backoff(500, 10'000);
+
+  for (int i = 0; i < 20; ++i) {
+    backoff.Fail(static_cast<uint32_t>(i) * 7919);
+  }
+  TEST_ASSERT_EQUAL_UINT32(10'000, backoff.ceilingMs());
+
+  backoff.Reset();
+  TEST_ASSERT_EQUAL_UINT32(0, backoff.failures());
+  TEST_ASSERT_EQUAL_UINT32(500, backoff.ceilingMs());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_delays_double_up_to_the_cap);
+  RUN_TEST(test_reset_starts_over);
+
+  return UNITY_END();
+}
@@ -0,0 +1,92 @@
+#include <unity.h>
+
+#include "radio/JitterBuffer.h"
+
+#include <array>
+#include <cstdint>
+
+using namespace OpenShock;
+
+namespace {
+  RFCommand makeCommand(uint16_t shockerId, int64_t executeAt)
+  {
+    RFCommand cmd {};
+    cmd.shockerId = shockerId;
+    cmd.executeAt = executeAt;
+
+    return cmd;
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_releases_in_execution_order()
+{
+  JitterBuffer buffer;
+
+  RFCommand a = makeCommand(1, 300);
+  RFCommand b = makeCommand(2, 100);
+  RFCommand c = makeCommand(3, 200);
+  TEST_ASSERT_TRUE(buffer.Push(&a));
+  TEST_ASSERT_TRUE(buffer.Push(&b));
+  TEST_ASSERT_TRUE(buffer.Push(&c));
+
+  TEST_ASSERT_EQUAL_INT64(100, buffer.NextRelease());
+  TEST_ASSERT_NULL(buffer.PopDue(99));
+
+  TEST_ASSERT_EQUAL_PTR(&b, buffer.PopDue(250));
+  TEST_ASSERT_EQUAL_PTR(&c, buffer.PopDue(250));
+  TEST_ASSERT_NULL(buffer.PopDue(250));
+  TEST_ASSERT_EQUAL_PTR(&a, buffer.PopDue(300));
+  TEST_ASSERT_TRUE(buffer.empty());
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, buffer.NextRelease());
+}
+
+void test_same_time_keeps_batch_order()
+{
+  JitterBuffer buffer;
+
+  std::array<RFCommand, 4> batch = {makeCommand(1, 500), makeCommand(2, 500), makeCommand(3, 500), makeCommand(4, 500)};
+  for (RFCommand& cmd : batch) {
+    TEST_ASSERT_TRUE(buffer.Push(&cmd));
+  }
+
+  for (RFCommand& cmd : batch) {
+    TEST_ASSERT_EQUAL_PTR(&cmd, buffer.PopDue(500));
+  }
+}
+
+void test_full_and_pop_shocker()
+{
+  JitterBuffer buffer;
+
+  std::array<RFCommand, JitterBuffer::kCapacity + 1> commands;
+  for (std::size_t i = 0; i < commands.size(); ++i) {
+    commands[i] = makeCommand(static_cast<uint16_t>(i), 1000 + i);
+  }
+
+  for (std::size_t i = 0; i < JitterBuffer::kCapacity; ++i) {
+    TEST_ASSERT_TRUE(buffer.Push(&commands[i]));
+  }
+  TEST_ASSERT_FALSE(buffer.Push(&commands.back()));
+
+  TEST_ASSERT_EQUAL_PTR(&commands[5], buffer.PopShocker(5));
+  TEST_ASSERT_NULL(buffer.PopShocker(5));
+  TEST_ASSERT_EQUAL_UINT(JitterBuffer::kCapacity - 1, buffer.size());
+
+  // Order is kept around the removed command
+  TEST_ASSERT_EQUAL_PTR(&commands[0], buffer.PopDue(INT64_MAX));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_releases_in_execution_order);
+  RUN_TEST(test_same_time_keeps_batch_order);
+  RUN_TEST(test_full_and_pop_shocker);
+
+  return UNITY_END();
+}
@@ -0,0 +1,176 @@
+#include <unity.h>
+
+#include "radio/KeepAliveScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <random>
+
+using namespace OpenShock;
+
+const int64_t INTERVAL = 60'000;
+const int64_t STAGGER  = 5000;
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_empty()
+{
+  KeepAliveScheduler scheduler(INTERVAL, STAGGER);
+
+  std::array<KeepAliveScheduler::Shocker, 4> due;
+
+  TEST_ASSERT_TRUE(scheduler.empty());
+  TEST_ASSERT_TRUE(scheduler.NextDeadline() == INT64_MAX);
+  TEST_ASSERT_EQUAL_UINT(0, scheduler.TakeDue(INT64_MAX - 1, due.data(), due.size()));
+}
+
+void test_deadlines_are_staggered_within_window()
+{
+  KeepAliveScheduler scheduler(INTERVAL, STAGGER);
+
+  std::array<KeepAliveScheduler::Shocker, 1> due;
+  std::map<int64_t, int> deadlines;
+
+  // Shockers that were active at the same moment must not all come due at once
+  for (uint16_t id = 1; id <= 32; ++id) {
+    KeepAliveScheduler single(INTERVAL, STAGGER);
+    single.Touch(ShockerModelType::CaiXianlin, id, 1000);
+
+    int64_t deadline = single.NextDeadline();
+    TEST_ASSERT_TRUE(deadline > 1000 + INTERVAL - STAGGER);
+    TEST_ASSERT_TRUE(deadline <= 1000 + INTERVAL);
+
+    ++deadlines[deadline];
+    scheduler.Touch(ShockerModelType::CaiXianlin, id, 1000);
+  }
+
+  TEST_ASSERT_TRUE(deadlines.size() >= 30);
+
+  // They come out one by one, in deadline order
+  int64_t previous = 0;
+  for (int i = 0; i < 32; ++i) {
+    int64_t deadline = scheduler.NextDeadline();
+    TEST_ASSERT_TRUE(deadline >= previous);
+    TEST_ASSERT_EQUAL_UINT(1, scheduler.TakeDue(deadline, due.data(), due.size()));
+    previous = deadline;
+  }
+}
+
+void test_take_due_reschedules()
+{
+  KeepAliveScheduler scheduler(INTERVAL, 0);
+
+  std::array<KeepAliveScheduler::Shocker, 4> due;
+
+  scheduler.Touch(ShockerModelType::Petrainer, 42, 0);
+  TEST_ASSERT_TRUE(scheduler.NextDeadline() == INTERVAL);
+  TEST_ASSERT_EQUAL_UINT(0, scheduler.TakeDue(INTERVAL - 1, due.data(), due.size()));
+
+  TEST_ASSERT_EQUAL_UINT(1, scheduler.TakeDue(INTERVAL + 10, due.data(), due.size()));
+  TEST_ASSERT_EQUAL_UINT16(42, due[0].shockerId);
+  TEST_ASSERT_TRUE(due[0].model == ShockerModelType::Petrainer);
+
+  TEST_ASSERT_EQUAL_UINT(1, scheduler.size());
+  TEST_ASSERT_TRUE(scheduler.NextDeadline() == INTERVAL + 10 + INTERVAL);
+}
+
+void test_touch_only_pushes_back()
+{
+  KeepAliveScheduler scheduler(INTERVAL, 0);
+
+  scheduler.Touch(ShockerModelType::CaiXianlin, 1, 5000);
+  scheduler.Touch(ShockerModelType::CaiXianlin, 1, 1000);  // Older activity arriving late
+  TEST_ASSERT_TRUE(scheduler.NextDeadline() == 5000 + INTERVAL);
+
+  scheduler.Touch(ShockerModelType::Petrainer998DR, 1, 9000);
+  TEST_ASSERT_TRUE(scheduler.NextDeadline() == 9000 + INTERVAL);
+  TEST_ASSERT_EQUAL_UINT(1, scheduler.size());
+
+  std::array<KeepAliveScheduler::Shocker, 1> due;
+  TEST_ASSERT_EQUAL_UINT(1, scheduler.TakeDue(9000 + INTERVAL, due.data(), due.size()));
+  TEST_ASSERT_TRUE(due[0].model == ShockerModelType::Petrainer998DR);
+}
+
+void test_take_due_respects_max_count()
+{
+  KeepAliveScheduler scheduler(INTERVAL, 0);
+
+  for (uint16_t id = 0; id < 10; ++id) {
+    scheduler.Touch(ShockerModelType::CaiXianlin, id, 0);
+  }
+
+  std::array<KeepAliveScheduler::Shocker, 4> due;
+  TEST_ASSERT_EQUAL_UINT(4, scheduler.TakeDue(INTERVAL, due.data(), due.size()));
+  TEST_ASSERT_EQUAL_UINT(4, scheduler.TakeDue(INTERVAL, due.data(), due.size()));
+  TEST_ASSERT_EQUAL_UINT(2, scheduler.TakeDue(INTERVAL, due.data(), due.size()));
+  TEST_ASSERT_EQUAL_UINT(0, scheduler.TakeDue(INTERVAL, due.data(), due.size()));
+}
+
+// Random activity checked against a brute force model of the deadlines
+void test_matches_brute_force()
+{
+  KeepAliveScheduler scheduler(INTERVAL, STAGGER);
+
+  std::map<uint16_t, int64_t> expected;
+  std::mt19937 rng(1234);
+
+  auto deadlineFor = [](uint16_t id, int64_t activity) {
+    KeepAliveScheduler single(INTERVAL, STAGGER);
+    single.Touch(ShockerModelType::CaiXianlin, id, activity);
+    return single.NextDeadline();
+  };
+
+  int64_t now = 0;
+  for (int step = 0; step < 5000; ++step) {
+    now += rng() % 2000;
+
+    if (rng() % 3 != 0) {
+      uint16_t id = rng() % 64;
+      scheduler.Touch(ShockerModelType::CaiXianlin, id, now);
+
+      int64_t deadline = deadlineFor(id, now);
+      auto it          = expected.find(id);
+      if (it == expected.end() || deadline > it->second) {
+        expected[id] = deadline;
+      }
+    }
+
+    std::array<KeepAliveScheduler::Shocker, 8> due;
+    std::size_t count = scheduler.TakeDue(now, due.data(), due.size());
+    for (std::size_t i = 0; i < count; ++i) {
+      auto it = expected.find(due[i].shockerId);
+      TEST_ASSERT_TRUE(it != expected.end());
+      TEST_ASSERT_TRUE(it->second <= now);
+      it->second = deadlineFor(due[i].shockerId, now);
+    }
+
+    int64_t earliest = INT64_MAX;
+    for (const auto& [id, deadline] : expected) {
+      earliest = std::min(earliest, deadline);
+    }
+
+    if (count < due.size()) {
+      TEST_ASSERT_TRUE(scheduler.NextDeadline() == earliest);
+    }
+  }
+
+  TEST_ASSERT_EQUAL_UINT(expected.size(), scheduler.size());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_empty);
+  RUN_TEST(test_deadlines_are_staggered_within_window);
+  RUN_TEST(test_take_due_reschedules);
+  RUN_TEST(test_touch_only_pushes_back);
+  RUN_TEST(test_take_due_respects_max_count);
+  RUN_TEST(test_matches_brute_force);
+
+  return UNITY_END();
+}
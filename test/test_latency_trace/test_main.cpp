@@ -0,0 +1,108 @@
+#include <unity.h>
+
+#include "LatencyTrace.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace OpenShock;
+
+void setUp()
+{
+  LatencyTrace::Reset();
+}
+
+void tearDown()
+{
+  LatencyTrace::End();
+}
+
+void test_bucket_bounds()
+{
+  TEST_ASSERT_EQUAL_UINT32(128, LatencyTrace::BucketUpperBoundUs(0));
+  TEST_ASSERT_EQUAL_UINT32(256, LatencyTrace::BucketUpperBoundUs(1));
+  TEST_ASSERT_EQUAL_UINT32(128u << (LatencyTrace::kBucketCount - 2), LatencyTrace::BucketUpperBoundUs(LatencyTrace::kBucketCount - 2));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, LatencyTrace::BucketUpperBoundUs(LatencyTrace::kBucketCount - 1));
+}
+
+void test_record_histogram()
+{
+  LatencyTrace::Record(LatencyTrace::Stage::Emit, 0);
+  LatencyTrace::Record(LatencyTrace::Stage::Emit, 127);
+  LatencyTrace::Record(LatencyTrace::Stage::Emit, 128);
+  LatencyTrace::Record(LatencyTrace::Stage::Emit, 1'000'000);
+
+  LatencyTrace::StageStats stats;
+  LatencyTrace::GetStats(LatencyTrace::Stage::Emit, stats);
+
+  TEST_ASSERT_EQUAL_UINT32(4, stats.count);
+  TEST_ASSERT_EQUAL_UINT32(1'000'255, stats.sumUs);
+  TEST_ASSERT_EQUAL_UINT32(1'000'000, stats.maxUs);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.buckets[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.buckets[1]);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.buckets[LatencyTrace::kBucketCount - 1]);
+
+  // Other stages are untouched
+  LatencyTrace::GetStats(LatencyTrace::Stage::Total, stats);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+}
+
+void test_mark_without_trace_is_ignored()
+{
+  TEST_ASSERT_TRUE(LatencyTrace::Origin() == 0);
+
+  LatencyTrace::Mark(LatencyTrace::Stage::Verify);
+
+  LatencyTrace::StageStats stats;
+  LatencyTrace::GetStats(LatencyTrace::Stage::Verify, stats);
+  TEST_ASSERT_EQUAL_UINT32(0, stats.count);
+}
+
+void test_marks_measure_since_previous_stage()
+{
+  LatencyTrace::Begin();
+  TEST_ASSERT_TRUE(LatencyTrace::Origin() != 0);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  LatencyTrace::Mark(LatencyTrace::Stage::Verify);
+  LatencyTrace::Mark(LatencyTrace::Stage::Dispatch);
+  LatencyTrace::End();
+
+  TEST_ASSERT_TRUE(LatencyTrace::Origin() == 0);
+
+  LatencyTrace::StageStats verify;
+  LatencyTrace::StageStats dispatch;
+  LatencyTrace::GetStats(LatencyTrace::Stage::Verify, verify);
+  LatencyTrace::GetStats(LatencyTrace::Stage::Dispatch, dispatch);
+
+  TEST_ASSERT_EQUAL_UINT32(1, verify.count);
+  TEST_ASSERT_TRUE(verify.maxUs >= 2000);
+  TEST_ASSERT_EQUAL_UINT32(1, dispatch.count);
+  TEST_ASSERT_TRUE(dispatch.maxUs < verify.maxUs);
+}
+
+void test_trace_is_per_task()
+{
+  LatencyTrace::Begin();
+
+  int64_t otherOrigin = -1;
+  std::thread other([&otherOrigin]() { otherOrigin = LatencyTrace::Origin(); });
+  other.join();
+
+  TEST_ASSERT_TRUE(otherOrigin == 0);
+  TEST_ASSERT_TRUE(LatencyTrace::Origin() != 0);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_bucket_bounds);
+  RUN_TEST(test_record_histogram);
+  RUN_TEST(test_mark_without_trace_is_ignored);
+  RUN_TEST(test_marks_measure_since_previous_stage);
+  RUN_TEST(test_trace_is_per_task);
+
+  return UNITY_END();
+}
@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#include "OutboundQueue.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace OpenShock;
+
+typedef OutboundQueue<8, 32> TestQueue;
+
+struct Received {
+  WebSocketMessageType type;
+  std::vector<uint8_t> data;
+};
+
+static std::size_t drainInto(TestQueue& queue, std::vector<Received>& out)
+{
+  return queue.Drain([&out](WebSocketMessageType type, const uint8_t* data, std::size_t length) {
+    out.push_back({type, std::vector<uint8_t>(data, data + length)});
+    return true;
+  });
+}
+
+static bool pushByte(TestQueue& queue, uint8_t value, OutboundCoalesceKey key = OutboundCoalesceKey::None)
+{
+  return queue.Push(WebSocketMessageType::Binary, &value, 1, key);
+}
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_messages_drain_in_order()
+{
+  auto queue = std::make_unique<TestQueue>();
+
+  const char text[] = "hello";
+  TEST_ASSERT_TRUE(pushByte(*queue, 1));
+  TEST_ASSERT_TRUE(queue->Push(WebSocketMessageType::Text, reinterpret_cast<const uint8_t*>(text), 5));
+  TEST_ASSERT_TRUE(pushByte(*queue, 2));
+
+  std::vector<Received> received;
+  TEST_ASSERT_EQUAL_UINT(3, drainInto(*queue, received));
+  TEST_ASSERT_EQUAL_UINT(3, received.size());
+  TEST_ASSERT_EQUAL_UINT8(1, received[0].data[0]);
+  TEST_ASSERT_TRUE(received[1].type == WebSocketMessageType::Text);
+  TEST_ASSERT_EQUAL_MEMORY(text, received[1].data.data(), 5);
+  TEST_ASSERT_EQUAL_UINT8(2, received[2].data[0]);
+
+  TEST_ASSERT_EQUAL_UINT(0, drainInto(*queue, received));
+  TEST_ASSERT_EQUAL_UINT32(3, queue->stats().sent);
+}
+
+void test_full_queue_rejects_without_blocking()
+{
+  auto queue = std::make_unique<TestQueue>();
+
+  for (uint8_t i = 0; i < queue->capacity(); ++i) {
+    TEST_ASSERT_TRUE(pushByte(*queue, i));
+  }
+  TEST_ASSERT_FALSE(pushByte(*queue, 0xFF));
+
+  std::array<uint8_t, 33> tooBig = {};
+  std::vector<Received> received;
+  drainInto(*queue, received);
+  TEST_ASSERT_FALSE(queue->Push(WebSocketMessageType::Binary, tooBig.data(), tooBig.size()));
+
+  // Cells are reused once drained, the queue wraps around
+  for (uint8_t i = 0; i < queue->capacity(); ++i) {
+    TEST_ASSERT_TRUE(pushByte(*queue, i));
+  }
+
+  received.clear();
+  TEST_ASSERT_EQUAL_UINT(queue->capacity(), drainInto(*queue, received));
+  TEST_ASSERT_EQUAL_UINT8(queue->capacity() - 1, received.back().data[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, queue->stats().rejected);
+}
+
+void test_superseded_messages_are_coalesced()
+{
+  auto queue = std::make_unique<TestQueue>();
+
+  TEST_ASSERT_TRUE(pushByte(*queue, 10, OutboundCoalesceKey::OtaInstallProgress));
+  TEST_ASSERT_TRUE(pushByte(*queue, 1));
+  TEST_ASSERT_TRUE(pushByte(*queue, 20, OutboundCoalesceKey::OtaInstallProgress));
+  TEST_ASSERT_TRUE(pushByte(*queue, 30, OutboundCoalesceKey::OtaInstallProgress));
+  TEST_ASSERT_TRUE(pushByte(*queue, 2));
+
+  std::vector<Received> received;
+  TEST_ASSERT_EQUAL_UINT(5, drainInto(*queue, received));
+  TEST_ASSERT_EQUAL_UINT(3, received.size());
+  TEST_ASSERT_EQUAL_UINT8(1, received[0].data[0]);
+  TEST_ASSERT_EQUAL_UINT8(30, received[1].data[0]);
+  TEST_ASSERT_EQUAL_UINT8(2, received[2].data[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, queue->stats().coalesced);
+
+  // The newest one is sent even if nothing follows it
+  TEST_ASSERT_TRUE(pushByte(*queue, 40, OutboundCoalesceKey::OtaInstallProgress));
+  received.clear();
+  drainInto(*queue, received);
+  TEST_ASSERT_EQUAL_UINT(1, received.size());
+  TEST_ASSERT_EQUAL_UINT8(40, received[0].data[0]);
+}
+
+void test_discard_drops_everything()
+{
+  auto queue = std::make_unique<TestQueue>();
+
+  pushByte(*queue, 1);
+  pushByte(*queue, 2, OutboundCoalesceKey::OtaInstallProgress);
+  TEST_ASSERT_EQUAL_UINT(2, queue->Discard());
+
+  // The coalescing count of a discarded message does not linger
+  pushByte(*queue, 3, OutboundCoalesceKey::OtaInstallProgress);
+  std::vector<Received> received;
+  drainInto(*queue, received);
+  TEST_ASSERT_EQUAL_UINT(1, received.size());
+  TEST_ASSERT_EQUAL_UINT32(2, queue->stats().failed);
+}
+
+void test_concurrent_producers_keep_their_order()
+{
+  constexpr std::size_t kProducers = 4;
+  constexpr uint32_t kMessages     = 10'000;
+
+  auto queue = std::make_unique<TestQueue>();
+
+  std::atomic<std::size_t> finished = 0;
+  std::vector<std::thread> producers;
+  for (std::size_t p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, &finished, p]() {
+      for (uint32_t i = 0; i < kMessages;) {
+        uint8_t message[5] = {static_cast<uint8_t>(p), static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), static_cast<uint8_t>(i >> 16), static_cast<uint8_t>(i >> 24)};
+        if (queue->Push(WebSocketMessageType::Binary, message, sizeof(message))) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      finished.fetch_add(1);
+    });
+  }
+
+  // Producers race each other, but every producer's own messages must come out in the order it pushed them
+  std::array<uint32_t, kProducers> next = {};
+  bool ordered                          = true;
+
+  auto check = [&next, &ordered](WebSocketMessageType, const uint8_t* data, std::size_t length) {
+    uint32_t sequence = data[1] | (data[2] << 8) | (data[3] << 16) | (static_cast<uint32_t>(data[4]) << 24);
+    ordered           = ordered && length == 5 && sequence == next[data[0]];
+    next[data[0]]     = sequence + 1;
+    return true;
+  };
+
+  while (finished.load() < kProducers) {
+    if (queue->Drain(check) == 0) {
+      std::this_thread::yield();
+    }
+  }
+  while (queue->Drain(check) > 0) { }
+
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  TEST_ASSERT_TRUE(ordered);
+  for (std::size_t p = 0; p < kProducers; ++p) {
+    TEST_ASSERT_EQUAL_UINT32(kMessages, next[p]);
+  }
+  TEST_ASSERT_EQUAL_UINT32(kProducers * kMessages, queue->stats().sent);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_messages_drain_in_order);
+  RUN_TEST(test_full_queue_rejects_without_blocking);
+  RUN_TEST(test_superseded_messages_are_coalesced);
+  RUN_TEST(test_discard_drops_everything);
+  RUN_TEST(test_concurrent_producers_keep_their_order);
+
+  return UNITY_END();
+}
@@ -0,0 +1,195 @@
+#include <unity.h>
+
+#include "radio/RFStats.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace OpenShock;
+
+namespace {
+  uint32_t readU32(const std::vector<uint8_t>& data, std::size_t offset)
+  {
+    return static_cast<uint32_t>(data[offset]) | (static_cast<uint32_t>(data[offset + 1]) << 8) | (static_cast<uint32_t>(data[offset + 2]) << 16) | (static_cast<uint32_t>(data[offset + 3]) << 24);
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_counts_totals_and_shockers()
+{
+  RFStats stats;
+
+  stats.CountFrame(0x1234, 100);
+  stats.CountFrame(0x1234, 100);
+  stats.CountFrame(0x0042, 50);
+  stats.CountCommand(10);
+  stats.CountCommand(30);
+  stats.CountOverwrite(0x1234);
+  stats.CountDrop(0x0042);
+
+  RFStats::Totals totals = stats.GetTotals();
+  TEST_ASSERT_EQUAL_UINT32(3, totals.frames);
+  TEST_ASSERT_EQUAL_UINT32(250, totals.airTimeUs);
+  TEST_ASSERT_EQUAL_UINT32(2, totals.commands);
+  TEST_ASSERT_EQUAL_UINT32(40, totals.queueWaitUs);
+  TEST_ASSERT_EQUAL_UINT32(30, totals.queueWaitMaxUs);
+  TEST_ASSERT_EQUAL_UINT32(1, totals.overwrites);
+  TEST_ASSERT_EQUAL_UINT32(1, totals.drops);
+
+  std::array<RFStats::Shocker, RFStats::kMaxShockers> shockers;
+  TEST_ASSERT_EQUAL_UINT(2, stats.GetShockers(shockers.data(), shockers.size()));
+
+  // Slots are listed in the order shockers were first seen
+  TEST_ASSERT_EQUAL_HEX16(0x1234, shockers[0].shockerId);
+  TEST_ASSERT_EQUAL_UINT32(2, shockers[0].frames);
+  TEST_ASSERT_EQUAL_UINT32(200, shockers[0].airTimeUs);
+  TEST_ASSERT_EQUAL_UINT32(1, shockers[0].overwrites);
+  TEST_ASSERT_EQUAL_UINT32(0, shockers[0].drops);
+
+  TEST_ASSERT_EQUAL_HEX16(0x0042, shockers[1].shockerId);
+  TEST_ASSERT_EQUAL_UINT32(1, shockers[1].frames);
+  TEST_ASSERT_EQUAL_UINT32(1, shockers[1].drops);
+}
+
+void test_counts_burst_passes()
+{
+  RFStats stats;
+
+  stats.CountFrame(0x1234, 100);
+  stats.CountFrame(0x1234, 100, 5);
+
+  RFStats::Totals totals = stats.GetTotals();
+  TEST_ASSERT_EQUAL_UINT32(6, totals.frames);
+  TEST_ASSERT_EQUAL_UINT32(600, totals.airTimeUs);
+
+  std::array<RFStats::Shocker, RFStats::kMaxShockers> shockers;
+  TEST_ASSERT_EQUAL_UINT(1, stats.GetShockers(shockers.data(), shockers.size()));
+  TEST_ASSERT_EQUAL_UINT32(6, shockers[0].frames);
+  TEST_ASSERT_EQUAL_UINT32(600, shockers[0].airTimeUs);
+}
+
+void test_full_table_still_counts_totals()
+{
+  RFStats stats;
+
+  for (uint16_t id = 0; id < RFStats::kMaxShockers + 4; ++id) {
+    stats.CountFrame(id, 10);
+  }
+
+  std::array<RFStats::Shocker, RFStats::kMaxShockers> shockers;
+  TEST_ASSERT_EQUAL_UINT(RFStats::kMaxShockers, stats.GetShockers(shockers.data(), shockers.size()));
+  TEST_ASSERT_EQUAL_UINT32(RFStats::kMaxShockers + 4, stats.GetTotals().frames);
+}
+
+void test_reset_keeps_slots()
+{
+  RFStats stats;
+
+  stats.CountFrame(7, 100);
+  stats.CountCommand(500);
+  stats.Reset();
+
+  RFStats::Totals totals = stats.GetTotals();
+  TEST_ASSERT_EQUAL_UINT32(0, totals.frames);
+  TEST_ASSERT_EQUAL_UINT32(0, totals.airTimeUs);
+  TEST_ASSERT_EQUAL_UINT32(0, totals.commands);
+  TEST_ASSERT_EQUAL_UINT32(0, totals.queueWaitMaxUs);
+
+  std::array<RFStats::Shocker, RFStats::kMaxShockers> shockers;
+  TEST_ASSERT_EQUAL_UINT(1, stats.GetShockers(shockers.data(), shockers.size()));
+  TEST_ASSERT_EQUAL_UINT16(7, shockers[0].shockerId);
+  TEST_ASSERT_EQUAL_UINT32(0, shockers[0].frames);
+}
+
+void test_stop_latency_histogram()
+{
+  RFStats stats;
+
+  stats.CountStop(0);
+  stats.CountStop(999);
+  stats.CountStop(1000);
+  stats.CountStop(45'000);
+  stats.CountStop(250'000);
+
+  RFStats::Totals totals = stats.GetTotals();
+  TEST_ASSERT_EQUAL_UINT32(5, totals.stops);
+  TEST_ASSERT_EQUAL_UINT32(250'000, totals.stopLatencyMaxUs);
+
+  // Bucket bounds are exclusive upper bounds
+  TEST_ASSERT_EQUAL_UINT32(2, totals.stopLatency[0]);
+  TEST_ASSERT_EQUAL_UINT32(1, totals.stopLatency[1]);
+  TEST_ASSERT_EQUAL_UINT32(1, totals.stopLatency[5]);
+  TEST_ASSERT_EQUAL_UINT32(1, totals.stopLatency[RFStats::kStopLatencyBuckets - 1]);
+
+  stats.Reset();
+  totals = stats.GetTotals();
+  TEST_ASSERT_EQUAL_UINT32(0, totals.stops);
+  TEST_ASSERT_EQUAL_UINT32(0, totals.stopLatency[0]);
+}
+
+void test_serialize_layout()
+{
+  RFStats stats;
+
+  stats.CountFrame(0xBEEF, 0x01020304);
+  stats.CountDrop(0xBEEF);
+  stats.CountStop(3000);
+
+  std::array<RFStats::Snapshot, 2> snapshots;
+  snapshots[0].transmitter = 0;
+  snapshots[0].txPin       = 15;
+  stats.GetSnapshot(snapshots[0]);
+
+  snapshots[1]              = {};
+  snapshots[1].transmitter  = 1;
+  snapshots[1].txPin        = -1;
+  snapshots[1].shockerCount = 0;
+
+  std::vector<uint8_t> data;
+  RFStats::Serialize(snapshots.data(), snapshots.size(), data);
+
+  TEST_ASSERT_EQUAL_UINT(2 + (75 + 18) + 75, data.size());
+  TEST_ASSERT_EQUAL_UINT8(RFStats::kSnapshotVersion, data[0]);
+  TEST_ASSERT_EQUAL_UINT8(2, data[1]);
+
+  // First transmitter header
+  TEST_ASSERT_EQUAL_UINT8(0, data[2]);
+  TEST_ASSERT_EQUAL_UINT8(15, data[3]);
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 8));           // frames
+  TEST_ASSERT_EQUAL_HEX32(0x01020304, readU32(data, 12));  // airTimeUs
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 32));          // drops
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 36));          // stops
+  TEST_ASSERT_EQUAL_UINT32(3000, readU32(data, 40));       // stopLatencyMaxUs
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 52));          // stopLatency[2]
+  TEST_ASSERT_EQUAL_UINT8(1, data[76]);                    // shockerCount
+
+  // Its shocker, little endian
+  TEST_ASSERT_EQUAL_UINT8(0xEF, data[77]);
+  TEST_ASSERT_EQUAL_UINT8(0xBE, data[78]);
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 79));
+  TEST_ASSERT_EQUAL_HEX32(0x01020304, readU32(data, 83));
+  TEST_ASSERT_EQUAL_UINT32(1, readU32(data, 91));
+
+  // Second transmitter header
+  TEST_ASSERT_EQUAL_UINT8(1, data[95]);
+  TEST_ASSERT_EQUAL_UINT8(0xFF, data[96]);
+  TEST_ASSERT_EQUAL_UINT8(0, data[169]);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_counts_totals_and_shockers);
+  RUN_TEST(test_counts_burst_passes);
+  RUN_TEST(test_full_table_still_counts_totals);
+  RUN_TEST(test_reset_keeps_slots);
+  RUN_TEST(test_stop_latency_histogram);
+  RUN_TEST(test_serialize_layout);
+
+  return UNITY_END();
+}
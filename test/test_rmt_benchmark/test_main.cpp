@@ -0,0 +1,119 @@
+#include <unity.h>
+
+#include "AllocationCounter.h"
+
+#include "radio/rmt/MainEncoder.h"
+#include "radio/rmt/SequenceCache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Encoder microbenchmarks, reports ns per frame and heap allocations per frame.
+//
+// Timings are informational only (host CPU, not the ESP32), but allocations are asserted to be zero since the RF path must never touch the heap.
+
+using namespace OpenShock;
+
+const std::size_t BENCHMARK_FRAMES = 200'000;
+
+namespace {
+  struct Result {
+    double nsPerFrame;
+    double allocationsPerFrame;
+  };
+
+  // Keeps the optimizer from dropping the encoded frames
+  volatile uint32_t s_sink = 0;
+
+  template<typename Fn>
+  Result measure(Fn&& encode)
+  {
+    Rmt::Sequence sequence;
+
+    // Warm up, lets caches and mutexes initialize outside of the measurement
+    for (std::size_t i = 0; i < 1000; ++i) {
+      encode(i, sequence);
+    }
+
+    std::size_t allocations = Test::Allocations();
+    auto start              = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < BENCHMARK_FRAMES; ++i) {
+      encode(i, sequence);
+      s_sink = s_sink + sequence.pulses[sequence.length - 1].val;
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    allocations  = Test::Allocations() - allocations;
+
+    return Result {
+      .nsPerFrame          = static_cast<double>(elapsed) / BENCHMARK_FRAMES,
+      .allocationsPerFrame = static_cast<double>(allocations) / BENCHMARK_FRAMES,
+    };
+  }
+
+  void report(const char* name, const Result& result)
+  {
+    char message[128];
+    snprintf(message, sizeof(message), "%-28s %8.1f ns/frame %6.3f allocations/frame", name, result.nsPerFrame, result.allocationsPerFrame);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, result.allocationsPerFrame);
+  }
+
+  void benchmarkEncoder(ShockerModelType model, const char* name)
+  {
+    Result result = measure([model](std::size_t i, Rmt::Sequence& out) {
+      Rmt::GetSequence(model, static_cast<uint16_t>(i), ShockerCommandType::Shock, static_cast<uint8_t>(i % 100), out);
+    });
+
+    report(name, result);
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_benchmark_caixianlin()
+{
+  benchmarkEncoder(ShockerModelType::CaiXianlin, "CaiXianlin encode");
+}
+
+void test_benchmark_petrainer()
+{
+  benchmarkEncoder(ShockerModelType::Petrainer, "Petrainer encode");
+}
+
+void test_benchmark_petrainer998dr()
+{
+  benchmarkEncoder(ShockerModelType::Petrainer998DR, "Petrainer998DR encode");
+}
+
+void test_benchmark_sequence_cache_hit()
+{
+  Rmt::SequenceCache::Clear();
+
+  // Cycles through fewer commands than the cache holds, so every measured lookup is a hit
+  Result result = measure([](std::size_t i, Rmt::Sequence& out) {
+    Rmt::SequenceCache::GetSequence(ShockerModelType::CaiXianlin, 0x1234, ShockerCommandType::Vibrate, static_cast<uint8_t>(i % 16), out);
+  });
+
+  report("SequenceCache hit", result);
+
+  Rmt::SequenceCache::Stats stats = Rmt::SequenceCache::GetStats();
+  TEST_ASSERT_EQUAL_UINT32(16, stats.misses);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_benchmark_caixianlin);
+  RUN_TEST(test_benchmark_petrainer);
+  RUN_TEST(test_benchmark_petrainer998dr);
+  RUN_TEST(test_benchmark_sequence_cache_hit);
+
+  return UNITY_END();
+}
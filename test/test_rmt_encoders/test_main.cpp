@@ -0,0 +1,328 @@
+#include <unity.h>
+
+#include "AllocationCounter.h"
+
+#include "radio/rmt/MainEncoder.h"
+#include "radio/rmt/SequenceCache.h"
+#include "radio/RFCommand.h"
+#include "SlabPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+
+// Golden vectors for the RMT encoders.
+//
+// The timings and payload layouts below are written out by hand from the protocol documentation on purpose, they must not be derived from the encoder descriptors.
+// A frame is decoded back into its payload bits using these timings and compared against the expected payload.
+
+using namespace OpenShock;
+
+namespace {
+  struct Pulse {
+    uint16_t duration0;
+    uint8_t level0;
+    uint16_t duration1;
+    uint8_t level1;
+  };
+
+  struct ModelTimings {
+    ShockerModelType model;
+    const char* name;
+    std::size_t length;
+    Pulse preamble;
+    Pulse one;
+    Pulse zero;
+    std::array<Pulse, 3> postamble;
+    std::size_t postambleLength;
+  };
+
+  const ModelTimings kCaiXianlin = {
+    ShockerModelType::CaiXianlin, "CaiXianlin", 44, {1400, 1, 800, 0}, {800, 1, 300, 0}, {300, 1, 800, 0}, {{{300, 1, 800, 0}, {300, 1, 800, 0}, {300, 1, 800, 0}}}, 3,
+  };
+  const ModelTimings kPetrainer = {
+    ShockerModelType::Petrainer, "Petrainer", 42, {750, 1, 750, 0}, {200, 1, 1500, 0}, {200, 1, 750, 0}, {{{200, 1, 7000, 0}}}, 1,
+  };
+  const ModelTimings kPetrainer998DR = {
+    ShockerModelType::Petrainer998DR, "Petrainer998DR", 43, {1500, 1, 750, 0}, {750, 1, 250, 0}, {250, 1, 750, 0}, {{{250, 1, 750, 0}, {1500, 0, 1500, 0}}}, 2,
+  };
+
+  const std::array<const ModelTimings*, 3> kModels = {&kCaiXianlin, &kPetrainer, &kPetrainer998DR};
+
+  const std::array<uint16_t, 5> kShockerIds             = {0x0000, 0x0001, 0x1234, 0x8000, 0xFFFF};
+  const std::array<uint8_t, 8> kIntensities             = {0, 1, 50, 98, 99, 100, 101, 255};
+  const std::array<ShockerCommandType, 4> kCommandTypes = {ShockerCommandType::Stop, ShockerCommandType::Shock, ShockerCommandType::Vibrate, ShockerCommandType::Sound};
+  const ShockerCommandType kOutOfRangeType              = static_cast<ShockerCommandType>(4);
+  const uint64_t kNoPayload                             = UINT64_MAX;
+
+  bool samePulse(const rmt_data_t& actual, const Pulse& expected)
+  {
+    return actual.duration0 == expected.duration0 && actual.level0 == expected.level0 && actual.duration1 == expected.duration1 && actual.level1 == expected.level1;
+  }
+
+  /// @brief Decodes a frame back into its 40 payload bits, fails the test if any symbol doesn't match the model timings
+  uint64_t decodeFrame(const ModelTimings& timings, const Rmt::Sequence& sequence, const char* context)
+  {
+    TEST_ASSERT_EQUAL_UINT_MESSAGE(timings.length, sequence.size(), context);
+    TEST_ASSERT_TRUE_MESSAGE(samePulse(sequence.pulses[0], timings.preamble), context);
+
+    uint64_t payload = 0;
+    for (std::size_t i = 1; i <= 40; ++i) {
+      const rmt_data_t& pulse = sequence.pulses[i];
+
+      bool isOne  = samePulse(pulse, timings.one);
+      bool isZero = samePulse(pulse, timings.zero);
+      TEST_ASSERT_TRUE_MESSAGE(isOne || isZero, context);
+
+      payload = (payload << 1) | (isOne ? 1 : 0);
+    }
+
+    for (std::size_t i = 0; i < timings.postambleLength; ++i) {
+      TEST_ASSERT_TRUE_MESSAGE(samePulse(sequence.pulses[41 + i], timings.postamble[i]), context);
+    }
+
+    return payload;
+  }
+
+  uint64_t expectedPayload(ShockerModelType model, uint16_t id, ShockerCommandType type, uint8_t intensity)
+  {
+    if (type != ShockerCommandType::Shock && type != ShockerCommandType::Vibrate && type != ShockerCommandType::Sound) {
+      return kNoPayload;
+    }
+
+    unsigned typeIndex = static_cast<unsigned>(type) - 1;  // Shock = 0, Vibrate = 1, Sound = 2
+
+    switch (model) {
+      case ShockerModelType::CaiXianlin:
+      {
+        // [id:16][channel:4 = 0][type:4][intensity:8][sum of the 4 bytes before:8], intensity capped at 99, sound is always sent with intensity 0
+        uint64_t level = type == ShockerCommandType::Sound ? 0 : std::min<uint8_t>(intensity, 99);
+        uint64_t data  = (uint64_t(id) << 16) | (uint64_t(typeIndex + 1) << 8) | level;
+        uint8_t sum    = static_cast<uint8_t>((data >> 24) + (data >> 16) + (data >> 8) + data);
+        return (data << 8) | sum;
+      }
+      case ShockerModelType::Petrainer:
+        // [0x80 | 1 << type:8][id:16][intensity:8][~(0x01 | 0x80 >> type):8], intensity capped at 100
+        return (uint64_t(0x80 | (1 << typeIndex)) << 32) | (uint64_t(id) << 16) | (uint64_t(std::min<uint8_t>(intensity, 100)) << 8) | uint64_t(~(0x01 | (0x80 >> typeIndex)) & 0xFF);
+      case ShockerModelType::Petrainer998DR:
+        // [1000][1 << type:4][id:17][intensity:7][~(1000 >> type):4][1110], intensity capped at 100
+        return (uint64_t(0b1000) << 36) | (uint64_t(1 << typeIndex) << 32) | (uint64_t(id) << 15) | (uint64_t(std::min<uint8_t>(intensity, 100)) << 8) | (uint64_t(~(0b1000 >> typeIndex) & 0xF) << 4) | 0b1110;
+      default:
+        return kNoPayload;
+    }
+  }
+
+  void checkEncoding(const ModelTimings& timings, uint16_t id, ShockerCommandType type, uint8_t intensity, uint64_t expected)
+  {
+    char context[96];
+    snprintf(context, sizeof(context), "%s id=0x%04X type=%u intensity=%u", timings.name, id, static_cast<unsigned>(type), intensity);
+
+    Rmt::Sequence sequence;
+    sequence.length = 0xFF;  // Garbage, the encoder must always overwrite it
+
+    bool encoded = Rmt::GetSequence(timings.model, id, type, intensity, sequence);
+
+    if (expected == kNoPayload) {
+      TEST_ASSERT_FALSE_MESSAGE(encoded, context);
+      TEST_ASSERT_TRUE_MESSAGE(sequence.empty(), context);
+      return;
+    }
+
+    TEST_ASSERT_TRUE_MESSAGE(encoded, context);
+
+    uint64_t payload = decodeFrame(timings, sequence, context);
+    TEST_ASSERT_EQUAL_HEX64_MESSAGE(expected, payload, context);
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+// Captured from real frames, these must only change together with a hardware test
+void test_golden_vectors()
+{
+  struct Vector {
+    const ModelTimings& timings;
+    uint16_t id;
+    ShockerCommandType type;
+    uint8_t intensity;
+    uint64_t payload;
+  };
+
+  const Vector vectors[] = {
+    {    kCaiXianlin, 0x0000,   ShockerCommandType::Shock,  99, 0x00'00'01'63'64},
+    {    kCaiXianlin, 0x1234,   ShockerCommandType::Shock,  50, 0x12'34'01'32'79},
+    {    kCaiXianlin, 0xABCD, ShockerCommandType::Vibrate, 255, 0xAB'CD'02'63'DD},
+    {    kCaiXianlin, 0xFFFF,   ShockerCommandType::Sound,  80, 0xFF'FF'03'00'01},
+    {    kCaiXianlin, 0x8000, ShockerCommandType::Vibrate, 100, 0x80'00'02'63'E5},
+    {     kPetrainer, 0x0001,   ShockerCommandType::Sound,   0, 0x84'00'01'00'DE},
+    {     kPetrainer, 0x1234,   ShockerCommandType::Shock,  50, 0x81'12'34'32'7E},
+    {     kPetrainer, 0xABCD, ShockerCommandType::Vibrate, 255, 0x82'AB'CD'64'BE},
+    {     kPetrainer, 0xFFFF,   ShockerCommandType::Shock, 101, 0x81'FF'FF'64'7E},
+    {     kPetrainer, 0x8000, ShockerCommandType::Vibrate, 100, 0x82'80'00'64'BE},
+    {kPetrainer998DR, 0x0001,   ShockerCommandType::Sound,   0, 0x84'00'00'80'DE},
+    {kPetrainer998DR, 0x1234,   ShockerCommandType::Shock,  50, 0x81'09'1A'32'7E},
+    {kPetrainer998DR, 0xABCD, ShockerCommandType::Vibrate, 255, 0x82'55'E6'E4'BE},
+    {kPetrainer998DR, 0xFFFF,   ShockerCommandType::Shock, 101, 0x81'7F'FF'E4'7E},
+    {kPetrainer998DR, 0x8000,   ShockerCommandType::Sound, 100, 0x84'40'00'64'DE},
+  };
+
+  for (const Vector& vector : vectors) {
+    checkEncoding(vector.timings, vector.id, vector.type, vector.intensity, vector.payload);
+  }
+}
+
+// Every model, every command type and every intensity edge case against the reference layouts above
+void test_type_and_intensity_edges()
+{
+  for (const ModelTimings* timings : kModels) {
+    for (uint16_t id : kShockerIds) {
+      for (ShockerCommandType type : kCommandTypes) {
+        for (uint8_t intensity : kIntensities) {
+          checkEncoding(*timings, id, type, intensity, expectedPayload(timings->model, id, type, intensity));
+        }
+      }
+
+      checkEncoding(*timings, id, kOutOfRangeType, 50, kNoPayload);
+    }
+  }
+}
+
+// The full intensity range for one id per model, so a bad clamp or mask anywhere in the range is caught
+void test_full_intensity_range()
+{
+  for (const ModelTimings* timings : kModels) {
+    for (ShockerCommandType type : {ShockerCommandType::Shock, ShockerCommandType::Vibrate, ShockerCommandType::Sound}) {
+      for (unsigned intensity = 0; intensity <= 255; ++intensity) {
+        checkEncoding(*timings, 0x5A5A, type, static_cast<uint8_t>(intensity), expectedPayload(timings->model, 0x5A5A, type, static_cast<uint8_t>(intensity)));
+      }
+    }
+  }
+}
+
+void test_zero_sequence_is_vibrate_zero()
+{
+  for (const ModelTimings* timings : kModels) {
+    Rmt::Sequence zero;
+    TEST_ASSERT_TRUE(Rmt::GetZeroSequence(timings->model, 0x1234, zero));
+    TEST_ASSERT_EQUAL_HEX64(expectedPayload(timings->model, 0x1234, ShockerCommandType::Vibrate, 0), decodeFrame(*timings, zero, timings->name));
+  }
+}
+
+void test_unknown_model_is_rejected()
+{
+  Rmt::Sequence sequence;
+  sequence.length = 1;
+
+  TEST_ASSERT_FALSE(Rmt::GetSequence(static_cast<ShockerModelType>(0x7F), 0x1234, ShockerCommandType::Shock, 50, sequence));
+  TEST_ASSERT_TRUE(sequence.empty());
+}
+
+// The RF command path must not touch the heap once it is warmed up: encoding, cache hits and pooled commands
+void test_command_path_is_allocation_free()
+{
+  static SlabPool<RFCommand, 4> pool;
+
+  Rmt::SequenceCache::Clear();
+
+  // Warm the cache, this is allowed to allocate (mutex creation)
+  Rmt::Sequence warm;
+  TEST_ASSERT_TRUE(Rmt::SequenceCache::GetSequence(ShockerModelType::CaiXianlin, 0x1234, ShockerCommandType::Shock, 50, warm));
+
+  std::size_t before = Test::Allocations();
+
+  for (int i = 0; i < 1000; ++i) {
+    RFCommand* cmd = pool.Acquire();
+    TEST_ASSERT_NOT_NULL(cmd);
+
+    TEST_ASSERT_TRUE(Rmt::GetSequence(ShockerModelType::Petrainer998DR, 0x1234, ShockerCommandType::Vibrate, static_cast<uint8_t>(i), cmd->sequence));
+    TEST_ASSERT_TRUE(Rmt::SequenceCache::GetSequence(ShockerModelType::CaiXianlin, 0x1234, ShockerCommandType::Shock, 50, cmd->sequence));
+    TEST_ASSERT_TRUE(Rmt::SequenceCache::GetZeroSequence(ShockerModelType::Petrainer, static_cast<uint16_t>(i), cmd->zeroSequence));
+
+    pool.Release(cmd);
+  }
+
+  TEST_ASSERT_EQUAL_UINT(0, Test::Allocations() - before);
+}
+
+// Zero sequences of registered shockers are encoded up front and survive a full cache worth of other commands
+void test_pinned_zero_sequences_survive_eviction()
+{
+  Rmt::SequenceCache::Clear();
+
+  const Rmt::SequenceCache::PinnedShocker shockers[] = {
+    {.model = ShockerModelType::CaiXianlin, .shockerId = 0x1234},
+    {.model = ShockerModelType::Petrainer, .shockerId = 0x4321},
+    {.model = static_cast<ShockerModelType>(0x7F), .shockerId = 0x0001},  // Can't be encoded, skipped
+  };
+  TEST_ASSERT_EQUAL_UINT(2, Rmt::SequenceCache::SetPinned(shockers, 3));
+
+  Rmt::Sequence sequence;
+  for (int i = 1; i <= 100; ++i) {
+    TEST_ASSERT_TRUE(Rmt::SequenceCache::GetSequence(ShockerModelType::CaiXianlin, 0x1234, ShockerCommandType::Shock, static_cast<uint8_t>(i), sequence));
+  }
+
+  Rmt::SequenceCache::Stats before = Rmt::SequenceCache::GetStats();
+  TEST_ASSERT_EQUAL_UINT8(2, before.pinned);
+  TEST_ASSERT_NOT_EQUAL(0, before.evictions);
+
+  for (const auto& shocker : {shockers[0], shockers[1]}) {
+    TEST_ASSERT_TRUE(Rmt::SequenceCache::GetZeroSequence(shocker.model, shocker.shockerId, sequence));
+
+    Rmt::Sequence expected;
+    TEST_ASSERT_TRUE(Rmt::GetZeroSequence(shocker.model, shocker.shockerId, expected));
+    TEST_ASSERT_EQUAL_UINT(expected.length, sequence.length);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), sequence.data(), expected.length * sizeof(rmt_data_t));
+  }
+
+  Rmt::SequenceCache::Stats after = Rmt::SequenceCache::GetStats();
+  TEST_ASSERT_EQUAL_UINT32(before.misses, after.misses);
+  TEST_ASSERT_EQUAL_UINT32(before.hits + 2, after.hits);
+
+  // Pinning again replaces the set
+  TEST_ASSERT_EQUAL_UINT(1, Rmt::SequenceCache::SetPinned(shockers + 1, 1));
+  TEST_ASSERT_EQUAL_UINT8(1, Rmt::SequenceCache::GetStats().pinned);
+
+  Rmt::SequenceCache::Clear();
+  TEST_ASSERT_EQUAL_UINT8(0, Rmt::SequenceCache::GetStats().pinned);
+}
+
+void test_slab_pool_exhaustion()
+{
+  static SlabPool<RFCommand, 2> pool;
+
+  RFCommand* a = pool.Acquire();
+  RFCommand* b = pool.Acquire();
+
+  TEST_ASSERT_NOT_NULL(a);
+  TEST_ASSERT_NOT_NULL(b);
+  TEST_ASSERT_TRUE(a != b);
+  TEST_ASSERT_NULL(pool.Acquire());
+  TEST_ASSERT_EQUAL_UINT(0, pool.available());
+
+  pool.Release(a);
+  TEST_ASSERT_EQUAL_PTR(a, pool.Acquire());
+
+  pool.Release(a);
+  pool.Release(b);
+  TEST_ASSERT_EQUAL_UINT(2, pool.available());
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_golden_vectors);
+  RUN_TEST(test_type_and_intensity_edges);
+  RUN_TEST(test_full_intensity_range);
+  RUN_TEST(test_zero_sequence_is_vibrate_zero);
+  RUN_TEST(test_unknown_model_is_rejected);
+  RUN_TEST(test_command_path_is_allocation_free);
+  RUN_TEST(test_pinned_zero_sequences_survive_eviction);
+  RUN_TEST(test_slab_pool_exhaustion);
+
+  return UNITY_END();
+}
@@ -0,0 +1,432 @@
+#include <unity.h>
+
+#include "radio/rmt/MainDecoder.h"
+#include "radio/rmt/MainEncoder.h"
+#include "radio/rmt/SequenceCache.h"
+#include "radio/TransmitScheduler.h"
+#include "SlabPool.h"
+
+#include <esp32-hal-rmt.h>
+#include <esp_timer.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Soak test of the transmit path on the virtual RMT backend.
+//
+// Drives TransmitScheduler the way RFTransmitter's transmit task does, on a virtual clock, over a full table of shockers. Every captured pulse train is
+// decoded back into a command and checked against what should have been on air at that moment. Two workloads: a flood of thousands of commands per
+// second that mostly overwrite each other, and a steady load where nearly every command has to reach the air before it expires, which bounds the
+// deadline misses and the first frame latency.
+
+using namespace OpenShock;
+
+const int64_t SOAK_DURATION_US      = 60'000'000;  // Virtual time
+const int64_t TX_DONE_MARGIN_US     = 200;         // Same slack RFTransmitter leaves between frames
+const int64_t TRANSMIT_END_DURATION = 300;         // Zero sequence phase of the scheduler, in ms
+const int64_t LONGEST_FRAME_US      = 60'000;      // Petrainer frame plus the margin
+
+namespace {
+  struct Workload {
+    std::size_t hotShockers;
+    double hotIntervalMs;  // Mean time between commands per hot shocker
+    double coldIntervalMs;
+    std::pair<int, int> hotDurationMs;
+    std::pair<int, int> coldDurationMs;
+  };
+
+  // 8 hot shockers make 2000 commands per second, nearly all of them are overwritten before their first frame
+  const Workload FLOOD_WORKLOAD = {.hotShockers = 8, .hotIntervalMs = 4.0, .coldIntervalMs = 1500.0, .hotDurationMs = {500, 3000}, .coldDurationMs = {1000, 5000}};
+
+  // A few shockers driven from a live control at a couple of commands per second, the rest now and then, about 4 shockers active at any time
+  const Workload STEADY_WORKLOAD = {.hotShockers = 4, .hotIntervalMs = 1000.0, .coldIntervalMs = 8000.0, .hotDurationMs = {300, 800}, .coldDurationMs = {500, 2000}};
+
+  struct Result {
+    std::size_t submitted;
+    std::size_t owed;  // Commands that stayed active long enough that they had to go on air
+    std::size_t overwritten;
+    std::size_t missed;  // Owed commands that expired before their first frame
+    int64_t p50Us;
+    int64_t p99Us;
+    int64_t maxUs;
+  };
+
+  struct Shocker {
+    ShockerModelType model;
+    uint16_t id;
+    bool hot;
+  };
+
+  struct Event {
+    int64_t atUs;
+    std::size_t shocker;
+    ShockerCommandType type;
+    uint8_t intensity;
+    uint16_t durationMs;
+  };
+
+  struct Submitted {
+    Event event;
+    int64_t until;  // ms, like RFCommand::until
+    int64_t replacedAtUs;
+    int64_t firstFrameUs;
+  };
+
+  std::array<Shocker, TransmitScheduler::kMaxShockers> makeShockers(std::mt19937& rng, const Workload& workload)
+  {
+    const std::array<ShockerModelType, 3> models = {ShockerModelType::CaiXianlin, ShockerModelType::Petrainer, ShockerModelType::Petrainer998DR};
+
+    std::array<Shocker, TransmitScheduler::kMaxShockers> shockers;
+    for (std::size_t i = 0; i < shockers.size(); ++i) {
+      shockers[i] = Shocker {
+        .model = models[i % models.size()],
+        .id    = static_cast<uint16_t>((rng() & 0xFFF0) | i),  // Unique per shocker
+        .hot   = i < workload.hotShockers,
+      };
+    }
+
+    return shockers;
+  }
+
+  std::vector<Event> makeEvents(std::mt19937& rng, const Workload& workload, const std::array<Shocker, TransmitScheduler::kMaxShockers>& shockers)
+  {
+    const std::array<ShockerCommandType, 3> types = {ShockerCommandType::Shock, ShockerCommandType::Vibrate, ShockerCommandType::Sound};
+
+    std::uniform_int_distribution<int> typeDist(0, types.size() - 1);
+    std::uniform_int_distribution<int> intensityDist(0, 100);
+    std::uniform_int_distribution<int> hotDurationDist(workload.hotDurationMs.first, workload.hotDurationMs.second);
+    std::uniform_int_distribution<int> coldDurationDist(workload.coldDurationMs.first, workload.coldDurationMs.second);
+
+    std::vector<Event> events;
+    for (std::size_t i = 0; i < shockers.size(); ++i) {
+      std::exponential_distribution<double> interval(1.0 / (shockers[i].hot ? workload.hotIntervalMs : workload.coldIntervalMs));
+
+      double atMs = interval(rng);
+      while (atMs * 1000 < SOAK_DURATION_US) {
+        events.push_back(Event {
+          .atUs       = static_cast<int64_t>(atMs * 1000),
+          .shocker    = i,
+          .type       = types[typeDist(rng)],
+          .intensity  = static_cast<uint8_t>(intensityDist(rng)),
+          .durationMs = static_cast<uint16_t>(shockers[i].hot ? hotDurationDist(rng) : coldDurationDist(rng)),
+        });
+        atMs += interval(rng);
+      }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.atUs < b.atUs; });
+
+    return events;
+  }
+
+  Rmt::DecodedCommand expectedOnAir(const Shocker& shocker, ShockerCommandType type, uint8_t intensity)
+  {
+    // Whatever the encoder makes of the command (clamped intensity, silent sound), decoded
+    Rmt::Sequence sequence;
+    TEST_ASSERT_TRUE(Rmt::GetSequence(shocker.model, shocker.id, type, intensity, sequence));
+
+    Rmt::DecodedCommand decoded;
+    TEST_ASSERT_TRUE(Rmt::Decode(sequence.data(), sequence.size(), decoded));
+
+    return decoded;
+  }
+
+  Result runSoak(const Workload& workload, uint32_t seed)
+  {
+    std::mt19937 rng(seed);
+
+    std::array<Shocker, TransmitScheduler::kMaxShockers> shockers = makeShockers(rng, workload);
+    std::vector<Event> events                                     = makeEvents(rng, workload, shockers);
+
+    std::map<std::pair<ShockerModelType, uint16_t>, std::size_t> shockerIndex;
+    for (std::size_t i = 0; i < shockers.size(); ++i) {
+      shockerIndex[{shockers[i].model, shockers[i].id}] = i;
+    }
+
+    static SlabPool<RFCommand, 32> pool;
+    TransmitScheduler scheduler;
+
+    std::vector<Submitted> submitted;
+    submitted.reserve(events.size());
+    std::array<std::size_t, TransmitScheduler::kMaxShockers> latest;
+    latest.fill(std::numeric_limits<std::size_t>::max());
+
+    Test::VirtualClock::Set(0);
+    rmt_obj_t* rmt = rmtInit(4, RMT_TX_MODE, RMT_MEM_64);
+    rmtSetTick(rmt, 1000);
+
+    auto wallStart = std::chrono::steady_clock::now();
+
+    // Mirrors RFTransmitter::TransmitTask: take in commands, drop finished ones, pick the frame for the moment the channel is free
+    std::size_t nextEvent = 0;
+    int64_t nowUs         = 0;
+    while (nextEvent < events.size() || !scheduler.empty()) {
+      while (nextEvent < events.size() && events[nextEvent].atUs <= nowUs) {
+        const Event& event     = events[nextEvent++];
+        const Shocker& shocker = shockers[event.shocker];
+
+        RFCommand* cmd = pool.Acquire();
+        TEST_ASSERT_NOT_NULL(cmd);
+
+        cmd->until               = event.atUs / 1000 + event.durationMs;
+        cmd->shockerId           = shocker.id;
+        cmd->minRepeatIntervalMs = 0;
+        cmd->overwrite           = true;
+        cmd->next                = nullptr;
+        Rmt::SequenceCache::GetSequence(shocker.model, shocker.id, event.type, event.intensity, cmd->sequence);
+        Rmt::SequenceCache::GetZeroSequence(shocker.model, shocker.id, cmd->zeroSequence);
+
+        RFCommand* released = scheduler.Submit(cmd, nowUs / 1000);
+        if (released != nullptr) {
+          pool.Release(released);
+        }
+
+        if (latest[event.shocker] != std::numeric_limits<std::size_t>::max()) {
+          submitted[latest[event.shocker]].replacedAtUs = event.atUs;
+        }
+        latest[event.shocker] = submitted.size();
+        submitted.push_back(Submitted {.event = event, .until = cmd->until, .replacedAtUs = INT64_MAX, .firstFrameUs = INT64_MAX});
+      }
+
+      int64_t at = nowUs / 1000;
+
+      RFCommand* finished;
+      while ((finished = scheduler.PopFinished(at)) != nullptr) {
+        pool.Release(finished);
+      }
+
+      TransmitScheduler::Frame frame;
+      int64_t nextWakeup;
+      if (scheduler.Next(at, frame, nextWakeup)) {
+        Test::VirtualClock::Set(nowUs);
+        TEST_ASSERT_TRUE(rmtWrite(rmt, frame.sequence->data(), frame.sequence->size()));
+
+        nowUs += frame.sequence->airTime() + TX_DONE_MARGIN_US;
+        continue;
+      }
+
+      int64_t wakeupUs    = nextWakeup == INT64_MAX ? INT64_MAX : nextWakeup * 1000;
+      int64_t nextEventUs = nextEvent < events.size() ? events[nextEvent].atUs : INT64_MAX;
+      nowUs               = std::max(nowUs + 1, std::min(wakeupUs, nextEventUs));
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    rmtDeinit(rmt);
+
+    TEST_ASSERT_EQUAL_UINT(pool.capacity(), pool.available());
+
+    std::vector<Test::VirtualRmt::Capture> captures = Test::VirtualRmt::TakeCaptures();
+    TEST_ASSERT_TRUE(captures.size() > 1000);
+
+    // Replay the submissions next to the captures, so we know which command was active for every frame
+    std::size_t replayed = 0;
+    std::array<std::size_t, TransmitScheduler::kMaxShockers> active;
+    active.fill(std::numeric_limits<std::size_t>::max());
+
+    int64_t channelFreeUs  = 0;
+    std::size_t zeroFrames = 0;
+
+    for (const Test::VirtualRmt::Capture& capture : captures) {
+      // One frame at a time on the channel
+      TEST_ASSERT_TRUE(capture.atUs >= channelFreeUs);
+      channelFreeUs = capture.atUs + capture.airTimeUs();
+
+      while (replayed < submitted.size() && submitted[replayed].event.atUs <= capture.atUs) {
+        active[submitted[replayed].event.shocker] = replayed;
+        ++replayed;
+      }
+
+      Rmt::DecodedCommand decoded;
+      TEST_ASSERT_TRUE_MESSAGE(Rmt::Decode(capture.pulses.data(), capture.pulses.size(), decoded), "Captured frame does not decode");
+
+      auto it = shockerIndex.find({decoded.model, decoded.shockerId});
+      TEST_ASSERT_TRUE_MESSAGE(it != shockerIndex.end(), "Captured frame for an unknown shocker");
+
+      std::size_t index = it->second;
+      TEST_ASSERT_TRUE_MESSAGE(active[index] != std::numeric_limits<std::size_t>::max(), "Captured frame before any command for the shocker");
+
+      Submitted& command     = submitted[active[index]];
+      const Shocker& shocker = shockers[index];
+      int64_t atMs           = capture.atUs / 1000;
+
+      // Until the command expires its own frames go out, then only zero frames for a short while
+      Rmt::DecodedCommand expected;
+      if (atMs <= command.until) {
+        expected = expectedOnAir(shocker, command.event.type, command.event.intensity);
+        if (command.firstFrameUs == INT64_MAX) {
+          command.firstFrameUs = capture.atUs;
+        }
+      } else {
+        TEST_ASSERT_TRUE_MESSAGE(atMs <= command.until + TRANSMIT_END_DURATION, "Zero frames past the end phase");
+        expected = expectedOnAir(shocker, ShockerCommandType::Vibrate, 0);
+        ++zeroFrames;
+      }
+
+      TEST_ASSERT_TRUE(decoded.type == expected.type);
+      TEST_ASSERT_EQUAL_UINT8(expected.intensity, decoded.intensity);
+    }
+
+    // Every command that stayed active until it expired must have been on air before that
+    std::size_t owed        = 0;
+    std::size_t overwritten = 0;
+    std::size_t missed      = 0;
+    std::vector<int64_t> latencies;
+    for (const Submitted& command : submitted) {
+      int64_t deadlineUs = command.until * 1000;
+      if (command.replacedAtUs <= deadlineUs && command.firstFrameUs == INT64_MAX) {
+        ++overwritten;
+        continue;
+      }
+
+      ++owed;
+      if (command.firstFrameUs > deadlineUs) {
+        ++missed;
+        continue;
+      }
+
+      latencies.push_back(command.firstFrameUs - command.event.atUs);
+    }
+
+    TEST_ASSERT_TRUE(!latencies.empty());
+    std::sort(latencies.begin(), latencies.end());
+
+    Result result = {
+      .submitted   = submitted.size(),
+      .owed        = owed,
+      .overwritten = overwritten,
+      .missed      = missed,
+      .p50Us       = latencies[latencies.size() / 2],
+      .p99Us       = latencies[latencies.size() * 99 / 100],
+      .maxUs       = latencies.back(),
+    };
+
+    char message[256];
+    snprintf(message, sizeof(message), "%zu commands (%.0f per virtual second), %zu frames (%zu zero), %zu owed a frame, %zu missed, %zu overwritten before going on air", result.submitted, result.submitted / (SOAK_DURATION_US / 1e6), captures.size(), zeroFrames, owed, missed, overwritten);
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "first frame latency p50 %.1f ms, p99 %.1f ms, max %.1f ms, simulated at %.0f commands per wall second", result.p50Us / 1000.0, result.p99Us / 1000.0, result.maxUs / 1000.0, result.submitted / wallSeconds);
+    TEST_MESSAGE(message);
+
+    return result;
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown()
+{
+  Test::VirtualClock::Disable();
+  Test::VirtualRmt::TakeCaptures();
+}
+
+void test_decoders_round_trip()
+{
+  const std::array<ShockerModelType, 3> models = {ShockerModelType::CaiXianlin, ShockerModelType::Petrainer, ShockerModelType::Petrainer998DR};
+  const std::array<ShockerCommandType, 3> types = {ShockerCommandType::Shock, ShockerCommandType::Vibrate, ShockerCommandType::Sound};
+
+  for (ShockerModelType model : models) {
+    for (ShockerCommandType type : types) {
+      for (uint32_t id = 0; id <= 0xFFFF; id += 0x0FFF) {
+        for (uint8_t intensity = 0; intensity <= 100; intensity += 25) {
+          Rmt::Sequence sequence;
+          TEST_ASSERT_TRUE(Rmt::GetSequence(model, static_cast<uint16_t>(id), type, intensity, sequence));
+
+          Rmt::DecodedCommand decoded;
+          TEST_ASSERT_TRUE(Rmt::Decode(sequence.data(), sequence.size(), decoded));
+          TEST_ASSERT_TRUE(decoded.model == model);
+          TEST_ASSERT_EQUAL_UINT16(id, decoded.shockerId);
+          TEST_ASSERT_TRUE(decoded.type == type);
+
+          // Clamped per model, CaiXianlin sound is always sent silent
+          uint8_t expected = std::min<uint8_t>(intensity, model == ShockerModelType::CaiXianlin ? 99 : 100);
+          if (model == ShockerModelType::CaiXianlin && type == ShockerCommandType::Sound) {
+            expected = 0;
+          }
+          TEST_ASSERT_EQUAL_UINT8(expected, decoded.intensity);
+
+          // A flipped bit must never decode back to the same command
+          if (sequence.pulses[5].val != sequence.pulses[6].val) {
+            sequence.pulses[5] = sequence.pulses[6];
+            TEST_ASSERT_TRUE(!Rmt::Decode(sequence.data(), sequence.size(), decoded) || decoded.shockerId != id || decoded.intensity != expected || decoded.type != type);
+          }
+        }
+      }
+    }
+  }
+}
+
+void test_virtual_rmt_captures()
+{
+  Test::VirtualClock::Set(1000);
+
+  rmt_obj_t* rmt = rmtInit(4, RMT_TX_MODE, RMT_MEM_64);
+  TEST_ASSERT_NOT_NULL(rmt);
+  rmtSetTick(rmt, 1000);
+
+  Rmt::Sequence sequence;
+  TEST_ASSERT_TRUE(Rmt::GetSequence(ShockerModelType::Petrainer, 0x1234, ShockerCommandType::Vibrate, 42, sequence));
+
+  TEST_ASSERT_TRUE(rmtWriteBlocking(rmt, sequence.data(), sequence.size()));
+  TEST_ASSERT_TRUE(rmtWrite(rmt, sequence.data(), sequence.size()));
+
+  std::vector<Test::VirtualRmt::Capture> captures = Test::VirtualRmt::TakeCaptures();
+  TEST_ASSERT_EQUAL_UINT(2, captures.size());
+
+  // The blocking write let the virtual clock run for the duration of the frame
+  TEST_ASSERT_EQUAL_INT64(1000, captures[0].atUs);
+  TEST_ASSERT_EQUAL_INT64(sequence.airTime(), captures[0].airTimeUs());
+  TEST_ASSERT_EQUAL_INT64(1000 + captures[0].airTimeUs(), captures[1].atUs);
+  TEST_ASSERT_EQUAL_INT(4, captures[1].pin);
+
+  Rmt::DecodedCommand decoded;
+  TEST_ASSERT_TRUE(Rmt::Decode(captures[1].pulses.data(), captures[1].pulses.size(), decoded));
+  TEST_ASSERT_EQUAL_UINT16(0x1234, decoded.shockerId);
+  TEST_ASSERT_EQUAL_UINT8(42, decoded.intensity);
+
+  rmtDeinit(rmt);
+}
+
+void test_soak_flood_meets_every_deadline()
+{
+  Result result = runSoak(FLOOD_WORKLOAD, 0x50AC);
+
+  // Almost everything is overwritten, but whatever stays active long enough must still make it
+  TEST_ASSERT_TRUE(result.owed > 500);
+  TEST_ASSERT_EQUAL_UINT(0, result.missed);
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(TransmitScheduler::kMaxShockers * LONGEST_FRAME_US, result.maxUs);
+}
+
+void test_soak_steady_load_latency()
+{
+  Result result = runSoak(STEADY_WORKLOAD, 0x57EA);
+
+  // Most commands have to go on air here, otherwise the bounds below say little
+  TEST_ASSERT_TRUE(result.owed * 10 >= result.submitted * 9);
+
+  // A replacing command takes its shocker's turn, it waits for one frame of every other shocker that is active or in its zero phase. Short commands
+  // that arrive while most of the table is busy can run out before their turn, but only rarely.
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(result.owed / 100, result.missed);
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(2 * LONGEST_FRAME_US, result.p50Us);
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(8 * LONGEST_FRAME_US, result.p99Us);
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(TransmitScheduler::kMaxShockers * LONGEST_FRAME_US, result.maxUs);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_decoders_round_trip);
+  RUN_TEST(test_virtual_rmt_captures);
+  RUN_TEST(test_soak_flood_meets_every_deadline);
+  RUN_TEST(test_soak_steady_load_latency);
+
+  return UNITY_END();
+}
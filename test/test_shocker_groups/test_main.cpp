@@ -0,0 +1,100 @@
+#include <unity.h>
+
+#include "ShockerGroups.h"
+
+#include <array>
+#include <cstdint>
+
+using namespace OpenShock;
+
+static const ShockerGroups::Member kCollarA = {.model = ShockerModelType::CaiXianlin, .shockerId = 0x1234};
+static const ShockerGroups::Member kCollarB = {.model = ShockerModelType::Petrainer, .shockerId = 0x1234};
+static const ShockerGroups::Member kCollarC = {.model = ShockerModelType::Petrainer998DR, .shockerId = 0x0042};
+
+void setUp()
+{
+  ShockerGroups::Clear();
+}
+
+void tearDown() { }
+
+void test_unknown_group_is_empty()
+{
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+  TEST_ASSERT_EQUAL_UINT(0, ShockerGroups::GetMembers(7, members.data(), members.size()));
+}
+
+void test_define_replace_and_remove()
+{
+  const ShockerGroups::Member first[] = {kCollarA, kCollarB};
+  TEST_ASSERT_TRUE(ShockerGroups::Define(7, first, 2));
+
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+  TEST_ASSERT_EQUAL_UINT(2, ShockerGroups::GetMembers(7, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT16(kCollarA.shockerId, members[0].shockerId);
+  TEST_ASSERT_TRUE(members[1].model == ShockerModelType::Petrainer);
+
+  // A new definition replaces the members instead of adding to them
+  const ShockerGroups::Member second[] = {kCollarC};
+  TEST_ASSERT_TRUE(ShockerGroups::Define(7, second, 1));
+  TEST_ASSERT_EQUAL_UINT(1, ShockerGroups::GetMembers(7, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT16(kCollarC.shockerId, members[0].shockerId);
+  TEST_ASSERT_EQUAL_UINT(1, ShockerGroups::Count());
+
+  TEST_ASSERT_TRUE(ShockerGroups::Define(7, nullptr, 0));
+  TEST_ASSERT_EQUAL_UINT(0, ShockerGroups::GetMembers(7, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT(0, ShockerGroups::Count());
+}
+
+void test_duplicate_members_are_dropped()
+{
+  const ShockerGroups::Member list[] = {kCollarA, kCollarB, kCollarA, kCollarB, kCollarC};
+  TEST_ASSERT_TRUE(ShockerGroups::Define(1, list, 5));
+
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+  TEST_ASSERT_EQUAL_UINT(3, ShockerGroups::GetMembers(1, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT16(kCollarC.shockerId, members[2].shockerId);
+}
+
+void test_limits_keep_previous_definition()
+{
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers + 1> tooMany;
+  for (std::size_t i = 0; i < tooMany.size(); ++i) {
+    tooMany[i] = {.model = ShockerModelType::CaiXianlin, .shockerId = static_cast<uint16_t>(i)};
+  }
+
+  TEST_ASSERT_TRUE(ShockerGroups::Define(0, &kCollarA, 1));
+  TEST_ASSERT_FALSE(ShockerGroups::Define(0, tooMany.data(), tooMany.size()));
+  TEST_ASSERT_TRUE(ShockerGroups::Define(0, tooMany.data(), ShockerGroups::kMaxMembers));
+
+  std::array<ShockerGroups::Member, ShockerGroups::kMaxMembers> members;
+  TEST_ASSERT_EQUAL_UINT(ShockerGroups::kMaxMembers, ShockerGroups::GetMembers(0, members.data(), members.size()));
+
+  // Only maxCount members are copied out
+  TEST_ASSERT_EQUAL_UINT(4, ShockerGroups::GetMembers(0, members.data(), 4));
+
+  for (uint16_t id = 1; id < ShockerGroups::kMaxGroups; ++id) {
+    TEST_ASSERT_TRUE(ShockerGroups::Define(id, &kCollarB, 1));
+  }
+  TEST_ASSERT_FALSE(ShockerGroups::Define(ShockerGroups::kMaxGroups, &kCollarB, 1));
+
+  // Removing one frees its slot, the other groups stay intact
+  TEST_ASSERT_TRUE(ShockerGroups::Define(3, nullptr, 0));
+  TEST_ASSERT_TRUE(ShockerGroups::Define(ShockerGroups::kMaxGroups, &kCollarC, 1));
+  TEST_ASSERT_EQUAL_UINT(ShockerGroups::kMaxGroups, ShockerGroups::Count());
+  TEST_ASSERT_EQUAL_UINT(ShockerGroups::kMaxMembers, ShockerGroups::GetMembers(0, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT(1, ShockerGroups::GetMembers(ShockerGroups::kMaxGroups - 1, members.data(), members.size()));
+  TEST_ASSERT_EQUAL_UINT16(kCollarB.shockerId, members[0].shockerId);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_unknown_group_is_empty);
+  RUN_TEST(test_define_replace_and_remove);
+  RUN_TEST(test_duplicate_members_are_dropped);
+  RUN_TEST(test_limits_keep_previous_definition);
+
+  return UNITY_END();
+}
@@ -0,0 +1,98 @@
+#include <unity.h>
+
+#include "util/SocketWaiter.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace OpenShock::Util;
+
+static uint32_t elapsedMs(std::chrono::steady_clock::time_point since)
+{
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - since).count());
+}
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_times_out_without_activity()
+{
+  SocketWaiter waiter;
+  TEST_ASSERT_FALSE(waiter.ok());
+  TEST_ASSERT_TRUE(waiter.Init());
+  TEST_ASSERT_TRUE(waiter.ok());
+
+  auto start = std::chrono::steady_clock::now();
+  TEST_ASSERT_FALSE(waiter.Wait(nullptr, 0, 50));
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(45, elapsedMs(start));
+}
+
+void test_wake_from_another_thread()
+{
+  SocketWaiter waiter;
+  TEST_ASSERT_TRUE(waiter.Init());
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread waker([&waiter]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    waiter.Wake();
+  });
+
+  TEST_ASSERT_TRUE(waiter.Wait(nullptr, 0, 5000));
+  TEST_ASSERT_LESS_THAN_UINT32(1000, elapsedMs(start));
+  waker.join();
+
+  // Wakes that pile up are one wake, once handled the next wait sleeps again
+  waiter.Wake();
+  waiter.Wake();
+  waiter.Wake();
+  TEST_ASSERT_TRUE(waiter.Wait(nullptr, 0, 5000));
+  TEST_ASSERT_FALSE(waiter.Wait(nullptr, 0, 20));
+
+  // A wake before the wait is not lost
+  waiter.Wake();
+  TEST_ASSERT_TRUE(waiter.Wait(nullptr, 0, 5000));
+}
+
+void test_readable_socket_ends_the_wait()
+{
+  SocketWaiter waiter;
+  TEST_ASSERT_TRUE(waiter.Init());
+
+  int pair[2];
+  TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM, 0, pair));
+
+  int fds[] = {-1, pair[0]};
+  TEST_ASSERT_FALSE(waiter.Wait(fds, 2, 20));
+
+  uint8_t byte = 42;
+  TEST_ASSERT_EQUAL_INT(1, write(pair[1], &byte, 1));
+
+  auto start = std::chrono::steady_clock::now();
+  TEST_ASSERT_TRUE(waiter.Wait(fds, 2, 5000));
+  TEST_ASSERT_LESS_THAN_UINT32(1000, elapsedMs(start));
+
+  // The waiter only watches, the data is left for the socket's owner
+  TEST_ASSERT_TRUE(waiter.Wait(fds, 2, 5000));
+  TEST_ASSERT_EQUAL_INT(1, read(pair[0], &byte, 1));
+  TEST_ASSERT_FALSE(waiter.Wait(fds, 2, 20));
+
+  close(pair[0]);
+  close(pair[1]);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_times_out_without_activity);
+  RUN_TEST(test_wake_from_another_thread);
+  RUN_TEST(test_readable_socket_ends_the_wait);
+
+  return UNITY_END();
+}
@@ -0,0 +1,209 @@
+#include <unity.h>
+
+#include "radio/RFBatch.h"
+#include "radio/TransmitScheduler.h"
+
+#include <array>
+#include <cstdint>
+
+using namespace OpenShock;
+
+namespace {
+  RFCommand makeCommand(uint16_t shockerId, int64_t until, uint16_t minRepeatIntervalMs)
+  {
+    RFCommand cmd {};
+    cmd.until                      = until;
+    cmd.shockerId                  = shockerId;
+    cmd.minRepeatIntervalMs        = minRepeatIntervalMs;
+    cmd.overwrite                  = true;
+    cmd.sequence.length            = 1;
+    cmd.sequence.pulses[0].val     = 1;
+    cmd.zeroSequence.length        = 1;
+    cmd.zeroSequence.pulses[0].val = 2;
+
+    return cmd;
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_stop_preempts_running_commands()
+{
+  TransmitScheduler scheduler;
+
+  RFCommand a = makeCommand(1, 10'000, 50);
+  RFCommand b = makeCommand(2, 10'000, 50);
+  TEST_ASSERT_NULL(scheduler.Submit(&a, 0));
+  TEST_ASSERT_NULL(scheduler.Submit(&b, 0));
+
+  TransmitScheduler::Frame frame;
+  int64_t nextWakeup;
+  TEST_ASSERT_TRUE(scheduler.Next(0, frame, nextWakeup));
+  TEST_ASSERT_TRUE(scheduler.Next(0, frame, nextWakeup));
+
+  // Shocker 1 is not due before 50, the stop makes its zero frame go out right away
+  TEST_ASSERT_TRUE(scheduler.Stop(1, 10));
+  TEST_ASSERT_TRUE(scheduler.Next(10, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(1, frame.shockerId);
+  TEST_ASSERT_TRUE(frame.isZero);
+  TEST_ASSERT_EQUAL_PTR(&a.zeroSequence, frame.sequence);
+
+  // The other shocker keeps running
+  TEST_ASSERT_TRUE(scheduler.Next(50, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(2, frame.shockerId);
+  TEST_ASSERT_FALSE(frame.isZero);
+}
+
+void test_stop_unknown_shocker()
+{
+  TransmitScheduler scheduler;
+
+  RFCommand a = makeCommand(1, 10'000, 50);
+  TEST_ASSERT_NULL(scheduler.Submit(&a, 0));
+
+  TEST_ASSERT_FALSE(scheduler.Stop(2, 0));
+}
+
+void test_stopped_command_is_removed_after_zero_phase()
+{
+  TransmitScheduler scheduler;
+
+  RFCommand a = makeCommand(1, 10'000, 0);
+  TEST_ASSERT_NULL(scheduler.Submit(&a, 0));
+  TEST_ASSERT_TRUE(scheduler.Stop(1, 100));
+
+  TEST_ASSERT_NULL(scheduler.PopFinished(300));
+  TEST_ASSERT_EQUAL_PTR(&a, scheduler.PopFinished(1000));
+  TEST_ASSERT_TRUE(scheduler.empty());
+}
+
+void test_zero_phase_shares_the_channel()
+{
+  TransmitScheduler scheduler;
+
+  RFCommand a = makeCommand(1, 100, 0);
+  RFCommand b = makeCommand(2, 10'000, 0);
+  TEST_ASSERT_NULL(scheduler.Submit(&a, 0));
+  TEST_ASSERT_NULL(scheduler.Submit(&b, 0));
+
+  TransmitScheduler::Frame frame;
+  int64_t nextWakeup;
+  TEST_ASSERT_TRUE(scheduler.Next(0, frame, nextWakeup));
+  TEST_ASSERT_TRUE(scheduler.Next(50, frame, nextWakeup));
+
+  // The first zero frame after expiry goes first
+  TEST_ASSERT_TRUE(scheduler.Next(150, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(1, frame.shockerId);
+  TEST_ASSERT_TRUE(frame.isZero);
+
+  // The rest of the end phase takes turns with the running command instead of starving it
+  TEST_ASSERT_TRUE(scheduler.Next(200, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(2, frame.shockerId);
+  TEST_ASSERT_FALSE(frame.isZero);
+
+  TEST_ASSERT_TRUE(scheduler.Next(250, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(1, frame.shockerId);
+  TEST_ASSERT_TRUE(frame.isZero);
+}
+
+void test_min_repeat_interval_paces_a_shocker()
+{
+  TransmitScheduler scheduler;
+
+  RFCommand a = makeCommand(1, 10'000, 100);
+  TEST_ASSERT_NULL(scheduler.Submit(&a, 0));
+
+  TransmitScheduler::Frame frame;
+  int64_t nextWakeup;
+  TEST_ASSERT_TRUE(scheduler.Next(0, frame, nextWakeup));
+
+  // On its own the shocker still waits for its interval, the channel stays idle until then
+  TEST_ASSERT_FALSE(scheduler.Next(10, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_INT64(100, nextWakeup);
+  TEST_ASSERT_TRUE(scheduler.Next(100, frame, nextWakeup));
+  TEST_ASSERT_EQUAL_UINT16(1, frame.shockerId);
+
+  // Next to a shocker without an interval, the paced one still gets a frame about every interval and the other one the rest of the channel
+  RFCommand b = makeCommand(2, 10'000, 0);
+  TEST_ASSERT_NULL(scheduler.Submit(&b, 100));
+
+  int64_t lastA   = 100;
+  uint32_t countA = 0;
+  uint32_t countB = 0;
+  for (int64_t now = 110; now < 1110; now += 10) {
+    TEST_ASSERT_TRUE(scheduler.Next(now, frame, nextWakeup));
+    if (frame.shockerId == 1) {
+      TEST_ASSERT_GREATER_OR_EQUAL_INT64(lastA + 100, now);
+      TEST_ASSERT_LESS_OR_EQUAL_INT64(lastA + 110, now);
+      lastA = now;
+      ++countA;
+    } else {
+      ++countB;
+    }
+  }
+
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(9, countA);
+  TEST_ASSERT_EQUAL_UINT32(100, countA + countB);
+}
+
+void test_stop_in_a_list_supersedes_earlier_commands()
+{
+  TransmitScheduler scheduler;
+
+  // Shock(1), Vibrate(2), Shock(1) then Stop(1) in one list, the stop goes out on its own lane before the batch is queued
+  RFCommand a1 = makeCommand(1, 10'000, 0);
+  RFCommand b  = makeCommand(2, 10'000, 0);
+  RFCommand a2 = makeCommand(1, 10'000, 0);
+
+  RFBatch batch = {};
+  batch.Append(&a1);
+  batch.Append(&b);
+  batch.Append(&a2);
+
+  RFBatch superseded = batch.RemoveShocker(1);
+  TEST_ASSERT_EQUAL_UINT(2, superseded.size);
+  TEST_ASSERT_EQUAL_PTR(&a1, superseded.head);
+  TEST_ASSERT_EQUAL_PTR(&a2, superseded.tail);
+  TEST_ASSERT_NULL(superseded.tail->next);
+
+  TEST_ASSERT_EQUAL_UINT(1, batch.size);
+  TEST_ASSERT_EQUAL_PTR(&b, batch.head);
+  TEST_ASSERT_EQUAL_PTR(&b, batch.tail);
+  TEST_ASSERT_NULL(b.next);
+
+  // The stop found nothing to stop, and what is left of the batch doesn't start the stopped shocker again
+  TEST_ASSERT_FALSE(scheduler.Stop(1, 0));
+  for (RFCommand* cmd = batch.head; cmd != nullptr; cmd = cmd->next) {
+    TEST_ASSERT_NULL(scheduler.Submit(cmd, 0));
+  }
+
+  TEST_ASSERT_NULL(scheduler.Find(1));
+  TEST_ASSERT_EQUAL_PTR(&b, scheduler.Find(2));
+
+  TransmitScheduler::Frame frame;
+  int64_t nextWakeup;
+  for (int64_t now = 0; now < 100; now += 10) {
+    TEST_ASSERT_TRUE(scheduler.Next(now, frame, nextWakeup));
+    TEST_ASSERT_EQUAL_UINT16(2, frame.shockerId);
+  }
+
+  // Removing a shocker that isn't in the batch leaves it alone
+  TEST_ASSERT_EQUAL_UINT(0, batch.RemoveShocker(3).size);
+  TEST_ASSERT_EQUAL_UINT(1, batch.size);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_stop_preempts_running_commands);
+  RUN_TEST(test_stop_unknown_shocker);
+  RUN_TEST(test_stopped_command_is_removed_after_zero_phase);
+  RUN_TEST(test_zero_phase_shares_the_channel);
+  RUN_TEST(test_min_repeat_interval_paces_a_shocker);
+  RUN_TEST(test_stop_in_a_list_supersedes_earlier_commands);
+
+  return UNITY_END();
+}
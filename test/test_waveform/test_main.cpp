@@ -0,0 +1,189 @@
+#include <unity.h>
+
+#include "radio/Waveform.h"
+
+#include "serialization/_fbs/GatewayToHubMessage_generated.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace OpenShock;
+
+namespace {
+  Waveform makeRamp()
+  {
+    // Vibrate ramps 0 -> 100 over the first second, holds 100 for another, played twice
+    Waveform waveform {};
+    waveform.keyframes[0]  = {.offsetMs = 0, .type = ShockerCommandType::Vibrate, .intensity = 0, .ramp = true};
+    waveform.keyframes[1]  = {.offsetMs = 1000, .type = ShockerCommandType::Vibrate, .intensity = 100, .ramp = false};
+    waveform.keyframeCount = 2;
+    waveform.periodMs      = 2000;
+    waveform.repeats       = 2;
+
+    return waveform;
+  }
+}  // namespace
+
+void setUp() { }
+
+void tearDown() { }
+
+void test_sample_ramp_and_hold()
+{
+  Waveform waveform = makeRamp();
+
+  ShockerCommandType type;
+  uint8_t intensity;
+
+  TEST_ASSERT_TRUE(waveform.Sample(0, type, intensity));
+  TEST_ASSERT_TRUE(type == ShockerCommandType::Vibrate);
+  TEST_ASSERT_EQUAL_UINT8(0, intensity);
+
+  TEST_ASSERT_TRUE(waveform.Sample(500, type, intensity));
+  TEST_ASSERT_EQUAL_UINT8(50, intensity);
+
+  TEST_ASSERT_TRUE(waveform.Sample(1500, type, intensity));
+  TEST_ASSERT_EQUAL_UINT8(100, intensity);
+
+  // Second repeat starts over
+  TEST_ASSERT_TRUE(waveform.Sample(2250, type, intensity));
+  TEST_ASSERT_EQUAL_UINT8(25, intensity);
+
+  TEST_ASSERT_EQUAL_UINT32(4000, waveform.DurationMs());
+  TEST_ASSERT_FALSE(waveform.Sample(4000, type, intensity));
+  TEST_ASSERT_FALSE(waveform.Sample(-1, type, intensity));
+}
+
+void test_last_keyframe_ramps_to_first()
+{
+  Waveform waveform {};
+  waveform.keyframes[0]  = {.offsetMs = 0, .type = ShockerCommandType::Shock, .intensity = 10, .ramp = false};
+  waveform.keyframes[1]  = {.offsetMs = 100, .type = ShockerCommandType::Shock, .intensity = 90, .ramp = true};
+  waveform.keyframeCount = 2;
+  waveform.periodMs      = 200;
+  waveform.repeats       = 1;
+
+  ShockerCommandType type;
+  uint8_t intensity;
+
+  TEST_ASSERT_TRUE(waveform.Sample(50, type, intensity));
+  TEST_ASSERT_EQUAL_UINT8(10, intensity);
+
+  TEST_ASSERT_TRUE(waveform.Sample(150, type, intensity));
+  TEST_ASSERT_TRUE(type == ShockerCommandType::Shock);
+  TEST_ASSERT_EQUAL_UINT8(50, intensity);
+}
+
+void test_serialize_parse_round_trip()
+{
+  Waveform waveform = makeRamp();
+
+  std::array<uint8_t, Waveform::kMaxEncodedSize> data;
+  std::size_t length = waveform.Serialize(data.data(), data.size());
+  TEST_ASSERT_EQUAL_UINT(Waveform::kHeaderSize + 2 * Waveform::kKeyframeSize, length);
+
+  const std::array<uint8_t, 13> expected = {0x01, 0x02, 0xD0, 0x07, 0x02, 0x00, 0x00, 0x82, 0x00, 0xE8, 0x03, 0x02, 0x64};
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected.data(), data.data(), expected.size());
+
+  Waveform parsed;
+  TEST_ASSERT_TRUE(Waveform::Parse(data.data(), length, parsed));
+  TEST_ASSERT_EQUAL_UINT8(2, parsed.keyframeCount);
+  TEST_ASSERT_EQUAL_UINT16(2000, parsed.periodMs);
+  TEST_ASSERT_EQUAL_UINT8(2, parsed.repeats);
+  TEST_ASSERT_EQUAL_UINT16(1000, parsed.keyframes[1].offsetMs);
+  TEST_ASSERT_TRUE(parsed.keyframes[0].ramp);
+  TEST_ASSERT_FALSE(parsed.keyframes[1].ramp);
+  TEST_ASSERT_EQUAL_UINT8(100, parsed.keyframes[1].intensity);
+}
+
+void test_parse_rejects_malformed()
+{
+  Waveform waveform = makeRamp();
+
+  std::array<uint8_t, Waveform::kMaxEncodedSize> data;
+  std::size_t length = waveform.Serialize(data.data(), data.size());
+
+  Waveform parsed;
+
+  // Truncated
+  TEST_ASSERT_FALSE(Waveform::Parse(data.data(), length - 1, parsed));
+
+  // Unknown version
+  std::array<uint8_t, Waveform::kMaxEncodedSize> broken = data;
+
+  broken[0] = 2;
+  TEST_ASSERT_FALSE(Waveform::Parse(broken.data(), length, parsed));
+
+  // Keyframes out of order
+  broken     = data;
+  broken[9]  = 0x00;
+  broken[10] = 0x00;
+  TEST_ASSERT_FALSE(Waveform::Parse(broken.data(), length, parsed));
+
+  // Keyframe past the period
+  broken     = data;
+  broken[9]  = 0xD0;
+  broken[10] = 0x07;
+  TEST_ASSERT_FALSE(Waveform::Parse(broken.data(), length, parsed));
+
+  // Stop is not a pattern type
+  broken     = data;
+  broken[11] = static_cast<uint8_t>(ShockerCommandType::Stop);
+  TEST_ASSERT_FALSE(Waveform::Parse(broken.data(), length, parsed));
+
+  // No repeats
+  broken    = data;
+  broken[4] = 0;
+  TEST_ASSERT_FALSE(Waveform::Parse(broken.data(), length, parsed));
+}
+
+void test_gateway_message_carries_encoding()
+{
+  namespace Gateway = OpenShock::Serialization::Gateway;
+
+  Waveform waveform = makeRamp();
+
+  std::vector<uint8_t> encoded(Waveform::kMaxEncodedSize);
+  encoded.resize(waveform.Serialize(encoded.data(), encoded.size()));
+
+  flatbuffers::FlatBufferBuilder builder;
+  auto payload = Gateway::CreateShockerWaveformDirect(builder, OpenShock::Serialization::Types::ShockerModelType::Petrainer, 4242, &encoded);
+  builder.Finish(Gateway::CreateGatewayToHubMessage(builder, Gateway::GatewayToHubMessagePayload::ShockerWaveform, payload.Union()));
+
+  flatbuffers::Verifier verifier(builder.GetBufferPointer(), builder.GetSize());
+  auto msg = Gateway::GetGatewayToHubMessage(builder.GetBufferPointer());
+  TEST_ASSERT_TRUE(msg->Verify(verifier));
+
+  auto fbsWaveform = msg->payload_as_ShockerWaveform();
+  TEST_ASSERT_NOT_NULL(fbsWaveform);
+  TEST_ASSERT_TRUE(fbsWaveform->model() == OpenShock::Serialization::Types::ShockerModelType::Petrainer);
+  TEST_ASSERT_EQUAL_UINT16(4242, fbsWaveform->id());
+
+  Waveform parsed;
+  TEST_ASSERT_TRUE(Waveform::Parse(fbsWaveform->waveform()->data(), fbsWaveform->waveform()->size(), parsed));
+  TEST_ASSERT_EQUAL_UINT32(waveform.DurationMs(), parsed.DurationMs());
+
+  // Without the encoding there is nothing to play
+  flatbuffers::FlatBufferBuilder empty;
+  Gateway::ShockerWaveformBuilder emptyPayload(empty);
+  emptyPayload.add_id(4242);
+  auto emptyOffset = flatbuffers::Offset<Gateway::ShockerWaveform>(empty.EndTable(emptyPayload.start_));
+  empty.Finish(Gateway::CreateGatewayToHubMessage(empty, Gateway::GatewayToHubMessagePayload::ShockerWaveform, emptyOffset.Union()));
+
+  flatbuffers::Verifier emptyVerifier(empty.GetBufferPointer(), empty.GetSize());
+  TEST_ASSERT_FALSE(Gateway::GetGatewayToHubMessage(empty.GetBufferPointer())->Verify(emptyVerifier));
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_sample_ramp_and_hold);
+  RUN_TEST(test_last_keyframe_ramps_to_first);
+  RUN_TEST(test_serialize_parse_round_trip);
+  RUN_TEST(test_parse_rejects_malformed);
+  RUN_TEST(test_gateway_message_carries_encoding);
+
+  return UNITY_END();
+}
@@ -0,0 +1,149 @@
+#include <unity.h>
+
+#include "WebSocketDeFragger.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace OpenShock;
+
+struct Event {
+  uint8_t socketId;
+  WebSocketMessageType type;
+  std::string data;
+  const uint8_t* pointer;
+};
+
+static std::vector<Event> s_events;
+
+static void record(uint8_t socketId, WebSocketMessageType type, const uint8_t* data, uint32_t length)
+{
+  s_events.push_back(Event {
+    .socketId = socketId,
+    .type     = type,
+    .data     = std::string(reinterpret_cast<const char*>(data), length),
+    .pointer  = data,
+  });
+}
+
+static void feed(WebSocketDeFragger& deFragger, uint8_t socketId, WStype_t type, const char* data)
+{
+  deFragger.handler(socketId, type, reinterpret_cast<const uint8_t*>(data), strlen(data));
+}
+
+void setUp()
+{
+  s_events.clear();
+}
+
+void tearDown() { }
+
+void test_reassembles_fragments()
+{
+  WebSocketDeFragger deFragger(record);
+
+  feed(deFragger, 0, WStype_FRAGMENT_BIN_START, "ab");
+  feed(deFragger, 0, WStype_FRAGMENT, "cd");
+  TEST_ASSERT_EQUAL_UINT(0, s_events.size());
+
+  feed(deFragger, 0, WStype_FRAGMENT_FIN, "ef");
+  TEST_ASSERT_EQUAL_UINT(1, s_events.size());
+  TEST_ASSERT_TRUE(s_events[0].type == WebSocketMessageType::Binary);
+  TEST_ASSERT_EQUAL_STRING("abcdef", s_events[0].data.c_str());
+
+  // Whole messages are passed through without a copy
+  const char* whole = "whole";
+  deFragger.handler(0, WStype_BIN, reinterpret_cast<const uint8_t*>(whole), 5);
+  TEST_ASSERT_EQUAL_UINT(2, s_events.size());
+  TEST_ASSERT_EQUAL_PTR(whole, s_events[1].pointer);
+}
+
+void test_buffer_is_reused_across_messages()
+{
+  WebSocketDeFragger deFragger(record);
+
+  for (int i = 0; i < 3; ++i) {
+    feed(deFragger, 0, WStype_FRAGMENT_TEXT_START, "hello ");
+    feed(deFragger, 0, WStype_FRAGMENT_FIN, "world");
+  }
+
+  TEST_ASSERT_EQUAL_UINT(3, s_events.size());
+  for (const Event& event : s_events) {
+    TEST_ASSERT_TRUE(event.type == WebSocketMessageType::Text);
+    TEST_ASSERT_EQUAL_STRING("hello world", event.data.c_str());
+    TEST_ASSERT_EQUAL_PTR(s_events[0].pointer, event.pointer);
+  }
+}
+
+void test_oversized_message_is_dropped()
+{
+  WebSocketDeFragger deFragger(record, 16, 16);
+
+  feed(deFragger, 0, WStype_FRAGMENT_BIN_START, "0123456789");
+  feed(deFragger, 0, WStype_FRAGMENT, "0123456789");
+  feed(deFragger, 0, WStype_FRAGMENT_FIN, "end");
+
+  TEST_ASSERT_EQUAL_UINT(1, s_events.size());
+  TEST_ASSERT_TRUE(s_events[0].type == WebSocketMessageType::Error);
+
+  // The socket recovers with the next message, one that fits exactly is fine
+  feed(deFragger, 0, WStype_FRAGMENT_BIN_START, "01234567");
+  feed(deFragger, 0, WStype_FRAGMENT_FIN, "89abcdef");
+
+  TEST_ASSERT_EQUAL_UINT(2, s_events.size());
+  TEST_ASSERT_TRUE(s_events[1].type == WebSocketMessageType::Binary);
+  TEST_ASSERT_EQUAL_STRING("0123456789abcdef", s_events[1].data.c_str());
+}
+
+void test_control_frames_between_fragments()
+{
+  WebSocketDeFragger deFragger(record);
+
+  feed(deFragger, 0, WStype_FRAGMENT_BIN_START, "ab");
+  feed(deFragger, 0, WStype_PING, "");
+  feed(deFragger, 0, WStype_FRAGMENT_FIN, "cd");
+
+  TEST_ASSERT_EQUAL_UINT(2, s_events.size());
+  TEST_ASSERT_TRUE(s_events[0].type == WebSocketMessageType::Ping);
+  TEST_ASSERT_EQUAL_STRING("abcd", s_events[1].data.c_str());
+
+  // A data frame in the middle abandons the fragmented message
+  feed(deFragger, 0, WStype_FRAGMENT_BIN_START, "ab");
+  feed(deFragger, 0, WStype_BIN, "xy");
+  feed(deFragger, 0, WStype_FRAGMENT_FIN, "cd");
+
+  TEST_ASSERT_EQUAL_UINT(3, s_events.size());
+  TEST_ASSERT_EQUAL_STRING("xy", s_events[2].data.c_str());
+}
+
+void test_sockets_are_independent()
+{
+  WebSocketDeFragger deFragger(record);
+
+  feed(deFragger, 1, WStype_FRAGMENT_BIN_START, "one ");
+  feed(deFragger, 2, WStype_FRAGMENT_TEXT_START, "two ");
+  feed(deFragger, 1, WStype_FRAGMENT_FIN, "done");
+  feed(deFragger, 2, WStype_DISCONNECTED, "");
+  feed(deFragger, 2, WStype_FRAGMENT_FIN, "lost");
+
+  TEST_ASSERT_EQUAL_UINT(2, s_events.size());
+  TEST_ASSERT_EQUAL_UINT8(1, s_events[0].socketId);
+  TEST_ASSERT_EQUAL_STRING("one done", s_events[0].data.c_str());
+  TEST_ASSERT_EQUAL_UINT8(2, s_events[1].socketId);
+  TEST_ASSERT_TRUE(s_events[1].type == WebSocketMessageType::Disconnected);
+}
+
+int main(int argc, char** argv)
+{
+  UNITY_BEGIN();
+
+  RUN_TEST(test_reassembles_fragments);
+  RUN_TEST(test_buffer_is_reused_across_messages);
+  RUN_TEST(test_oversized_message_is_dropped);
+  RUN_TEST(test_control_frames_between_fragments);
+  RUN_TEST(test_sockets_are_independent);
+
+  return UNITY_END();
+}